@@ -1,5 +1,5 @@
-#include <iostream>
 #include <string>
+#include "src/performance/output_sink.h"
 
 /**
  * C++ Learning Project - Main Entry Point
@@ -13,29 +13,56 @@
  */
 
 int main() {
-    std::cout << "===========================================" << std::endl;
-    std::cout << "    Welcome to C++ Learning Project!" << std::endl;
-    std::cout << "===========================================" << std::endl;
-    std::cout << std::endl;
+    console() << "===========================================" << '\n';
+    console() << "    Welcome to C++ Learning Project!" << '\n';
+    console() << "===========================================" << '\n';
+    console() << '\n';
     
-    std::cout << "This project contains various C++ examples:" << std::endl;
-    std::cout << "1. Basic concepts (variables, loops, functions)" << std::endl;
-    std::cout << "2. Object-oriented programming" << std::endl;
-    std::cout << "3. STL containers and algorithms" << std::endl;
-    std::cout << std::endl;
+    console() << "This project contains various C++ examples:" << '\n';
+    console() << "1. Basic concepts (variables, loops, functions)" << '\n';
+    console() << "2. Object-oriented programming" << '\n';
+    console() << "3. STL containers and algorithms" << '\n';
+    console() << "4. Performance engineering (data layout, SIMD, benchmarks)" << '\n';
+    console() << '\n';
     
-    std::cout << "To run specific examples, use:" << std::endl;
-    std::cout << "  ./basics_variables    - Variable examples" << std::endl;
-    std::cout << "  ./basics_loops        - Loop examples" << std::endl;
-    std::cout << "  ./basics_functions    - Function examples" << std::endl;
-    std::cout << "  ./oop_classes         - Class examples" << std::endl;
-    std::cout << "  ./oop_inheritance     - Inheritance examples" << std::endl;
-    std::cout << "  ./oop_polymorphism    - Polymorphism examples" << std::endl;
-    std::cout << "  ./stl_containers      - STL container examples" << std::endl;
-    std::cout << "  ./stl_algorithms      - STL algorithm examples" << std::endl;
-    std::cout << std::endl;
+    console() << "To run specific examples, use:" << '\n';
+    console() << "  ./basics_variables    - Variable examples" << '\n';
+    console() << "  ./basics_loops        - Loop examples" << '\n';
+    console() << "  ./basics_functions    - Function examples" << '\n';
+    console() << "  ./oop_classes         - Class examples" << '\n';
+    console() << "  ./oop_inheritance     - Inheritance examples" << '\n';
+    console() << "  ./oop_polymorphism    - Polymorphism examples" << '\n';
+    console() << "  ./stl_containers      - STL container examples" << '\n';
+    console() << "  ./stl_algorithms      - STL algorithm examples" << '\n';
+    console() << "  ./perf_shape_store    - SoA shape store with SIMD" << '\n';
+    console() << "  ./perf_shape_variant  - std::variant shape dispatch" << '\n';
+    console() << "  ./perf_object_arena   - Arena allocation for objects" << '\n';
+    console() << "  ./perf_spatial_grid   - Spatial grid index for shapes" << '\n';
+    console() << "  ./perf_shape_aggregates - Parallel shape aggregates" << '\n';
+    console() << "  ./perf_gradebook      - Columnar gradebook" << '\n';
+    console() << "  ./perf_sharded_counter - Sharded population counter" << '\n';
+    console() << "  ./perf_student_moves  - Move semantics for Student" << '\n';
+    console() << "  ./perf_student_small_vector - Small-buffer optimized grades" << '\n';
+    console() << "  ./perf_record_loader  - Memory-mapped record loader" << '\n';
+    console() << "  ./perf_enrollment_graph - CSR enrollment graph" << '\n';
+    console() << "  ./perf_grade_leaderboard - Incremental grade leaderboard" << '\n';
+    console() << "  ./perf_grade_percentiles - Streaming grade percentiles" << '\n';
+    console() << "  ./perf_animal_collection - Type-grouped animal dispatch" << '\n';
+    console() << "  ./perf_animal_pool    - Recycling animal pools" << '\n';
+    console() << "  ./perf_animal_capabilities - Capability queries without dynamic_cast" << '\n';
+    console() << "  ./perf_animal_ecs     - Parallel animal entity-component system" << '\n';
+    console() << "  ./perf_output_sink    - Buffered output without std::endl" << '\n';
+    console() << "  ./perf_lifecycle_trace - Asynchronous lifecycle tracing" << '\n';
+    console() << "  ./cpp_bench           - Benchmarks for every module (--json FILE)" << '\n';
+    console() << "  ./perf_container_profile - Hardware counters per container operation" << '\n';
+    console() << "  ./perf_flat_hash_map  - Open-addressing hash map for price lookups" << '\n';
+    console() << "  ./perf_flat_map       - Sorted flat map for read-mostly tables" << '\n';
+    console() << "  ./perf_roaring_bitmap - Compressed bitmaps for integer ID sets" << '\n';
+    console() << "  ./perf_set_ops - Adaptive set operations on sorted vectors" << '\n';
+    console() << '\n';
     
-    std::cout << "Happy learning! 🚀" << std::endl;
+    console() << "Happy learning! 🚀" << '\n';
     
+    console().flush();
     return 0;
 }
\ No newline at end of file
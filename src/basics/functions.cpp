@@ -1,6 +1,6 @@
-#include <iostream>
 #include <string>
 #include <vector>
+#include "../performance/output_sink.h"
 
 /**
  * Functions in C++
@@ -34,76 +34,77 @@ int factorial(int n);
 void demonstrateLambda();
 
 int main() {
-    std::cout << "=== C++ Functions ===" << std::endl;
-    std::cout << std::endl;
+    console() << "=== C++ Functions ===" << '\n';
+    console() << '\n';
     
     // Basic function call
-    std::cout << "1. Basic function call:" << std::endl;
+    console() << "1. Basic function call:" << '\n';
     int result = add(5, 3);
-    std::cout << "  add(5, 3) = " << result << std::endl;
-    std::cout << std::endl;
+    console() << "  add(5, 3) = " << result << '\n';
+    console() << '\n';
     
     // Function with string parameter
-    std::cout << "2. Function with string parameter:" << std::endl;
+    console() << "2. Function with string parameter:" << '\n';
     printMessage("Hello from function!");
-    std::cout << std::endl;
+    console() << '\n';
     
     // Function with default parameter
-    std::cout << "3. Function with default parameter:" << std::endl;
+    console() << "3. Function with default parameter:" << '\n';
     double area1 = calculateArea(5.0, 3.0);
     double area2 = calculateArea(5.0);  // Uses default width = 1.0
-    std::cout << "  calculateArea(5.0, 3.0) = " << area1 << std::endl;
-    std::cout << "  calculateArea(5.0) = " << area2 << std::endl;
-    std::cout << std::endl;
+    console() << "  calculateArea(5.0, 3.0) = " << area1 << '\n';
+    console() << "  calculateArea(5.0) = " << area2 << '\n';
+    console() << '\n';
     
     // Function overloading
-    std::cout << "4. Function overloading:" << std::endl;
+    console() << "4. Function overloading:" << '\n';
     int intResult = multiply(4, 5);
     double doubleResult = multiply(4.5, 2.5);
     int tripleResult = multiply(2, 3, 4);
-    std::cout << "  multiply(4, 5) = " << intResult << std::endl;
-    std::cout << "  multiply(4.5, 2.5) = " << doubleResult << std::endl;
-    std::cout << "  multiply(2, 3, 4) = " << tripleResult << std::endl;
-    std::cout << std::endl;
+    console() << "  multiply(4, 5) = " << intResult << '\n';
+    console() << "  multiply(4.5, 2.5) = " << doubleResult << '\n';
+    console() << "  multiply(2, 3, 4) = " << tripleResult << '\n';
+    console() << '\n';
     
     // Pass by reference
-    std::cout << "5. Pass by reference:" << std::endl;
+    console() << "5. Pass by reference:" << '\n';
     int x = 10, y = 20;
-    std::cout << "  Before swap: x = " << x << ", y = " << y << std::endl;
+    console() << "  Before swap: x = " << x << ", y = " << y << '\n';
     swap(x, y);
-    std::cout << "  After swap: x = " << x << ", y = " << y << std::endl;
-    std::cout << std::endl;
+    console() << "  After swap: x = " << x << ", y = " << y << '\n';
+    console() << '\n';
     
     // Pass by reference with vector
-    std::cout << "6. Pass by reference with vector:" << std::endl;
+    console() << "6. Pass by reference with vector:" << '\n';
     std::vector<int> numbers = {1, 2, 3, 4, 5};
-    std::cout << "  Original vector: ";
+    console() << "  Original vector: ";
     for (int num : numbers) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     modifyVector(numbers);
-    std::cout << "  Modified vector: ";
+    console() << "  Modified vector: ";
     for (int num : numbers) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl << std::endl;
+    console() << '\n' << '\n';
     
     // Recursive function
-    std::cout << "7. Recursive function (factorial):" << std::endl;
+    console() << "7. Recursive function (factorial):" << '\n';
     int n = 5;
     int fact = factorial(n);
-    std::cout << "  factorial(" << n << ") = " << fact << std::endl;
-    std::cout << std::endl;
+    console() << "  factorial(" << n << ") = " << fact << '\n';
+    console() << '\n';
     
     // Lambda functions
-    std::cout << "8. Lambda functions:" << std::endl;
+    console() << "8. Lambda functions:" << '\n';
     demonstrateLambda();
-    std::cout << std::endl;
+    console() << '\n';
     
-    std::cout << "=== End of Functions Example ===" << std::endl;
+    console() << "=== End of Functions Example ===" << '\n';
     
+    console().flush();
     return 0;
 }
 
@@ -113,7 +114,7 @@ int add(int a, int b) {
 }
 
 void printMessage(const std::string& message) {
-    std::cout << "  Message: " << message << std::endl;
+    console() << "  Message: " << message << '\n';
 }
 
 double calculateArea(double length, double width) {
@@ -157,7 +158,7 @@ void demonstrateLambda() {
         return x * x;
     };
     
-    std::cout << "  square(5) = " << square(5) << std::endl;
+    console() << "  square(5) = " << square(5) << '\n';
     
     // Lambda with capture
     int multiplier = 3;
@@ -165,7 +166,7 @@ void demonstrateLambda() {
         return x * multiplier;
     };
     
-    std::cout << "  multiplyBy(4) = " << multiplyBy(4) << std::endl;
+    console() << "  multiplyBy(4) = " << multiplyBy(4) << '\n';
     
     // Lambda with reference capture
     int sum = 0;
@@ -175,5 +176,5 @@ void demonstrateLambda() {
     
     addToSum(10);
     addToSum(20);
-    std::cout << "  sum after adding 10 and 20 = " << sum << std::endl;
+    console() << "  sum after adding 10 and 20 = " << sum << '\n';
 }
@@ -1,5 +1,5 @@
-#include <iostream>
 #include <vector>
+#include "../performance/output_sink.h"
 
 /**
  * Loops in C++
@@ -12,69 +12,69 @@
  */
 
 int main() {
-    std::cout << "=== C++ Loops ===" << std::endl;
-    std::cout << std::endl;
+    console() << "=== C++ Loops ===" << '\n';
+    console() << '\n';
     
     // Traditional for loop
-    std::cout << "1. Traditional for loop:" << std::endl;
+    console() << "1. Traditional for loop:" << '\n';
     for (int i = 1; i <= 5; ++i) {
-        std::cout << "  Iteration " << i << std::endl;
+        console() << "  Iteration " << i << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // For loop with different increment
-    std::cout << "2. For loop with step 2:" << std::endl;
+    console() << "2. For loop with step 2:" << '\n';
     for (int i = 0; i < 10; i += 2) {
-        std::cout << "  Even number: " << i << std::endl;
+        console() << "  Even number: " << i << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // While loop
-    std::cout << "3. While loop:" << std::endl;
+    console() << "3. While loop:" << '\n';
     int count = 1;
     while (count <= 3) {
-        std::cout << "  Count: " << count << std::endl;
+        console() << "  Count: " << count << '\n';
         count++;
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Do-while loop (executes at least once)
-    std::cout << "4. Do-while loop:" << std::endl;
+    console() << "4. Do-while loop:" << '\n';
     int number = 5;
     do {
-        std::cout << "  Number: " << number << std::endl;
+        console() << "  Number: " << number << '\n';
         number--;
     } while (number > 0);
-    std::cout << std::endl;
+    console() << '\n';
     
     // Nested loops
-    std::cout << "5. Nested loops (multiplication table):" << std::endl;
+    console() << "5. Nested loops (multiplication table):" << '\n';
     for (int i = 1; i <= 3; ++i) {
         for (int j = 1; j <= 3; ++j) {
-            std::cout << "  " << i << " x " << j << " = " << (i * j) << std::endl;
+            console() << "  " << i << " x " << j << " = " << (i * j) << '\n';
         }
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Range-based for loop (C++11) with array
-    std::cout << "6. Range-based for loop with array:" << std::endl;
+    console() << "6. Range-based for loop with array:" << '\n';
     int numbers[] = {10, 20, 30, 40, 50};
     for (int num : numbers) {
-        std::cout << "  Array element: " << num << std::endl;
+        console() << "  Array element: " << num << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Range-based for loop with vector
-    std::cout << "7. Range-based for loop with vector:" << std::endl;
+    console() << "7. Range-based for loop with vector:" << '\n';
     std::vector<std::string> fruits = {"apple", "banana", "orange", "grape"};
     for (const auto& fruit : fruits) {
-        std::cout << "  Fruit: " << fruit << std::endl;
+        console() << "  Fruit: " << fruit << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Loop control statements
-    std::cout << "8. Loop control statements (break and continue):" << std::endl;
-    std::cout << "   Numbers 1-10, skip 5, stop at 8:" << std::endl;
+    console() << "8. Loop control statements (break and continue):" << '\n';
+    console() << "   Numbers 1-10, skip 5, stop at 8:" << '\n';
     for (int i = 1; i <= 10; ++i) {
         if (i == 5) {
             continue;  // Skip this iteration
@@ -82,30 +82,31 @@ int main() {
         if (i == 8) {
             break;     // Exit the loop
         }
-        std::cout << "  " << i << std::endl;
+        console() << "  " << i << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Infinite loop with break condition
-    std::cout << "9. Controlled infinite loop:" << std::endl;
+    console() << "9. Controlled infinite loop:" << '\n';
     int counter = 0;
     while (true) {
         counter++;
-        std::cout << "  Counter: " << counter << std::endl;
+        console() << "  Counter: " << counter << '\n';
         if (counter >= 3) {
             break;  // Exit the infinite loop
         }
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Loop with multiple variables
-    std::cout << "10. For loop with multiple variables:" << std::endl;
+    console() << "10. For loop with multiple variables:" << '\n';
     for (int i = 0, j = 10; i < 5; ++i, --j) {
-        std::cout << "  i = " << i << ", j = " << j << std::endl;
+        console() << "  i = " << i << ", j = " << j << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
     
-    std::cout << "=== End of Loops Example ===" << std::endl;
+    console() << "=== End of Loops Example ===" << '\n';
     
+    console().flush();
     return 0;
 }
@@ -1,5 +1,5 @@
-#include <iostream>
 #include <string>
+#include "../performance/output_sink.h"
 
 /**
  * Variables and Data Types in C++
@@ -9,8 +9,8 @@
  */
 
 int main() {
-    std::cout << "=== C++ Variables and Data Types ===" << std::endl;
-    std::cout << std::endl;
+    console() << "=== C++ Variables and Data Types ===" << '\n';
+    console() << '\n';
     
     // Integer types
     int age = 25;                    // 32-bit integer
@@ -18,74 +18,75 @@ int main() {
     long bigNumber = 1000000L;       // 32-bit or 64-bit integer
     long long hugeNumber = 1000000000LL; // 64-bit integer
     
-    std::cout << "Integer types:" << std::endl;
-    std::cout << "  int age = " << age << std::endl;
-    std::cout << "  short smallNumber = " << smallNumber << std::endl;
-    std::cout << "  long bigNumber = " << bigNumber << std::endl;
-    std::cout << "  long long hugeNumber = " << hugeNumber << std::endl;
-    std::cout << std::endl;
+    console() << "Integer types:" << '\n';
+    console() << "  int age = " << age << '\n';
+    console() << "  short smallNumber = " << smallNumber << '\n';
+    console() << "  long bigNumber = " << bigNumber << '\n';
+    console() << "  long long hugeNumber = " << hugeNumber << '\n';
+    console() << '\n';
     
     // Floating point types
     float pi = 3.14159f;             // Single precision
     double e = 2.718281828;          // Double precision
     long double precision = 3.141592653589793238L; // Extended precision
     
-    std::cout << "Floating point types:" << std::endl;
-    std::cout << "  float pi = " << pi << std::endl;
-    std::cout << "  double e = " << e << std::endl;
-    std::cout << "  long double precision = " << precision << std::endl;
-    std::cout << std::endl;
+    console() << "Floating point types:" << '\n';
+    console() << "  float pi = " << pi << '\n';
+    console() << "  double e = " << e << '\n';
+    console() << "  long double precision = " << precision << '\n';
+    console() << '\n';
     
     // Character types
     char letter = 'A';                // Single character
     char newline = '\n';             // Escape sequence
     char tab = '\t';                 // Tab character
     
-    std::cout << "Character types:" << std::endl;
-    std::cout << "  char letter = '" << letter << "'" << std::endl;
-    std::cout << "  char newline = '\\n' (newline character)" << std::endl;
-    std::cout << "  char tab = '\\t' (tab character)" << std::endl;
-    std::cout << std::endl;
+    console() << "Character types:" << '\n';
+    console() << "  char letter = '" << letter << "'" << '\n';
+    console() << "  char newline = '\\n' (newline character)" << '\n';
+    console() << "  char tab = '\\t' (tab character)" << '\n';
+    console() << '\n';
     
     // Boolean type
     bool isStudent = true;           // Boolean value
     bool isWorking = false;          // Boolean value
     
-    std::cout << "Boolean types:" << std::endl;
-    std::cout << "  bool isStudent = " << std::boolalpha << isStudent << std::endl;
-    std::cout << "  bool isWorking = " << std::boolalpha << isWorking << std::endl;
-    std::cout << std::endl;
+    console() << "Boolean types:" << '\n';
+    console() << "  bool isStudent = " << std::boolalpha << isStudent << '\n';
+    console() << "  bool isWorking = " << std::boolalpha << isWorking << '\n';
+    console() << '\n';
     
     // String type
     std::string name = "John Doe";   // String object
     std::string greeting = "Hello, " + name + "!"; // String concatenation
     
-    std::cout << "String types:" << std::endl;
-    std::cout << "  std::string name = \"" << name << "\"" << std::endl;
-    std::cout << "  std::string greeting = \"" << greeting << "\"" << std::endl;
-    std::cout << std::endl;
+    console() << "String types:" << '\n';
+    console() << "  std::string name = \"" << name << "\"" << '\n';
+    console() << "  std::string greeting = \"" << greeting << "\"" << '\n';
+    console() << '\n';
     
     // Constants
     const int MAX_STUDENTS = 100;    // Compile-time constant
     const double GRAVITY = 9.81;     // Compile-time constant
     
-    std::cout << "Constants:" << std::endl;
-    std::cout << "  const int MAX_STUDENTS = " << MAX_STUDENTS << std::endl;
-    std::cout << "  const double GRAVITY = " << GRAVITY << std::endl;
-    std::cout << std::endl;
+    console() << "Constants:" << '\n';
+    console() << "  const int MAX_STUDENTS = " << MAX_STUDENTS << '\n';
+    console() << "  const double GRAVITY = " << GRAVITY << '\n';
+    console() << '\n';
     
     // Auto keyword (C++11 and later)
     auto autoInt = 42;               // Compiler deduces int
     auto autoDouble = 3.14;          // Compiler deduces double
     auto autoString = "Hello";       // Compiler deduces const char*
     
-    std::cout << "Auto keyword (type deduction):" << std::endl;
-    std::cout << "  auto autoInt = " << autoInt << " (deduced as int)" << std::endl;
-    std::cout << "  auto autoDouble = " << autoDouble << " (deduced as double)" << std::endl;
-    std::cout << "  auto autoString = \"" << autoString << "\" (deduced as const char*)" << std::endl;
-    std::cout << std::endl;
+    console() << "Auto keyword (type deduction):" << '\n';
+    console() << "  auto autoInt = " << autoInt << " (deduced as int)" << '\n';
+    console() << "  auto autoDouble = " << autoDouble << " (deduced as double)" << '\n';
+    console() << "  auto autoString = \"" << autoString << "\" (deduced as const char*)" << '\n';
+    console() << '\n';
     
-    std::cout << "=== End of Variables Example ===" << std::endl;
+    console() << "=== End of Variables Example ===" << '\n';
     
+    console().flush();
     return 0;
 }
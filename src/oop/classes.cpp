@@ -1,6 +1,10 @@
-#include <iostream>
 #include <string>
 #include <vector>
+#include <utility>
+#include "../performance/sharded_counter.h"
+#include "../performance/small_vector.h"
+#include "../performance/output_sink.h"
+#include "../performance/lifecycle_trace.h"
 
 /**
  * Classes and Objects in C++
@@ -8,43 +12,77 @@
  * This example demonstrates:
  * - Class definition and object creation
  * - Constructors and destructors
+ * - Copy and move semantics (rule of five)
  * - Member variables and methods
  * - Access specifiers (public, private, protected)
  * - Static members
  * - Friend functions
+ * - Thread-safe instance counting (see src/performance/sharded_counter.h)
+ * - Constructor/destructor logging through the lifecycle tracer
+ *   (run with LIFECYCLE_TRACE=<file> to record it instead of printing)
  */
 
 class Student {
 private:
     std::string name;
     int age;
-    std::vector<double> grades;
-    static int totalStudents;  // Static member variable
+    SmallVector<double, 8> grades;  // Up to 8 grades without a heap allocation
+    static ShardedCounter totalStudents;  // Static member variable (thread-safe)
 
 public:
     // Default constructor
     Student() : name("Unknown"), age(0) {
-        totalStudents++;
-        std::cout << "  Default constructor called for " << name << std::endl;
+        totalStudents.increment();
+        LIFECYCLE_TRACE(Student, DefaultConstructed, this, name);
     }
     
     // Parameterized constructor
     Student(const std::string& studentName, int studentAge) 
         : name(studentName), age(studentAge) {
-        totalStudents++;
-        std::cout << "  Parameterized constructor called for " << name << std::endl;
+        totalStudents.increment();
+        LIFECYCLE_TRACE(Student, Constructed, this, name);
     }
     
     // Copy constructor
     Student(const Student& other) : name(other.name), age(other.age), grades(other.grades) {
-        totalStudents++;
-        std::cout << "  Copy constructor called for " << name << std::endl;
+        totalStudents.increment();
+        LIFECYCLE_TRACE(Student, CopyConstructed, this, name);
+    }
+    
+    // Move constructor: steals the name and any heap-allocated grades instead of copying.
+    // noexcept lets std::vector move (not copy) elements when it grows.
+    Student(Student&& other) noexcept
+        : name(std::move(other.name)), age(other.age), grades(std::move(other.grades)) {
+        totalStudents.increment();  // The moved-from object is still alive
+        LIFECYCLE_TRACE(Student, MoveConstructed, this, name);
+    }
+    
+    // Copy assignment operator
+    Student& operator=(const Student& other) {
+        if (this != &other) {
+            name = other.name;
+            age = other.age;
+            grades = other.grades;
+        }
+        LIFECYCLE_TRACE(Student, CopyAssigned, this, name);
+        return *this;
+    }
+    
+    // Move assignment operator
+    Student& operator=(Student&& other) noexcept {
+        if (this != &other) {
+            name = std::move(other.name);
+            age = other.age;
+            grades = std::move(other.grades);
+        }
+        LIFECYCLE_TRACE(Student, MoveAssigned, this, name);
+        return *this;
     }
     
     // Destructor
     ~Student() {
-        totalStudents--;
-        std::cout << "  Destructor called for " << name << std::endl;
+        totalStudents.decrement();
+        LIFECYCLE_TRACE(Student, Destroyed, this, name);
     }
     
     // Getter methods
@@ -77,33 +115,34 @@ public:
     
     // Method to display student info
     void displayInfo() const {
-        std::cout << "  Student: " << name << ", Age: " << age;
+        console() << "  Student: " << name << ", Age: " << age;
         if (!grades.empty()) {
-            std::cout << ", Average Grade: " << getAverageGrade();
+            console() << ", Average Grade: " << getAverageGrade();
         }
-        std::cout << std::endl;
+        console() << '\n';
     }
     
     // Static method
     static int getTotalStudents() {
-        return totalStudents;
+        return static_cast<int>(totalStudents.load());
     }
     
     // Friend function declaration
     friend void printStudentDetails(const Student& student);
 };
 
-// Initialize static member variable
-int Student::totalStudents = 0;
+// Define static member variable (every shard starts at zero)
+ShardedCounter Student::totalStudents;
 
 // Friend function definition
 void printStudentDetails(const Student& student) {
-    std::cout << "  Friend function access: " << student.name 
-              << " is " << student.age << " years old" << std::endl;
+    console() << "  Friend function access: " << student.name 
+              << " is " << student.age << " years old" << '\n';
 }
 
 // Another class to demonstrate composition
-class Course {
+// (InstanceCounter counts live Course objects, like totalStudents does for Student)
+class Course : public InstanceCounter<Course> {
 private:
     std::string courseName;
     std::string instructor;
@@ -114,38 +153,44 @@ public:
         : courseName(name), instructor(instructorName), credits(creditHours) {}
     
     void displayCourseInfo() const {
-        std::cout << "  Course: " << courseName 
+        console() << "  Course: " << courseName 
                   << ", Instructor: " << instructor 
-                  << ", Credits: " << credits << std::endl;
+                  << ", Credits: " << credits << '\n';
     }
     
     std::string getCourseName() const { return courseName; }
     std::string getInstructor() const { return instructor; }
     int getCredits() const { return credits; }
+
+    static int getTotalCourses() {
+        return static_cast<int>(liveInstances());
+    }
 };
 
 int main() {
-    std::cout << "=== C++ Classes and Objects ===" << std::endl;
-    std::cout << std::endl;
+    lifecycle::ConsoleSession lifecycleSession;  // Prints or traces constructor/destructor events
+
+    console() << "=== C++ Classes and Objects ===" << '\n';
+    console() << '\n';
     
     // Creating objects using different constructors
-    std::cout << "1. Creating objects:" << std::endl;
+    console() << "1. Creating objects:" << '\n';
     Student student1;  // Default constructor
     Student student2("Alice", 20);  // Parameterized constructor
     Student student3("Bob", 22);   // Parameterized constructor
     
-    std::cout << "   Total students: " << Student::getTotalStudents() << std::endl;
-    std::cout << std::endl;
+    console() << "   Total students: " << Student::getTotalStudents() << '\n';
+    console() << '\n';
     
     // Using setter methods
-    std::cout << "2. Using setter methods:" << std::endl;
+    console() << "2. Using setter methods:" << '\n';
     student1.setName("Charlie");
     student1.setAge(19);
     student1.displayInfo();
-    std::cout << std::endl;
+    console() << '\n';
     
     // Adding grades
-    std::cout << "3. Adding grades:" << std::endl;
+    console() << "3. Adding grades:" << '\n';
     student2.addGrade(85.5);
     student2.addGrade(92.0);
     student2.addGrade(78.5);
@@ -154,31 +199,32 @@ int main() {
     student3.addGrade(95.0);
     student3.addGrade(88.0);
     student3.displayInfo();
-    std::cout << std::endl;
+    console() << '\n';
     
     // Using friend function
-    std::cout << "4. Using friend function:" << std::endl;
+    console() << "4. Using friend function:" << '\n';
     printStudentDetails(student2);
-    std::cout << std::endl;
+    console() << '\n';
     
     // Copy constructor
-    std::cout << "5. Copy constructor:" << std::endl;
+    console() << "5. Copy constructor:" << '\n';
     Student student4 = student2;  // Copy constructor
     student4.setName("David");
     student4.displayInfo();
-    std::cout << std::endl;
+    console() << '\n';
     
     // Composition example
-    std::cout << "6. Composition example:" << std::endl;
+    console() << "6. Composition example:" << '\n';
     Course course1("Computer Science 101", "Dr. Smith", 3);
     Course course2("Mathematics 201", "Prof. Johnson", 4);
     
     course1.displayCourseInfo();
     course2.displayCourseInfo();
-    std::cout << std::endl;
+    console() << "   Total courses: " << Course::getTotalCourses() << '\n';
+    console() << '\n';
     
     // Object arrays
-    std::cout << "7. Object arrays:" << std::endl;
+    console() << "7. Object arrays:" << '\n';
     Student students[3] = {
         Student("Eve", 21),
         Student("Frank", 23),
@@ -188,10 +234,10 @@ int main() {
     for (int i = 0; i < 3; ++i) {
         students[i].displayInfo();
     }
-    std::cout << std::endl;
+    console() << '\n';
     
-    // Vector of objects
-    std::cout << "8. Vector of objects:" << std::endl;
+    // Vector of objects (temporaries are moved in, not copied)
+    console() << "8. Vector of objects:" << '\n';
     std::vector<Student> studentVector;
     studentVector.push_back(Student("Henry", 24));
     studentVector.push_back(Student("Ivy", 22));
@@ -199,12 +245,24 @@ int main() {
     for (const auto& student : studentVector) {
         student.displayInfo();
     }
-    std::cout << std::endl;
+    console() << '\n';
+    
+    // Move semantics
+    console() << "9. Move semantics:" << '\n';
+    Student student5("Jack", 21);
+    student5.addGrade(91.0);
+    Student student6 = std::move(student5);  // Move constructor
+    student6.displayInfo();
+    Student student7;
+    student7 = std::move(student6);          // Move assignment
+    student7.displayInfo();
+    console() << '\n';
     
-    std::cout << "   Final total students: " << Student::getTotalStudents() << std::endl;
-    std::cout << std::endl;
+    console() << "   Final total students: " << Student::getTotalStudents() << '\n';
+    console() << '\n';
     
-    std::cout << "=== End of Classes Example ===" << std::endl;
+    console() << "=== End of Classes Example ===" << '\n';
     
+    console().flush();
     return 0;
 }
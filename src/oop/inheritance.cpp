@@ -1,6 +1,7 @@
-#include <iostream>
 #include <string>
 #include <vector>
+#include "../performance/output_sink.h"
+#include "../performance/lifecycle_trace.h"
 
 /**
  * Inheritance in C++
@@ -12,6 +13,8 @@
  * - Access specifiers in inheritance
  * - Constructor and destructor in inheritance
  * - Method overriding
+ * - Constructor/destructor logging through the lifecycle tracer
+ *   (run with LIFECYCLE_TRACE=<file> to record it instead of printing)
  */
 
 // Base class
@@ -24,22 +27,22 @@ public:
     // Constructor
     Animal(const std::string& animalName, int animalAge) 
         : name(animalName), age(animalAge) {
-        std::cout << "  Animal constructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Animal, Constructed, this, name);
     }
     
     // Virtual destructor (important for polymorphism)
     virtual ~Animal() {
-        std::cout << "  Animal destructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Animal, Destroyed, this, name);
     }
     
     // Virtual function (can be overridden)
     virtual void makeSound() const {
-        std::cout << "  " << name << " makes a generic animal sound" << std::endl;
+        console() << "  " << name << " makes a generic animal sound" << '\n';
     }
     
     // Non-virtual function
     void eat() const {
-        std::cout << "  " << name << " is eating" << std::endl;
+        console() << "  " << name << " is eating" << '\n';
     }
     
     // Pure virtual function (makes class abstract)
@@ -59,27 +62,27 @@ public:
     // Constructor
     Dog(const std::string& dogName, int dogAge, const std::string& dogBreed)
         : Animal(dogName, dogAge), breed(dogBreed) {
-        std::cout << "  Dog constructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Dog, Constructed, this, name);
     }
     
     // Destructor
     ~Dog() {
-        std::cout << "  Dog destructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Dog, Destroyed, this, name);
     }
     
     // Override virtual function
     void makeSound() const override {
-        std::cout << "  " << name << " barks: Woof! Woof!" << std::endl;
+        console() << "  " << name << " barks: Woof! Woof!" << '\n';
     }
     
     // Implement pure virtual function
     void move() const override {
-        std::cout << "  " << name << " runs on four legs" << std::endl;
+        console() << "  " << name << " runs on four legs" << '\n';
     }
     
     // Additional method specific to Dog
     void fetch() const {
-        std::cout << "  " << name << " fetches the ball" << std::endl;
+        console() << "  " << name << " fetches the ball" << '\n';
     }
     
     std::string getBreed() const { return breed; }
@@ -93,23 +96,23 @@ private:
 public:
     Cat(const std::string& catName, int catAge, bool indoor = true)
         : Animal(catName, catAge), isIndoor(indoor) {
-        std::cout << "  Cat constructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Cat, Constructed, this, name);
     }
     
     ~Cat() {
-        std::cout << "  Cat destructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Cat, Destroyed, this, name);
     }
     
     void makeSound() const override {
-        std::cout << "  " << name << " meows: Meow! Meow!" << std::endl;
+        console() << "  " << name << " meows: Meow! Meow!" << '\n';
     }
     
     void move() const override {
-        std::cout << "  " << name << " walks silently" << std::endl;
+        console() << "  " << name << " walks silently" << '\n';
     }
     
     void climb() const {
-        std::cout << "  " << name << " climbs the tree" << std::endl;
+        console() << "  " << name << " climbs the tree" << '\n';
     }
     
     bool getIsIndoor() const { return isIndoor; }
@@ -129,24 +132,24 @@ private:
 public:
     Bird(const std::string& birdName, int birdAge, double birdWingspan)
         : Animal(birdName, birdAge), wingspan(birdWingspan) {
-        std::cout << "  Bird constructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Bird, Constructed, this, name);
     }
     
     ~Bird() {
-        std::cout << "  Bird destructor called for " << name << std::endl;
+        LIFECYCLE_TRACE(Bird, Destroyed, this, name);
     }
     
     void makeSound() const override {
-        std::cout << "  " << name << " chirps: Tweet! Tweet!" << std::endl;
+        console() << "  " << name << " chirps: Tweet! Tweet!" << '\n';
     }
     
     void move() const override {
-        std::cout << "  " << name << " flies through the air" << std::endl;
+        console() << "  " << name << " flies through the air" << '\n';
     }
     
     void fly() const override {
-        std::cout << "  " << name << " soars with " << wingspan 
-                  << "cm wingspan" << std::endl;
+        console() << "  " << name << " soars with " << wingspan 
+                  << "cm wingspan" << '\n';
     }
     
     double getWingspan() const { return wingspan; }
@@ -161,7 +164,7 @@ public:
     LivingThing(const std::string& sp) : species(sp) {}
     virtual ~LivingThing() = default;
     virtual void breathe() const {
-        std::cout << "  " << species << " breathes" << std::endl;
+        console() << "  " << species << " breathes" << '\n';
     }
 };
 
@@ -169,7 +172,7 @@ class Mammal : virtual public LivingThing {
 public:
     Mammal(const std::string& sp) : LivingThing(sp) {}
     void breathe() const override {
-        std::cout << "  " << species << " breathes with lungs" << std::endl;
+        console() << "  " << species << " breathes with lungs" << '\n';
     }
 };
 
@@ -177,7 +180,7 @@ class WingedAnimal : virtual public LivingThing {
 public:
     WingedAnimal(const std::string& sp) : LivingThing(sp) {}
     void breathe() const override {
-        std::cout << "  " << species << " breathes efficiently for flight" << std::endl;
+        console() << "  " << species << " breathes efficiently for flight" << '\n';
     }
 };
 
@@ -185,73 +188,75 @@ class Bat : public Mammal, public WingedAnimal {
 public:
     Bat() : LivingThing("Bat"), Mammal("Bat"), WingedAnimal("Bat") {}
     void breathe() const override {
-        std::cout << "  Bat breathes with lungs optimized for flight" << std::endl;
+        console() << "  Bat breathes with lungs optimized for flight" << '\n';
     }
 };
 
 int main() {
-    std::cout << "=== C++ Inheritance ===" << std::endl;
-    std::cout << std::endl;
+    lifecycle::ConsoleSession lifecycleSession;  // Prints or traces constructor/destructor events
+
+    console() << "=== C++ Inheritance ===" << '\n';
+    console() << '\n';
     
     // Single inheritance
-    std::cout << "1. Single inheritance:" << std::endl;
+    console() << "1. Single inheritance:" << '\n';
     Dog dog("Buddy", 3, "Golden Retriever");
     dog.makeSound();
     dog.move();
     dog.eat();
     dog.fetch();
-    std::cout << "   Breed: " << dog.getBreed() << std::endl;
-    std::cout << std::endl;
+    console() << "   Breed: " << dog.getBreed() << '\n';
+    console() << '\n';
     
     // Another single inheritance example
-    std::cout << "2. Another single inheritance example:" << std::endl;
+    console() << "2. Another single inheritance example:" << '\n';
     Cat cat("Whiskers", 2, true);
     cat.makeSound();
     cat.move();
     cat.eat();
     cat.climb();
-    std::cout << "   Indoor cat: " << (cat.getIsIndoor() ? "Yes" : "No") << std::endl;
-    std::cout << std::endl;
+    console() << "   Indoor cat: " << (cat.getIsIndoor() ? "Yes" : "No") << '\n';
+    console() << '\n';
     
     // Multiple inheritance
-    std::cout << "3. Multiple inheritance:" << std::endl;
+    console() << "3. Multiple inheritance:" << '\n';
     Bird bird("Tweety", 1, 25.5);
     bird.makeSound();
     bird.move();
     bird.fly();
     bird.eat();
-    std::cout << "   Wingspan: " << bird.getWingspan() << "cm" << std::endl;
-    std::cout << std::endl;
+    console() << "   Wingspan: " << bird.getWingspan() << "cm" << '\n';
+    console() << '\n';
     
     // Polymorphism with pointers
-    std::cout << "4. Polymorphism with pointers:" << std::endl;
+    console() << "4. Polymorphism with pointers:" << '\n';
     std::vector<Animal*> animals;
     animals.push_back(new Dog("Max", 4, "German Shepherd"));
     animals.push_back(new Cat("Luna", 3, false));
     animals.push_back(new Bird("Eagle", 2, 180.0));
     
     for (Animal* animal : animals) {
-        std::cout << "   " << animal->getName() << " (age " << animal->getAge() << "):" << std::endl;
+        console() << "   " << animal->getName() << " (age " << animal->getAge() << "):" << '\n';
         animal->makeSound();
         animal->move();
         animal->eat();
-        std::cout << std::endl;
+        console() << '\n';
     }
     
     // Clean up memory
     for (Animal* animal : animals) {
         delete animal;
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Virtual inheritance
-    std::cout << "5. Virtual inheritance (diamond problem):" << std::endl;
+    console() << "5. Virtual inheritance (diamond problem):" << '\n';
     Bat bat;
     bat.breathe();
-    std::cout << std::endl;
+    console() << '\n';
     
     // Polymorphism with references
-    std::cout << "6. Polymorphism with references:" << std::endl;
+    console() << "6. Polymorphism with references:" << '\n';
     Dog anotherDog("Rex", 5, "Labrador");
     Cat anotherCat("Mittens", 4, true);
     
@@ -260,9 +265,10 @@ int main() {
     
     animalRef1.makeSound();
     animalRef2.makeSound();
-    std::cout << std::endl;
+    console() << '\n';
     
-    std::cout << "=== End of Inheritance Example ===" << std::endl;
+    console() << "=== End of Inheritance Example ===" << '\n';
     
+    console().flush();
     return 0;
 }
@@ -1,7 +1,9 @@
-#include <iostream>
 #include <string>
 #include <vector>
 #include <memory>
+#include <cmath>
+#include "../performance/output_sink.h"
+#include "../performance/lifecycle_trace.h"
 
 /**
  * Polymorphism in C++
@@ -13,6 +15,8 @@
  * - Function overriding vs overloading
  * - Runtime polymorphism
  * - Virtual function tables (vtable)
+ * - Constructor/destructor logging through the lifecycle tracer
+ *   (run with LIFECYCLE_TRACE=<file> to record it instead of printing)
  */
 
 // Abstract base class
@@ -24,12 +28,12 @@ protected:
 public:
     Shape(const std::string& shapeName, double posX = 0, double posY = 0)
         : name(shapeName), x(posX), y(posY) {
-        std::cout << "  Shape constructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Shape, Constructed, this, name);
     }
     
     // Virtual destructor (crucial for polymorphism)
     virtual ~Shape() {
-        std::cout << "  Shape destructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Shape, Destroyed, this, name);
     }
     
     // Pure virtual functions (must be implemented by derived classes)
@@ -41,14 +45,14 @@ public:
     virtual void move(double newX, double newY) {
         x = newX;
         y = newY;
-        std::cout << "  " << name << " moved to (" << x << ", " << y << ")" << std::endl;
+        console() << "  " << name << " moved to (" << x << ", " << y << ")" << '\n';
     }
     
     // Non-virtual function
     void displayInfo() const {
-        std::cout << "  Shape: " << name << " at (" << x << ", " << y << ")" << std::endl;
-        std::cout << "    Area: " << getArea() << std::endl;
-        std::cout << "    Perimeter: " << getPerimeter() << std::endl;
+        console() << "  Shape: " << name << " at (" << x << ", " << y << ")" << '\n';
+        console() << "    Area: " << getArea() << '\n';
+        console() << "    Perimeter: " << getPerimeter() << '\n';
     }
     
     // Getter methods
@@ -65,11 +69,11 @@ private:
 public:
     Circle(const std::string& circleName, double r, double posX = 0, double posY = 0)
         : Shape(circleName, posX, posY), radius(r) {
-        std::cout << "  Circle constructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Circle, Constructed, this, name);
     }
     
     ~Circle() {
-        std::cout << "  Circle destructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Circle, Destroyed, this, name);
     }
     
     // Implement pure virtual functions
@@ -82,13 +86,13 @@ public:
     }
     
     void draw() const override {
-        std::cout << "  Drawing a circle with radius " << radius << std::endl;
+        console() << "  Drawing a circle with radius " << radius << '\n';
     }
     
     // Override virtual function
     void move(double newX, double newY) override {
         Shape::move(newX, newY);
-        std::cout << "  Circle-specific move completed" << std::endl;
+        console() << "  Circle-specific move completed" << '\n';
     }
     
     double getRadius() const { return radius; }
@@ -102,11 +106,11 @@ private:
 public:
     Rectangle(const std::string& rectName, double w, double h, double posX = 0, double posY = 0)
         : Shape(rectName, posX, posY), width(w), height(h) {
-        std::cout << "  Rectangle constructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Rectangle, Constructed, this, name);
     }
     
     ~Rectangle() {
-        std::cout << "  Rectangle destructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Rectangle, Destroyed, this, name);
     }
     
     double getArea() const override {
@@ -118,7 +122,7 @@ public:
     }
     
     void draw() const override {
-        std::cout << "  Drawing a rectangle " << width << "x" << height << std::endl;
+        console() << "  Drawing a rectangle " << width << "x" << height << '\n';
     }
     
     double getWidth() const { return width; }
@@ -133,11 +137,11 @@ private:
 public:
     Triangle(const std::string& triName, double b, double h, double posX = 0, double posY = 0)
         : Shape(triName, posX, posY), base(b), height(h) {
-        std::cout << "  Triangle constructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Triangle, Constructed, this, name);
     }
     
     ~Triangle() {
-        std::cout << "  Triangle destructor: " << name << std::endl;
+        LIFECYCLE_TRACE(Triangle, Destroyed, this, name);
     }
     
     double getArea() const override {
@@ -151,8 +155,8 @@ public:
     }
     
     void draw() const override {
-        std::cout << "  Drawing a triangle with base " << base 
-                  << " and height " << height << std::endl;
+        console() << "  Drawing a triangle with base " << base 
+                  << " and height " << height << '\n';
     }
     
     double getBase() const { return base; }
@@ -161,10 +165,10 @@ public:
 
 // Function to demonstrate polymorphism
 void demonstratePolymorphism(const std::vector<Shape*>& shapes) {
-    std::cout << "  === Polymorphism Demonstration ===" << std::endl;
+    console() << "  === Polymorphism Demonstration ===" << '\n';
     
-    for (const Shape* shape : shapes) {
-        std::cout << std::endl;
+    for (Shape* shape : shapes) {
+        console() << '\n';
         shape->displayInfo();
         shape->draw();
         shape->move(shape->getX() + 10, shape->getY() + 10);
@@ -181,35 +185,37 @@ double calculateTotalArea(const std::vector<Shape*>& shapes) {
 }
 
 int main() {
-    std::cout << "=== C++ Polymorphism ===" << std::endl;
-    std::cout << std::endl;
+    lifecycle::ConsoleSession lifecycleSession;  // Prints or traces constructor/destructor events
+
+    console() << "=== C++ Polymorphism ===" << '\n';
+    console() << '\n';
     
     // Creating objects
-    std::cout << "1. Creating shape objects:" << std::endl;
+    console() << "1. Creating shape objects:" << '\n';
     Circle circle("MyCircle", 5.0, 0, 0);
     Rectangle rectangle("MyRectangle", 4.0, 6.0, 10, 10);
     Triangle triangle("MyTriangle", 3.0, 4.0, 20, 20);
-    std::cout << std::endl;
+    console() << '\n';
     
     // Direct object calls
-    std::cout << "2. Direct object calls:" << std::endl;
+    console() << "2. Direct object calls:" << '\n';
     circle.displayInfo();
     rectangle.displayInfo();
     triangle.displayInfo();
-    std::cout << std::endl;
+    console() << '\n';
     
     // Polymorphism with pointers
-    std::cout << "3. Polymorphism with pointers:" << std::endl;
+    console() << "3. Polymorphism with pointers:" << '\n';
     std::vector<Shape*> shapes;
     shapes.push_back(&circle);
     shapes.push_back(&rectangle);
     shapes.push_back(&triangle);
     
     demonstratePolymorphism(shapes);
-    std::cout << std::endl;
+    console() << '\n';
     
     // Dynamic allocation and polymorphism
-    std::cout << "4. Dynamic allocation and polymorphism:" << std::endl;
+    console() << "4. Dynamic allocation and polymorphism:" << '\n';
     std::vector<std::unique_ptr<Shape>> dynamicShapes;
     
     dynamicShapes.push_back(std::make_unique<Circle>("DynamicCircle", 3.0));
@@ -220,47 +226,48 @@ int main() {
         shape->displayInfo();
         shape->draw();
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Polymorphism with references
-    std::cout << "5. Polymorphism with references:" << std::endl;
+    console() << "5. Polymorphism with references:" << '\n';
     Shape& shapeRef1 = circle;
     Shape& shapeRef2 = rectangle;
     
-    std::cout << "  Circle via reference:" << std::endl;
+    console() << "  Circle via reference:" << '\n';
     shapeRef1.displayInfo();
     shapeRef1.draw();
     
-    std::cout << "  Rectangle via reference:" << std::endl;
+    console() << "  Rectangle via reference:" << '\n';
     shapeRef2.displayInfo();
     shapeRef2.draw();
-    std::cout << std::endl;
+    console() << '\n';
     
     // Function that uses polymorphism
-    std::cout << "6. Function using polymorphism:" << std::endl;
+    console() << "6. Function using polymorphism:" << '\n';
     double totalArea = calculateTotalArea(shapes);
-    std::cout << "  Total area of all shapes: " << totalArea << std::endl;
-    std::cout << std::endl;
+    console() << "  Total area of all shapes: " << totalArea << '\n';
+    console() << '\n';
     
     // Virtual function table demonstration
-    std::cout << "7. Virtual function behavior:" << std::endl;
+    console() << "7. Virtual function behavior:" << '\n';
     for (Shape* shape : shapes) {
-        std::cout << "  " << shape->getName() << " area calculation: ";
-        std::cout << shape->getArea() << std::endl;
+        console() << "  " << shape->getName() << " area calculation: ";
+        console() << shape->getArea() << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Array of polymorphic objects
-    std::cout << "8. Array of polymorphic objects:" << std::endl;
+    console() << "8. Array of polymorphic objects:" << '\n';
     Shape* shapeArray[] = {&circle, &rectangle, &triangle};
     
     for (int i = 0; i < 3; ++i) {
-        std::cout << "  Shape " << (i + 1) << ": ";
+        console() << "  Shape " << (i + 1) << ": ";
         shapeArray[i]->draw();
     }
-    std::cout << std::endl;
+    console() << '\n';
     
-    std::cout << "=== End of Polymorphism Example ===" << std::endl;
+    console() << "=== End of Polymorphism Example ===" << '\n';
     
+    console().flush();
     return 0;
 }
@@ -0,0 +1,404 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#include "bench.h"
+
+/**
+ * O(1) Capability Queries without dynamic_cast
+ *
+ * This example demonstrates:
+ * - What dynamic_cast<Flyable*>(animal) costs: a cross-cast between
+ *   sibling bases that walks the RTTI of the multiple-inheritance graph
+ * - A capability mechanism: every interface gets a compile-time bit,
+ *   every object carries its class's bitmask inline plus a pointer to a
+ *   per-class table of interface offsets
+ * - as<Flyable>(animal): one load and one test for a miss, one more
+ *   load (the offset) for a hit
+ * - Capability lookups through a virtual base (the Bat diamond from
+ *   inheritance.cpp), where even static_cast is not allowed
+ * - A benchmark against dynamic_cast and a check that both agree
+ *
+ * Usage: ./perf_animal_capabilities [animalCount]   (default: 10000000)
+ */
+
+// ---------------------------------------------------------------------------
+// Capability mechanism
+// ---------------------------------------------------------------------------
+
+// Specialize for every interface that can be queried; ids must be unique
+// and below CapabilityTable::maxCapabilities
+template <typename Interface>
+struct CapabilityTraits;
+
+struct CapabilityTable {
+    static constexpr std::size_t maxCapabilities = 16;
+
+    std::uint32_t mask = 0;
+    // Offset from the CapabilityRoot subobject to each interface subobject
+    std::ptrdiff_t offsets[maxCapabilities] = {};
+};
+
+template <typename Interface>
+constexpr std::uint32_t capabilityBit() {
+    static_assert(CapabilityTraits<Interface>::id < CapabilityTable::maxCapabilities, "Capability id out of range");
+    return std::uint32_t(1) << CapabilityTraits<Interface>::id;
+}
+
+// True if Derived reaches Base only through non-virtual inheritance: the
+// downcast static_cast is ill-formed exactly when Base is a virtual base
+template <typename Base, typename Derived>
+concept NonVirtualBaseOf = requires(Base* base) { static_cast<Derived*>(base); };
+
+// Base of every hierarchy root that answers capability queries (Animal,
+// LivingThing). Constructors of concrete classes call registerCapabilities
+// with the interfaces they implement; later (more derived) constructors
+// overwrite earlier registrations, just like the vtable pointer.
+//
+// Offsets are measured on the first object of each class and cached. For
+// non-virtual bases they are fixed by the layout of Self, so subclasses can
+// inherit the registration. Through a virtual base they depend on the most
+// derived class, so only final classes may register such capabilities
+// (see Mammal and Bat below); this is enforced at compile time.
+class CapabilityRoot {
+private:
+    std::uint32_t capabilityMask = 0;
+    const CapabilityTable* capabilityTable = nullptr;
+
+    template <typename Interface>
+    friend Interface* as(CapabilityRoot* object);
+    template <typename Interface>
+    friend const Interface* as(const CapabilityRoot* object);
+
+protected:
+    template <typename Self, typename... Interfaces>
+    void registerCapabilities(Self* self) {
+        static_assert(std::is_final_v<Self> ||
+                          (NonVirtualBaseOf<CapabilityRoot, Self> && (NonVirtualBaseOf<Interfaces, Self> && ...)),
+                      "Capabilities reached through a virtual base may only be registered by a final class");
+        static const CapabilityTable table = [self] {
+            CapabilityTable result;
+            const char* root = reinterpret_cast<const char*>(static_cast<const CapabilityRoot*>(self));
+            ((result.mask |= capabilityBit<Interfaces>(),
+              result.offsets[CapabilityTraits<Interfaces>::id] =
+                  reinterpret_cast<const char*>(static_cast<const Interfaces*>(self)) - root),
+             ...);
+            return result;
+        }();
+        capabilityMask = table.mask;
+        capabilityTable = &table;
+    }
+
+public:
+    std::uint32_t capabilities() const { return capabilityMask; }
+};
+
+// Returns the Interface part of the object, or nullptr if it has none
+template <typename Interface>
+Interface* as(CapabilityRoot* object) {
+    if (!(object->capabilityMask & capabilityBit<Interface>())) {
+        return nullptr;
+    }
+    char* base = reinterpret_cast<char*>(object);
+    return reinterpret_cast<Interface*>(base + object->capabilityTable->offsets[CapabilityTraits<Interface>::id]);
+}
+
+template <typename Interface>
+const Interface* as(const CapabilityRoot* object) {
+    return as<Interface>(const_cast<CapabilityRoot*>(object));
+}
+
+template <typename Interface>
+bool has(const CapabilityRoot& object) {
+    return (object.capabilities() & capabilityBit<Interface>()) != 0;
+}
+
+// ---------------------------------------------------------------------------
+// Animal hierarchy from src/oop/inheritance.cpp. Instead of printing, the
+// methods update `flightDistance` so the benchmark can check its results.
+// ---------------------------------------------------------------------------
+
+static long long flightDistance = 0;
+
+class Animal : public CapabilityRoot {
+protected:
+    std::string name;
+    int age;
+
+public:
+    Animal(const std::string& animalName, int animalAge) : name(animalName), age(animalAge) {}
+    virtual ~Animal() = default;
+    virtual void move() const = 0;
+    std::string getName() const { return name; }
+    int getAge() const { return age; }
+};
+
+class Dog : public Animal {
+private:
+    std::string breed;
+
+public:
+    Dog(const std::string& dogName, int dogAge, const std::string& dogBreed)
+        : Animal(dogName, dogAge), breed(dogBreed) {}
+    void move() const override {}
+};
+
+class Cat : public Animal {
+private:
+    bool isIndoor;
+
+public:
+    Cat(const std::string& catName, int catAge, bool indoor = true) : Animal(catName, catAge), isIndoor(indoor) {}
+    void move() const override {}
+};
+
+class Flyable {
+public:
+    virtual void fly() const = 0;
+    virtual ~Flyable() = default;
+};
+
+template <>
+struct CapabilityTraits<Flyable> {
+    static constexpr std::size_t id = 0;
+};
+
+class Bird : public Animal, public Flyable {
+private:
+    double wingspan;
+
+public:
+    Bird(const std::string& birdName, int birdAge, double birdWingspan)
+        : Animal(birdName, birdAge), wingspan(birdWingspan) {
+        registerCapabilities<Bird, Flyable>(this);
+    }
+    void move() const override { fly(); }
+    void fly() const override { flightDistance += static_cast<long long>(wingspan); }
+};
+
+// Virtual inheritance (diamond): LivingThing is shared by Mammal and WingedAnimal
+class LivingThing : public CapabilityRoot {
+protected:
+    std::string species;
+
+public:
+    LivingThing(const std::string& sp) : species(sp) {}
+    virtual ~LivingThing() = default;
+    virtual std::string breathe() const { return species + " breathes"; }
+};
+
+class Mammal;
+class WingedAnimal;
+
+template <>
+struct CapabilityTraits<Mammal> {
+    static constexpr std::size_t id = 1;
+};
+
+template <>
+struct CapabilityTraits<WingedAnimal> {
+    static constexpr std::size_t id = 2;
+};
+
+// Mammal and WingedAnimal sit above the virtual base, so they cannot
+// register their own capability: every concrete animal below is final and
+// registers all of its capabilities itself
+class Mammal : virtual public LivingThing {
+public:
+    std::string breathe() const override { return species + " breathes with lungs"; }
+
+protected:
+    Mammal(const std::string& sp) : LivingThing(sp) {}
+};
+
+class WingedAnimal : virtual public LivingThing {
+public:
+    std::string breathe() const override { return species + " breathes efficiently for flight"; }
+
+protected:
+    WingedAnimal(const std::string& sp) : LivingThing(sp) {}
+};
+
+class Mouse final : public Mammal {
+public:
+    Mouse() : LivingThing("Mouse"), Mammal("Mouse") { registerCapabilities<Mouse, Mammal>(this); }
+};
+
+// Extra members move the shared LivingThing further away from Mammal than
+// in a Mouse, so a per-class offset for Mammal would be wrong here
+class Dolphin final : public Mammal {
+private:
+    double fins[4] = {};
+
+public:
+    Dolphin() : LivingThing("Dolphin"), Mammal("Dolphin") { registerCapabilities<Dolphin, Mammal>(this); }
+    double finArea() const { return fins[0] + fins[1] + fins[2] + fins[3]; }
+};
+
+class Bat final : public Mammal, public WingedAnimal {
+public:
+    Bat() : LivingThing("Bat"), Mammal("Bat"), WingedAnimal("Bat") {
+        registerCapabilities<Bat, Mammal, WingedAnimal>(this);
+    }
+    std::string breathe() const override { return "Bat breathes with lungs optimized for flight"; }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+// as<I>() and dynamic_cast<I*>() must find exactly the same subobject
+template <typename Interface, typename Root>
+bool agrees(Root* object) {
+    return as<Interface>(object) == dynamic_cast<Interface*>(object);
+}
+
+void checkCapabilities() {
+    std::cout << "1. Capability queries agree with dynamic_cast:" << std::endl;
+    bool passed = true;
+
+    Dog dog("Buddy", 3, "Golden Retriever");
+    Cat cat("Whiskers", 2, true);
+    Bird bird("Tweety", 1, 25.5);
+    for (Animal* animal : std::initializer_list<Animal*>{&dog, &cat, &bird}) {
+        bool ok = agrees<Flyable>(animal);
+        passed = passed && ok;
+        std::cout << "  " << std::left << std::setw(8) << animal->getName() << std::right << " as<Flyable>: "
+                  << (as<Flyable>(animal) ? "yes" : "no ") << "  matches dynamic_cast: " << (ok ? "Yes" : "No")
+                  << std::endl;
+    }
+    // The Flyable part of a Bird is not at the start of the object
+    std::cout << "  Bird at " << static_cast<void*>(&bird) << ", its Flyable part at "
+              << static_cast<void*>(as<Flyable>(static_cast<Animal*>(&bird))) << std::endl;
+
+    // Bat diamond: from the shared virtual base, static_cast to Mammal or
+    // WingedAnimal does not even compile; dynamic_cast and as<> both work
+    Bat bat;
+    LivingThing* living = &bat;
+    bool batOk = agrees<Mammal>(living) && agrees<WingedAnimal>(living) && as<Mammal>(living) != nullptr &&
+                 as<WingedAnimal>(living) != nullptr;
+    std::cout << "  Bat through LivingThing: as<Mammal> " << (as<Mammal>(living) ? "yes" : "no")
+              << ", as<WingedAnimal> " << (as<WingedAnimal>(living) ? "yes" : "no")
+              << ", matches dynamic_cast: " << (batOk ? "Yes" : "No") << std::endl;
+    std::cout << "    " << as<WingedAnimal>(living)->breathe() << std::endl;
+
+    // Other Mammals have no WingedAnimal part, and their Mammal part sits at
+    // a different distance from LivingThing in each class
+    Mouse mouse;
+    Dolphin dolphin;
+    bool mammalsOk = true;
+    for (LivingThing* mammal : std::initializer_list<LivingThing*>{&mouse, &dolphin}) {
+        bool ok = agrees<Mammal>(mammal) && agrees<WingedAnimal>(mammal) && as<Mammal>(mammal) != nullptr &&
+                  !as<WingedAnimal>(mammal);
+        mammalsOk = mammalsOk && ok;
+        std::cout << "  " << std::left << std::setw(8) << (mammal == &mouse ? "Mouse" : "Dolphin") << std::right
+                  << " as<Mammal> at " << static_cast<void*>(as<Mammal>(mammal)) << ", as<WingedAnimal> "
+                  << (as<WingedAnimal>(mammal) ? "yes" : "no") << ", matches dynamic_cast: " << (ok ? "Yes" : "No")
+                  << std::endl;
+    }
+
+    passed = passed && batOk && mammalsOk;
+    std::cout << "  Capability checks " << (passed ? "passed" : "FAILED") << std::endl;
+    std::cout << std::endl;
+}
+
+void benchmark(std::size_t count) {
+    std::cout << "2. Finding the flyers among " << count << " shuffled animals and calling fly():" << std::endl;
+    std::vector<std::unique_ptr<Animal>> owned;
+    owned.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        int age = 1 + static_cast<int>(i % 12);
+        switch (i % 3) {
+        case 0:
+            owned.push_back(std::make_unique<Dog>("Rex", age, "Labrador"));
+            break;
+        case 1:
+            owned.push_back(std::make_unique<Cat>("Luna", age, true));
+            break;
+        default:
+            owned.push_back(std::make_unique<Bird>("Tweety", age, 20.0 + static_cast<double>(i % 50)));
+            break;
+        }
+    }
+    std::shuffle(owned.begin(), owned.end(), std::mt19937(16));
+    std::vector<Animal*> animals;
+    for (const auto& animal : owned) {
+        animals.push_back(animal.get());
+    }
+
+    long long dynamicDistance = 0, capabilityDistance = 0;
+    double dynamicMs = 1e300, capabilityMs = 1e300;
+    for (int round = 0; round < 3; ++round) {
+        flightDistance = 0;
+        dynamicMs = std::min(dynamicMs, bench::timeMs([&] {
+            for (Animal* animal : animals) {
+                if (Flyable* flyer = dynamic_cast<Flyable*>(animal)) {
+                    flyer->fly();
+                }
+            }
+        }));
+        dynamicDistance = flightDistance;
+
+        flightDistance = 0;
+        capabilityMs = std::min(capabilityMs, bench::timeMs([&] {
+            for (Animal* animal : animals) {
+                if (Flyable* flyer = as<Flyable>(animal)) {
+                    flyer->fly();
+                }
+            }
+        }));
+        capabilityDistance = flightDistance;
+    }
+    std::cout << "  dynamic_cast<Flyable*>: " << std::setw(9) << dynamicMs << " ms" << std::endl;
+    std::cout << "  as<Flyable>:            " << std::setw(9) << capabilityMs << " ms (x" << dynamicMs / capabilityMs
+              << ")" << std::endl;
+
+    // Cross-casting from the virtual base of the Bat diamond
+    std::vector<std::unique_ptr<LivingThing>> things;
+    for (std::size_t i = 0; i < std::min<std::size_t>(count, 1000000); ++i) {
+        if (i % 2 == 0) {
+            things.push_back(std::make_unique<Bat>());
+        } else {
+            things.push_back(std::make_unique<Mouse>());
+        }
+    }
+    std::size_t dynamicWinged = 0, capabilityWinged = 0;
+    double dynamicBatMs = bench::timeMs([&] {
+        for (const auto& thing : things) {
+            dynamicWinged += dynamic_cast<WingedAnimal*>(thing.get()) != nullptr;
+        }
+    });
+    double capabilityBatMs = bench::timeMs([&] {
+        for (const auto& thing : things) {
+            capabilityWinged += as<WingedAnimal>(thing.get()) != nullptr;
+        }
+    });
+    std::cout << "  " << things.size() << " LivingThings (Bat/Mammal), WingedAnimal lookups: dynamic_cast "
+              << dynamicBatMs << " ms, as<> " << capabilityBatMs << " ms" << std::endl;
+
+    bool match = dynamicDistance == capabilityDistance && dynamicWinged == capabilityWinged;
+    std::cout << "  Results match: " << (match ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Animal Capabilities without dynamic_cast ===" << std::endl;
+    std::cout << std::endl;
+
+    checkCapabilities();
+
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    benchmark(count);
+
+    std::cout << "=== End of Animal Capabilities Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <typeinfo>
+#include <type_traits>
+#include "poly_collection.h"
+#include "bench.h"
+
+/**
+ * Type-Grouped Batch Dispatch for Animal Collections
+ *
+ * This example demonstrates:
+ * - Why calling virtual functions over a shuffled std::vector<Animal*>
+ *   is slow: every call is an indirect branch whose target changes
+ *   unpredictably, and every object sits somewhere else on the heap
+ * - PolyCollection<Animal> from poly_collection.h: one contiguous
+ *   segment per dynamic type, visited one type at a time
+ * - Devirtualization: visiting a segment as a `final` class lets the
+ *   compiler call (and inline) makeSound()/move() directly
+ * - A benchmark on shuffled mixes of Dog, Cat and Bird
+ *
+ * Usage: ./perf_animal_collection [animalCount]   (default: 10000000)
+ */
+
+// ---------------------------------------------------------------------------
+// Animal hierarchy from src/oop/inheritance.cpp. Instead of printing, the
+// methods record what happened in `activity`, so millions of calls can be
+// timed and the results of different containers compared.
+// ---------------------------------------------------------------------------
+
+struct ActivityTotals {
+    long long barks = 0;
+    long long meows = 0;
+    long long chirps = 0;
+    long long meals = 0;
+    long long distance = 0;  // Metres moved
+
+    bool operator==(const ActivityTotals&) const = default;
+};
+
+static ActivityTotals activity;
+
+class Animal {
+protected:
+    std::string name;
+    int age;
+
+public:
+    Animal(const std::string& animalName, int animalAge) : name(animalName), age(animalAge) {}
+    virtual ~Animal() = default;
+
+    virtual void makeSound() const {}  // Generic animal sound
+    void eat() const { ++activity.meals; }
+    virtual void move() const = 0;
+
+    std::string getName() const { return name; }
+    int getAge() const { return age; }
+};
+
+// `final` tells the compiler no class derives from Dog, so a call through
+// a Dog& can be resolved at compile time
+class Dog final : public Animal {
+private:
+    std::string breed;
+
+public:
+    Dog(const std::string& dogName, int dogAge, const std::string& dogBreed)
+        : Animal(dogName, dogAge), breed(dogBreed) {}
+
+    void makeSound() const override { activity.barks += 2; }     // "Woof! Woof!"
+    void move() const override { activity.distance += 4 * age; } // Runs on four legs
+    std::string getBreed() const { return breed; }
+};
+
+class Cat final : public Animal {
+private:
+    bool isIndoor;
+
+public:
+    Cat(const std::string& catName, int catAge, bool indoor = true) : Animal(catName, catAge), isIndoor(indoor) {}
+
+    void makeSound() const override { activity.meows += 2; }  // "Meow! Meow!"
+    void move() const override { activity.distance += isIndoor ? 1 : 3; }
+    bool getIsIndoor() const { return isIndoor; }
+};
+
+class Flyable {
+public:
+    virtual void fly() const = 0;
+    virtual ~Flyable() = default;
+};
+
+class Bird final : public Animal, public Flyable {
+private:
+    double wingspan;
+
+public:
+    Bird(const std::string& birdName, int birdAge, double birdWingspan)
+        : Animal(birdName, birdAge), wingspan(birdWingspan) {}
+
+    void makeSound() const override { activity.chirps += 2; }  // "Tweet! Tweet!"
+    void move() const override { fly(); }
+    void fly() const override { activity.distance += static_cast<long long>(wingspan) / 10; }
+    double getWingspan() const { return wingspan; }
+};
+
+// The loop body of section 4 in inheritance.cpp
+template <typename AnimalType>
+inline void exercise(const AnimalType& animal) {
+    animal.makeSound();
+    animal.move();
+    animal.eat();
+}
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void demonstrateCollection() {
+    std::cout << "1. Animals grouped by type:" << std::endl;
+    PolyCollection<Animal> animals;
+    animals.emplace<Dog>("Max", 4, "German Shepherd");
+    animals.emplace<Cat>("Luna", 3, false);
+    animals.emplace<Bird>("Eagle", 2, 180.0);
+    animals.emplace<Dog>("Rex", 5, "Labrador");
+    animals.emplace<Cat>("Mittens", 4, true);
+
+    std::cout << "  " << animals.size() << " animals in " << animals.segmentCount() << " segments:";
+    animals.for_each([](const Animal& animal) { std::cout << " " << animal.getName(); });
+    std::cout << std::endl;
+
+    std::cout << "  Dog segment:";
+    for (const Dog& dog : animals.segment<Dog>()) {
+        std::cout << " " << dog.getName() << " (" << dog.getBreed() << ")";
+    }
+    std::cout << std::endl;
+
+    activity = {};
+    animals.for_each<Dog, Cat, Bird>([](const auto& animal) { exercise(animal); });
+    std::cout << "  After one round: " << activity.barks / 2 << " barks, " << activity.meows / 2 << " meows, "
+              << activity.chirps / 2 << " chirps, " << activity.meals << " meals, " << activity.distance
+              << " m moved" << std::endl;
+    std::cout << std::endl;
+}
+
+enum class Kind { DogKind, CatKind, BirdKind };
+
+std::vector<Kind> shuffledKinds(std::size_t count) {
+    std::vector<Kind> kinds(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        kinds[i] = static_cast<Kind>(i % 3);
+    }
+    std::shuffle(kinds.begin(), kinds.end(), std::mt19937(14));
+    return kinds;
+}
+
+// Calls add(std::type_identity<T>, constructor arguments...) for every
+// animal, so every container receives the same animals in the same order
+template <typename Add>
+void createAnimals(const std::vector<Kind>& kinds, Add&& add) {
+    for (std::size_t i = 0; i < kinds.size(); ++i) {
+        int age = 1 + static_cast<int>(i % 12);
+        switch (kinds[i]) {
+        case Kind::DogKind:
+            add(std::type_identity<Dog>(), "Rex", age, "Labrador");
+            break;
+        case Kind::CatKind:
+            add(std::type_identity<Cat>(), "Luna", age, i % 2 == 0);
+            break;
+        case Kind::BirdKind:
+            add(std::type_identity<Bird>(), "Tweety", age, 20.0 + static_cast<double>(i % 200));
+            break;
+        }
+    }
+}
+
+template <typename Func>
+ActivityTotals measure(const std::string& label, int rounds, Func&& run) {
+    activity = {};
+    double best = 1e300;
+    for (int r = 0; r < rounds; ++r) {
+        best = std::min(best, bench::timeMs(run));
+    }
+    ActivityTotals totals = activity;
+    std::cout << "  " << std::left << std::setw(44) << label << std::right << std::setw(9) << best << " ms"
+              << std::endl;
+    return totals;
+}
+
+void benchmark(std::size_t count) {
+    const int rounds = 3;
+    std::cout << "2. makeSound() + move() + eat() over " << count << " shuffled animals (best of " << rounds
+              << "):" << std::endl;
+    std::vector<Kind> kinds = shuffledKinds(count);
+
+    ActivityTotals pointerTotals, sortedTotals, groupedTotals, devirtualizedTotals;
+    {
+        std::vector<std::unique_ptr<Animal>> owned;
+        owned.reserve(count);
+        createAnimals(kinds, [&](auto type, const auto&... args) {
+            owned.push_back(std::make_unique<typename decltype(type)::type>(args...));
+        });
+        std::vector<Animal*> animals;
+        animals.reserve(count);
+        for (const auto& animal : owned) {
+            animals.push_back(animal.get());
+        }
+
+        pointerTotals = measure("std::vector<Animal*> (insertion order)", rounds, [&] {
+            for (Animal* animal : animals) {
+                exercise(*animal);
+            }
+        });
+
+        // Sorting by type fixes branch prediction but not memory locality
+        std::stable_sort(animals.begin(), animals.end(), [](const Animal* a, const Animal* b) {
+            return typeid(*a).before(typeid(*b));
+        });
+        sortedTotals = measure("std::vector<Animal*> (sorted by type)", rounds, [&] {
+            for (Animal* animal : animals) {
+                exercise(*animal);
+            }
+        });
+    }
+    {
+        PolyCollection<Animal> animals;
+        createAnimals(kinds, [&](auto type, const auto&... args) {
+            animals.emplace<typename decltype(type)::type>(args...);
+        });
+
+        groupedTotals = measure("PolyCollection, for_each as Animal&", rounds,
+                                [&] { animals.for_each([](const Animal& animal) { exercise(animal); }); });
+        devirtualizedTotals = measure("PolyCollection, for_each<Dog, Cat, Bird>", rounds, [&] {
+            animals.for_each<Dog, Cat, Bird>([](const auto& animal) { exercise(animal); });
+        });
+    }
+
+    bool match = pointerTotals == sortedTotals && pointerTotals == groupedTotals &&
+                 pointerTotals == devirtualizedTotals;
+    std::cout << "  Results match: " << (match ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Type-Grouped Animal Collection ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateCollection();
+
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    benchmark(count);
+
+    std::cout << "=== End of Animal Collection Example ===" << std::endl;
+
+    return 0;
+}
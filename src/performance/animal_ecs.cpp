@@ -0,0 +1,879 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <bit>
+#include <new>
+#include <type_traits>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "bench.h"
+
+/**
+ * Parallel Entity-Component System for the Animal Simulation
+ *
+ * This example demonstrates:
+ * - Modelling the Animal hierarchy from inheritance.cpp as data: an animal
+ *   is an entity, name/age/breed/wingspan/indoor are components, and the
+ *   combination of components replaces the class (a Bat is just an entity
+ *   with both Nursing and Wingspan, no diamond required)
+ * - Archetype storage: entities with the same component set share chunks
+ *   of 4096 rows, each component in its own contiguous column (SoA)
+ * - Systems (run, roam, fly, eat, hunger) that declare which components
+ *   they read and write; a scheduler groups non-conflicting systems into
+ *   stages and runs every chunk of a stage as a parallel task
+ * - An adapter that imports existing Animal objects
+ * - A benchmark against virtual move()/eat() calls on the objects
+ *
+ * Usage: ./perf_animal_ecs [animalCount] [threads]
+ *        (default: 10000000, all hardware threads)
+ */
+
+// ---------------------------------------------------------------------------
+// Animal hierarchy from src/oop/inheritance.cpp. Instead of printing, the
+// methods update the animal's own `distance`/`meals`/`spent` counters so the
+// results can be compared with the ECS.
+// ---------------------------------------------------------------------------
+
+class Animal {
+protected:
+    std::string name;
+    int age;
+
+public:
+    long long distance = 0;  // Metres moved
+    long long meals = 0;
+    long long spent = 0;     // Energy spent on moving
+
+    Animal(const std::string& animalName, int animalAge) : name(animalName), age(animalAge) {}
+    virtual ~Animal() = default;
+
+    void eat() { ++meals; }
+    virtual void move() = 0;
+    void tire() { spent += distance / 100; }
+
+    std::string getName() const { return name; }
+    int getAge() const { return age; }
+};
+
+class Dog : public Animal {
+private:
+    std::string breed;
+
+public:
+    Dog(const std::string& dogName, int dogAge, const std::string& dogBreed)
+        : Animal(dogName, dogAge), breed(dogBreed) {}
+    void move() override { distance += 4 * age; }  // Runs on four legs
+    std::string getBreed() const { return breed; }
+};
+
+class Cat : public Animal {
+private:
+    bool isIndoor;
+
+public:
+    Cat(const std::string& catName, int catAge, bool indoor = true) : Animal(catName, catAge), isIndoor(indoor) {}
+    void move() override { distance += isIndoor ? 1 : 3; }
+    bool getIsIndoor() const { return isIndoor; }
+};
+
+class Flyable {
+public:
+    virtual void fly() = 0;
+    virtual ~Flyable() = default;
+};
+
+class Bird : public Animal, public Flyable {
+private:
+    double wingspan;
+
+public:
+    Bird(const std::string& birdName, int birdAge, double birdWingspan)
+        : Animal(birdName, birdAge), wingspan(birdWingspan) {}
+    void move() override { fly(); }
+    void fly() override { distance += static_cast<long long>(wingspan) / 10; }
+    double getWingspan() const { return wingspan; }
+};
+
+// ---------------------------------------------------------------------------
+// Components
+// ---------------------------------------------------------------------------
+
+struct Name {
+    std::string value;
+};
+struct Age {
+    int years = 0;
+};
+struct Breed {
+    std::string value;
+};
+struct Wingspan {
+    double cm = 0.0;
+};
+struct Indoor {
+    bool value = true;
+};
+struct Position {
+    long long metres = 0;
+};
+struct Energy {
+    long long meals = 0;
+    long long spent = 0;
+};
+struct Nursing {};  // Tag: the animal is a mammal
+
+template <typename... Ts>
+struct TypeList {};
+
+// Every component type must be listed here; its index is its component id
+using ComponentList = TypeList<Name, Age, Breed, Wingspan, Indoor, Position, Energy, Nursing>;
+
+template <typename T, typename... Ts>
+constexpr std::size_t indexOf(TypeList<Ts...>) {
+    constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return sizeof...(Ts);
+}
+
+template <typename... Ts>
+constexpr std::size_t lengthOf(TypeList<Ts...>) {
+    return sizeof...(Ts);
+}
+
+constexpr std::size_t componentCount = lengthOf(ComponentList());
+
+// One bit per component id
+using Signature = std::uint32_t;
+static_assert(componentCount <= 32, "Signature has one bit per component");
+
+template <typename C>
+constexpr std::size_t componentId() {
+    constexpr std::size_t id = indexOf<C>(ComponentList());
+    static_assert(id < componentCount, "Component is missing from ComponentList");
+    return id;
+}
+
+template <typename... Cs>
+constexpr Signature signatureOf() {
+    return (Signature(0) | ... | (Signature(1) << componentId<Cs>()));
+}
+
+// How to move and destroy a component without knowing its type
+struct ComponentInfo {
+    std::size_t size;
+    std::size_t align;
+    void (*moveConstruct)(void* destination, void* source);
+    void (*destroy)(void* component);
+};
+
+template <typename... Cs>
+constexpr std::array<ComponentInfo, sizeof...(Cs)> makeComponentInfos(TypeList<Cs...>) {
+    return {ComponentInfo{sizeof(Cs), alignof(Cs),
+                          [](void* destination, void* source) {
+                              ::new (destination) Cs(std::move(*static_cast<Cs*>(source)));
+                          },
+                          [](void* component) { static_cast<Cs*>(component)->~Cs(); }}...};
+}
+
+constexpr std::array<ComponentInfo, componentCount> componentInfos = makeComponentInfos(ComponentList());
+
+// ---------------------------------------------------------------------------
+// Entities and archetype chunks
+// ---------------------------------------------------------------------------
+
+struct Entity {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+};
+
+// Storage for up to `capacity` entities of one archetype. All columns live
+// in one 64-byte aligned block; column c starts at columns[c] (nullptr if
+// the archetype has no component c).
+class Chunk {
+public:
+    static constexpr std::size_t capacity = 4096;
+
+private:
+    Signature signature;
+    std::size_t count = 0;
+    std::array<std::byte*, componentCount> columns{};
+    std::array<Entity, capacity> entities;
+    std::byte* storage = nullptr;
+
+    friend class World;
+
+    void* at(std::size_t component, std::size_t row) {
+        return columns[component] + row * componentInfos[component].size;
+    }
+
+    // Destroys the components in `row`
+    void destroyRow(std::size_t row) {
+        for (std::size_t c = 0; c < componentCount; ++c) {
+            if (columns[c]) {
+                componentInfos[c].destroy(at(c, row));
+            }
+        }
+    }
+
+public:
+    explicit Chunk(Signature chunkSignature) : signature(chunkSignature) {
+        std::size_t offsets[componentCount] = {};
+        std::size_t bytes = 0;
+        for (std::size_t c = 0; c < componentCount; ++c) {
+            if (signature & (Signature(1) << c)) {
+                bytes = (bytes + 63) / 64 * 64;  // Every column on its own cache lines
+                offsets[c] = bytes;
+                bytes += capacity * componentInfos[c].size;
+            }
+        }
+        storage = static_cast<std::byte*>(::operator new(std::max<std::size_t>(bytes, 1), std::align_val_t(64)));
+        for (std::size_t c = 0; c < componentCount; ++c) {
+            if (signature & (Signature(1) << c)) {
+                columns[c] = storage + offsets[c];
+            }
+        }
+    }
+
+    ~Chunk() {
+        for (std::size_t row = 0; row < count; ++row) {
+            destroyRow(row);
+        }
+        ::operator delete(storage, std::align_val_t(64));
+    }
+
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+
+    std::size_t size() const { return count; }
+    bool full() const { return count == capacity; }
+    Signature getSignature() const { return signature; }
+
+    template <typename C>
+    std::span<C> components() {
+        return std::span<C>(reinterpret_cast<C*>(columns[componentId<C>()]), count);
+    }
+};
+
+struct Archetype {
+    Signature signature;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+
+    explicit Archetype(Signature archetypeSignature) : signature(archetypeSignature) {}
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (const auto& chunk : chunks) {
+            total += chunk->size();
+        }
+        return total;
+    }
+};
+
+class World {
+private:
+    struct EntityRecord {
+        Archetype* archetype = nullptr;  // nullptr: slot is free
+        std::size_t chunk = 0;
+        std::size_t row = 0;
+        std::uint32_t generation = 0;
+    };
+
+    // Few archetypes are expected, so a linear search beats a hash map
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::vector<EntityRecord> records;
+    std::vector<std::uint32_t> freeIndices;
+
+    Archetype& findOrCreate(Signature signature) {
+        for (const auto& archetype : archetypes) {
+            if (archetype->signature == signature) {
+                return *archetype;
+            }
+        }
+        archetypes.push_back(std::make_unique<Archetype>(signature));
+        return *archetypes.back();
+    }
+
+    Entity allocateEntity() {
+        if (!freeIndices.empty()) {
+            std::uint32_t index = freeIndices.back();
+            freeIndices.pop_back();
+            return {index, records[index].generation};
+        }
+        records.emplace_back();
+        return {static_cast<std::uint32_t>(records.size() - 1), 0};
+    }
+
+    const EntityRecord* find(Entity entity) const {
+        if (entity.index >= records.size()) {
+            return nullptr;
+        }
+        const EntityRecord& record = records[entity.index];
+        return record.archetype && record.generation == entity.generation ? &record : nullptr;
+    }
+
+public:
+    // Creates an entity whose archetype is exactly the given components
+    template <typename... Cs>
+    Entity create(Cs&&... components) {
+        constexpr Signature signature = signatureOf<std::remove_cvref_t<Cs>...>();
+        static_assert(std::popcount(signature) == sizeof...(Cs), "Each component may appear only once");
+
+        Archetype& archetype = findOrCreate(signature);
+        if (archetype.chunks.empty() || archetype.chunks.back()->full()) {
+            archetype.chunks.push_back(std::make_unique<Chunk>(signature));
+        }
+        Chunk& chunk = *archetype.chunks.back();
+        std::size_t row = chunk.count;
+        (::new (chunk.at(componentId<std::remove_cvref_t<Cs>>(), row))
+             std::remove_cvref_t<Cs>(std::forward<Cs>(components)),
+         ...);
+
+        Entity entity = allocateEntity();
+        chunk.entities[row] = entity;
+        ++chunk.count;
+        records[entity.index] = {&archetype, archetype.chunks.size() - 1, row, entity.generation};
+        return entity;
+    }
+
+    // Removes the entity; the last entity of its archetype moves into the
+    // hole so chunks stay dense
+    void destroy(Entity entity) {
+        const EntityRecord* found = find(entity);
+        if (!found) {
+            return;
+        }
+        EntityRecord record = *found;
+        Archetype& archetype = *record.archetype;
+        Chunk& chunk = *archetype.chunks[record.chunk];
+        Chunk& last = *archetype.chunks.back();
+        std::size_t lastRow = last.count - 1;
+
+        chunk.destroyRow(record.row);
+        if (&chunk != &last || record.row != lastRow) {
+            for (std::size_t c = 0; c < componentCount; ++c) {
+                if (chunk.columns[c]) {
+                    componentInfos[c].moveConstruct(chunk.at(c, record.row), last.at(c, lastRow));
+                }
+            }
+            last.destroyRow(lastRow);
+            Entity moved = last.entities[lastRow];
+            chunk.entities[record.row] = moved;
+            records[moved.index].chunk = record.chunk;
+            records[moved.index].row = record.row;
+        }
+        --last.count;
+        if (last.count == 0) {
+            archetype.chunks.pop_back();
+        }
+
+        records[entity.index].archetype = nullptr;
+        ++records[entity.index].generation;
+        freeIndices.push_back(entity.index);
+    }
+
+    bool alive(Entity entity) const { return find(entity) != nullptr; }
+
+    // Returns the entity's component, or nullptr if it has none
+    template <typename C>
+    C* get(Entity entity) {
+        const EntityRecord* record = find(entity);
+        if (!record || !(record->archetype->signature & signatureOf<C>())) {
+            return nullptr;
+        }
+        Chunk& chunk = *record->archetype->chunks[record->chunk];
+        return static_cast<C*>(chunk.at(componentId<C>(), record->row));
+    }
+
+    // Calls f(chunk) for every chunk whose archetype has all `required` components
+    template <typename F>
+    void forEachChunk(Signature required, F&& f) {
+        for (const auto& archetype : archetypes) {
+            if ((archetype->signature & required) == required) {
+                for (const auto& chunk : archetype->chunks) {
+                    f(*chunk);
+                }
+            }
+        }
+    }
+
+    std::size_t archetypeCount() const { return archetypes.size(); }
+    const Archetype& archetype(std::size_t i) const { return *archetypes[i]; }
+};
+
+// ---------------------------------------------------------------------------
+// Systems and the parallel scheduler
+// ---------------------------------------------------------------------------
+
+// What a system sees of one chunk. Asking for a component the system did
+// not declare throws, so the declared access used for scheduling is
+// guaranteed to be the real one.
+class ChunkView {
+private:
+    Chunk& chunk;
+    Signature reads;
+    Signature writes;
+
+    void check(Signature allowed, Signature component, const char* what) const {
+        if (!(allowed & component)) {
+            throw std::logic_error(std::string("System accesses an undeclared component for ") + what);
+        }
+    }
+
+public:
+    ChunkView(Chunk& viewChunk, Signature viewReads, Signature viewWrites)
+        : chunk(viewChunk), reads(viewReads), writes(viewWrites) {}
+
+    std::size_t size() const { return chunk.size(); }
+
+    template <typename C>
+    std::span<const C> read() const {
+        check(reads | writes, signatureOf<C>(), "reading");
+        return chunk.components<C>();
+    }
+
+    template <typename C>
+    std::span<C> write() const {
+        check(writes, signatureOf<C>(), "writing");
+        return chunk.components<C>();
+    }
+};
+
+template <typename... Cs>
+struct Reads {
+    static constexpr Signature signature = signatureOf<Cs...>();
+};
+
+template <typename... Cs>
+struct Writes {
+    static constexpr Signature signature = signatureOf<Cs...>();
+};
+
+// A system runs on every chunk that has all components it reads and writes
+struct System {
+    std::string name;
+    Signature reads;
+    Signature writes;
+    std::function<void(const ChunkView&)> update;
+
+    Signature required() const { return reads | writes; }
+};
+
+template <typename R, typename W, typename F>
+System makeSystem(const std::string& name, F&& update) {
+    return System{name, R::signature, W::signature, std::forward<F>(update)};
+}
+
+// A fixed set of threads that run `count` indexed tasks at a time; the
+// calling thread takes part, so a pool of size 1 has no extra threads
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::size_t jobSize = 0;
+    std::atomic<std::size_t> next{0};
+    std::size_t generation = 0;
+    std::size_t busy = 0;
+    bool stopping = false;
+
+    void work() {
+        for (std::size_t i = next.fetch_add(1); i < jobSize; i = next.fetch_add(1)) {
+            (*job)(i);
+        }
+    }
+
+    void workerLoop() {
+        std::size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            lock.unlock();
+            work();
+            lock.lock();
+            if (--busy == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit WorkerPool(unsigned threads) {
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    unsigned threadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Calls task(i) for every i in [0, count) and returns when all are done
+    void run(std::size_t count, const std::function<void(std::size_t)>& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &task;
+            jobSize = count;
+            next = 0;
+            busy = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+        work();
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return busy == 0; });
+    }
+};
+
+// Orders systems into stages. Two systems conflict if one writes a
+// component the other reads or writes and some archetype is matched by
+// both; a system then runs in a later stage than every earlier-registered
+// system it conflicts with. Within a stage all (system, chunk) pairs run
+// in parallel. The plan is rebuilt when new archetypes appear.
+class Scheduler {
+private:
+    std::vector<System> systems;
+    std::vector<std::vector<std::size_t>> stages;
+    std::size_t plannedArchetypes = 0;
+    bool planned = false;
+
+    static bool matches(const Archetype& archetype, const System& system) {
+        return (archetype.signature & system.required()) == system.required();
+    }
+
+    bool conflicts(const System& a, const System& b, const World& world) const {
+        Signature overlap = (a.writes & b.required()) | (b.writes & a.required());
+        if (!overlap) {
+            return false;
+        }
+        for (std::size_t i = 0; i < world.archetypeCount(); ++i) {
+            if (matches(world.archetype(i), a) && matches(world.archetype(i), b)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void plan(const World& world) {
+        std::vector<std::size_t> stageOf(systems.size(), 0);
+        stages.clear();
+        for (std::size_t s = 0; s < systems.size(); ++s) {
+            for (std::size_t earlier = 0; earlier < s; ++earlier) {
+                if (conflicts(systems[earlier], systems[s], world)) {
+                    stageOf[s] = std::max(stageOf[s], stageOf[earlier] + 1);
+                }
+            }
+            if (stageOf[s] >= stages.size()) {
+                stages.resize(stageOf[s] + 1);
+            }
+            stages[stageOf[s]].push_back(s);
+        }
+        plannedArchetypes = world.archetypeCount();
+        planned = true;
+    }
+
+public:
+    void add(System system) {
+        systems.push_back(std::move(system));
+        planned = false;
+    }
+
+    const std::vector<std::vector<std::size_t>>& stagesFor(const World& world) {
+        if (!planned || plannedArchetypes != world.archetypeCount()) {
+            plan(world);
+        }
+        return stages;
+    }
+
+    const System& system(std::size_t i) const { return systems[i]; }
+
+    void tick(World& world, WorkerPool& pool) {
+        struct Task {
+            const System* system;
+            Chunk* chunk;
+        };
+        std::vector<Task> tasks;
+        for (const auto& stage : stagesFor(world)) {
+            tasks.clear();
+            for (std::size_t s : stage) {
+                const System& system = systems[s];
+                world.forEachChunk(system.required(), [&](Chunk& chunk) { tasks.push_back({&system, &chunk}); });
+            }
+            pool.run(tasks.size(), [&](std::size_t i) {
+                const Task& task = tasks[i];
+                task.system->update(ChunkView(*task.chunk, task.system->reads, task.system->writes));
+            });
+        }
+    }
+};
+
+// The behaviour of move(), eat() and tire() as systems
+void addAnimalSystems(Scheduler& scheduler) {
+    scheduler.add(makeSystem<Reads<Age, Breed>, Writes<Position>>("run", [](const ChunkView& view) {
+        auto ages = view.read<Age>();
+        auto positions = view.write<Position>();
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            positions[i].metres += 4 * ages[i].years;
+        }
+    }));
+    scheduler.add(makeSystem<Reads<Indoor>, Writes<Position>>("roam", [](const ChunkView& view) {
+        auto indoor = view.read<Indoor>();
+        auto positions = view.write<Position>();
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            positions[i].metres += indoor[i].value ? 1 : 3;
+        }
+    }));
+    scheduler.add(makeSystem<Reads<Wingspan>, Writes<Position>>("fly", [](const ChunkView& view) {
+        auto wingspans = view.read<Wingspan>();
+        auto positions = view.write<Position>();
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            positions[i].metres += static_cast<long long>(wingspans[i].cm) / 10;
+        }
+    }));
+    scheduler.add(makeSystem<Reads<>, Writes<Energy>>("eat", [](const ChunkView& view) {
+        for (Energy& energy : view.write<Energy>()) {
+            ++energy.meals;
+        }
+    }));
+    scheduler.add(makeSystem<Reads<Position>, Writes<Energy>>("hunger", [](const ChunkView& view) {
+        auto positions = view.read<Position>();
+        auto energies = view.write<Energy>();
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            energies[i].spent += positions[i].metres / 100;
+        }
+    }));
+}
+
+// ---------------------------------------------------------------------------
+// Adapter: existing Animal objects become entities
+// ---------------------------------------------------------------------------
+
+Entity importAnimal(World& world, const Animal& animal) {
+    Name name{animal.getName()};
+    Age age{animal.getAge()};
+    Position position{animal.distance};
+    Energy energy{animal.meals, animal.spent};
+    if (const auto* dog = dynamic_cast<const Dog*>(&animal)) {
+        return world.create(std::move(name), age, Breed{dog->getBreed()}, position, energy);
+    }
+    if (const auto* cat = dynamic_cast<const Cat*>(&animal)) {
+        return world.create(std::move(name), age, Indoor{cat->getIsIndoor()}, position, energy);
+    }
+    if (const auto* bird = dynamic_cast<const Bird*>(&animal)) {
+        return world.create(std::move(name), age, Wingspan{bird->getWingspan()}, position, energy);
+    }
+    // Unknown kinds keep their common data; no movement system matches them
+    return world.create(std::move(name), age, position, energy);
+}
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+std::string describe(Signature signature) {
+    static const char* names[componentCount] = {"Name", "Age", "Breed", "Wingspan", "Indoor", "Position", "Energy",
+                                                "Nursing"};
+    std::string text;
+    for (std::size_t c = 0; c < componentCount; ++c) {
+        if (signature & (Signature(1) << c)) {
+            text += text.empty() ? "" : ", ";
+            text += names[c];
+        }
+    }
+    return text;
+}
+
+void demonstrateWorld() {
+    std::cout << "1. Importing animals into the world:" << std::endl;
+    std::vector<std::unique_ptr<Animal>> zoo;
+    zoo.push_back(std::make_unique<Dog>("Max", 4, "German Shepherd"));
+    zoo.push_back(std::make_unique<Cat>("Luna", 3, false));
+    zoo.push_back(std::make_unique<Bird>("Eagle", 2, 180.0));
+    zoo.push_back(std::make_unique<Dog>("Rex", 5, "Labrador"));
+
+    World world;
+    std::vector<Entity> entities;
+    for (const auto& animal : zoo) {
+        entities.push_back(importAnimal(world, *animal));
+    }
+    // The Bat diamond from inheritance.cpp: Mammal + WingedAnimal becomes
+    // Nursing + Wingspan, and the fly system picks it up automatically
+    Entity bat = world.create(Name{"Bat"}, Age{1}, Wingspan{30.0}, Nursing{}, Position{}, Energy{});
+
+    for (std::size_t i = 0; i < world.archetypeCount(); ++i) {
+        const Archetype& archetype = world.archetype(i);
+        std::cout << "  Archetype {" << describe(archetype.signature) << "}: " << archetype.size() << " entities"
+                  << std::endl;
+    }
+
+    Scheduler scheduler;
+    addAnimalSystems(scheduler);
+    const auto& stages = scheduler.stagesFor(world);
+    for (std::size_t s = 0; s < stages.size(); ++s) {
+        std::cout << "  Stage " << s + 1 << ":";
+        for (std::size_t system : stages[s]) {
+            std::cout << " " << scheduler.system(system).name;
+        }
+        std::cout << std::endl;
+    }
+
+    WorkerPool pool(2);
+    scheduler.tick(world, pool);
+    std::cout << "  After one tick: " << world.get<Name>(entities[0])->value << " ("
+              << world.get<Breed>(entities[0])->value << ") moved " << world.get<Position>(entities[0])->metres
+              << " m, " << world.get<Name>(bat)->value << " flew " << world.get<Position>(bat)->metres << " m"
+              << std::endl;
+
+    world.destroy(entities[0]);
+    std::cout << "  Destroyed Max: alive " << (world.alive(entities[0]) ? "Yes" : "No") << ", Rex still has breed "
+              << world.get<Breed>(entities[3])->value << std::endl;
+    std::cout << std::endl;
+}
+
+struct Totals {
+    long long distance = 0;
+    long long meals = 0;
+    long long spent = 0;
+
+    bool operator==(const Totals&) const = default;
+};
+
+Totals totalsOf(const std::vector<std::unique_ptr<Animal>>& animals) {
+    Totals totals;
+    for (const auto& animal : animals) {
+        totals.distance += animal->distance;
+        totals.meals += animal->meals;
+        totals.spent += animal->spent;
+    }
+    return totals;
+}
+
+Totals totalsOf(World& world) {
+    Totals totals;
+    world.forEachChunk(signatureOf<Position, Energy>(), [&](Chunk& chunk) {
+        for (const Position& position : chunk.components<Position>()) {
+            totals.distance += position.metres;
+        }
+        for (const Energy& energy : chunk.components<Energy>()) {
+            totals.meals += energy.meals;
+            totals.spent += energy.spent;
+        }
+    });
+    return totals;
+}
+
+void benchmark(std::size_t count, unsigned threads) {
+    const int ticks = 5;
+    std::cout << "2. " << ticks << " ticks of move() + eat() + tire() over " << count << " animals:" << std::endl;
+
+    std::vector<std::unique_ptr<Animal>> animals;
+    animals.reserve(count);
+    std::mt19937 rng(17);
+    for (std::size_t i = 0; i < count; ++i) {
+        int age = 1 + static_cast<int>(i % 12);
+        switch (rng() % 3) {
+        case 0:
+            animals.push_back(std::make_unique<Dog>("Rex", age, "Labrador"));
+            break;
+        case 1:
+            animals.push_back(std::make_unique<Cat>("Luna", age, i % 2 == 0));
+            break;
+        default:
+            animals.push_back(std::make_unique<Bird>("Tweety", age, 20.0 + static_cast<double>(i % 200)));
+            break;
+        }
+    }
+
+    World world;
+    double importMs = bench::timeMs([&] {
+        for (const auto& animal : animals) {
+            importAnimal(world, *animal);
+        }
+    });
+    std::cout << "  Import into " << world.archetypeCount() << " archetypes: " << importMs << " ms" << std::endl;
+
+    auto runObjects = [&] {
+        for (int t = 0; t < ticks; ++t) {
+            for (const auto& animal : animals) {
+                animal->move();
+                animal->eat();
+                animal->tire();
+            }
+        }
+    };
+    Scheduler scheduler;
+    addAnimalSystems(scheduler);
+
+    double objectMs = bench::timeMs(runObjects);
+    std::cout << "  Virtual calls on objects:  " << std::setw(9) << objectMs << " ms" << std::endl;
+
+    bool match = true;
+    std::vector<unsigned> threadCounts = {1};
+    if (threads > 1) {
+        threadCounts.push_back(threads);
+    }
+    for (std::size_t run = 0; run < threadCounts.size(); ++run) {
+        if (run > 0) {
+            runObjects();  // Keep the objects in step with the world
+        }
+        WorkerPool pool(threadCounts[run]);
+        double ecsMs = bench::timeMs([&] {
+            for (int t = 0; t < ticks; ++t) {
+                scheduler.tick(world, pool);
+            }
+        });
+        match = match && totalsOf(world) == totalsOf(animals);
+        std::cout << "  ECS, " << std::setw(2) << pool.threadCount() << " thread(s):        " << std::setw(9) << ecsMs
+                  << " ms (x" << objectMs / ecsMs << ")" << std::endl;
+    }
+    std::cout << "  Results match: " << (match ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Animal Entity-Component System ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateWorld();
+
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                : std::thread::hardware_concurrency();
+    benchmark(count, std::max(1u, threads));
+
+    std::cout << "=== End of Animal ECS Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,423 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <new>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <thread>
+#include "bench.h"
+
+/**
+ * Recycling Object Pools for Animal Subclasses
+ *
+ * This example demonstrates:
+ * - A typed, thread-local free list per concrete class (ObjectPool<Dog>,
+ *   ObjectPool<Cat>, ObjectPool<Bird>): freed objects leave their memory
+ *   in the pool and the next allocation of that class reuses it
+ * - std::unique_ptr handles with a custom deleter (PoolPtr<T>) that can
+ *   be converted to PoolPtr<Animal> or PoolPtr<Flyable> like any
+ *   unique_ptr, and still return the memory to the right pool
+ * - Running the virtual destructor chain (~Bird -> ~Flyable -> ~Animal)
+ *   and finding the start of a multiply-inherited object with
+ *   dynamic_cast<void*>
+ * - Hit/miss statistics and a benchmark against new/delete
+ *
+ * Usage: ./perf_animal_pool [operations] [population]   (default: 10000000 10000)
+ */
+
+// ---------------------------------------------------------------------------
+// Allocation counter: every operator new in this program goes through here
+// ---------------------------------------------------------------------------
+
+static std::atomic<std::size_t> heapAllocations{0};
+
+void* operator new(std::size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+// ---------------------------------------------------------------------------
+// PoolDeleter / PoolPtr
+// ---------------------------------------------------------------------------
+
+class PoolDeleter {
+private:
+    void (*release)(void* block) = nullptr;  // Returns memory to the pool of the concrete type
+
+public:
+    PoolDeleter() = default;
+    explicit PoolDeleter(void (*releaseBlock)(void*)) : release(releaseBlock) {}
+
+    // U may be any polymorphic base of the pooled object (Animal, Flyable...).
+    // dynamic_cast<void*> yields the address of the complete object, which
+    // differs from `object` when U is not the first base class.
+    template <typename U>
+    void operator()(U* object) const {
+        static_assert(std::has_virtual_destructor_v<U>, "PoolPtr<U> needs a virtual destructor in U");
+        void* block = dynamic_cast<void*>(object);
+        object->~U();  // Virtual: runs the whole destructor chain
+        release(block);
+    }
+};
+
+template <typename T>
+using PoolPtr = std::unique_ptr<T, PoolDeleter>;
+
+// ---------------------------------------------------------------------------
+// ObjectPool<T>: a thread-local free list of blocks sized and aligned for T
+// ---------------------------------------------------------------------------
+
+struct PoolStats {
+    std::size_t hits = 0;      // Allocations served from the free list
+    std::size_t misses = 0;    // Allocations that went to operator new
+    std::size_t recycled = 0;  // Blocks returned to the free list
+    std::size_t trimmed = 0;   // Blocks handed back to operator delete
+    std::size_t cached = 0;    // Blocks currently in the free list
+};
+
+template <typename T>
+class ObjectPool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static_assert(sizeof(T) >= sizeof(FreeBlock), "Pooled objects must be able to hold a free-list link");
+
+    // Per-thread state; blocks still cached when a thread exits are freed
+    struct ThreadCache {
+        FreeBlock* head = nullptr;
+        PoolStats stats;
+
+        ~ThreadCache() { trimAll(*this); }
+    };
+
+    static constexpr std::size_t maxCached = 1 << 16;  // Keep at most this many free blocks per thread
+
+    static ThreadCache& cache() {
+        thread_local ThreadCache threadCache;
+        return threadCache;
+    }
+
+    static void trimAll(ThreadCache& threadCache) {
+        while (FreeBlock* block = threadCache.head) {
+            threadCache.head = block->next;
+            std::allocator<T>().deallocate(reinterpret_cast<T*>(block), 1);
+            ++threadCache.stats.trimmed;
+            --threadCache.stats.cached;
+        }
+    }
+
+    static void* acquire() {
+        ThreadCache& threadCache = cache();
+        if (FreeBlock* block = threadCache.head) {
+            threadCache.head = block->next;
+            ++threadCache.stats.hits;
+            --threadCache.stats.cached;
+            return block;
+        }
+        ++threadCache.stats.misses;
+        return std::allocator<T>().allocate(1);
+    }
+
+    // The block goes to the free list of the thread that releases it
+    static void release(void* memory) {
+        ThreadCache& threadCache = cache();
+        if (threadCache.stats.cached >= maxCached) {
+            std::allocator<T>().deallocate(static_cast<T*>(memory), 1);
+            ++threadCache.stats.trimmed;
+            return;
+        }
+        threadCache.head = ::new (memory) FreeBlock{threadCache.head};
+        ++threadCache.stats.recycled;
+        ++threadCache.stats.cached;
+    }
+
+public:
+    template <typename... Args>
+    static PoolPtr<T> make(Args&&... args) {
+        void* memory = acquire();
+        try {
+            T* object = ::new (memory) T(std::forward<Args>(args)...);
+            return PoolPtr<T>(object, PoolDeleter(&ObjectPool::release));
+        } catch (...) {
+            release(memory);
+            throw;
+        }
+    }
+
+    // Statistics of the calling thread
+    static PoolStats stats() { return cache().stats; }
+
+    // Gives the calling thread's cached blocks back to operator delete
+    static void trim() { trimAll(cache()); }
+};
+
+template <typename T, typename... Args>
+PoolPtr<T> makePooled(Args&&... args) {
+    return ObjectPool<T>::make(std::forward<Args>(args)...);
+}
+
+// ---------------------------------------------------------------------------
+// Animal hierarchy from src/oop/inheritance.cpp (logging only when verbose)
+// ---------------------------------------------------------------------------
+
+static bool verboseLifecycle = false;
+static thread_local std::size_t animalDestructors = 0;  // Proves the base destructor always ran
+
+class Animal {
+protected:
+    std::string name;
+    int age;
+
+public:
+    Animal(const std::string& animalName, int animalAge) : name(animalName), age(animalAge) {
+        if (verboseLifecycle) std::cout << "  Animal constructor called for " << name << std::endl;
+    }
+    virtual ~Animal() {
+        ++animalDestructors;
+        if (verboseLifecycle) std::cout << "  Animal destructor called for " << name << std::endl;
+    }
+    virtual void makeSound() const {
+        std::cout << "  " << name << " makes a generic animal sound" << std::endl;
+    }
+    virtual void move() const = 0;
+    std::string getName() const { return name; }
+    int getAge() const { return age; }
+};
+
+class Dog : public Animal {
+private:
+    std::string breed;
+
+public:
+    Dog(const std::string& dogName, int dogAge, const std::string& dogBreed)
+        : Animal(dogName, dogAge), breed(dogBreed) {
+        if (verboseLifecycle) std::cout << "  Dog constructor called for " << name << std::endl;
+    }
+    ~Dog() {
+        if (verboseLifecycle) std::cout << "  Dog destructor called for " << name << std::endl;
+    }
+    void makeSound() const override {
+        std::cout << "  " << name << " barks: Woof! Woof!" << std::endl;
+    }
+    void move() const override {
+        std::cout << "  " << name << " runs on four legs" << std::endl;
+    }
+};
+
+class Cat : public Animal {
+private:
+    bool isIndoor;
+
+public:
+    Cat(const std::string& catName, int catAge, bool indoor = true) : Animal(catName, catAge), isIndoor(indoor) {
+        if (verboseLifecycle) std::cout << "  Cat constructor called for " << name << std::endl;
+    }
+    ~Cat() {
+        if (verboseLifecycle) std::cout << "  Cat destructor called for " << name << std::endl;
+    }
+    void makeSound() const override {
+        std::cout << "  " << name << " meows: Meow! Meow!" << std::endl;
+    }
+    void move() const override {
+        std::cout << "  " << name << " walks silently" << std::endl;
+    }
+};
+
+class Flyable {
+public:
+    virtual void fly() const = 0;
+    virtual ~Flyable() {
+        if (verboseLifecycle) std::cout << "  Flyable destructor called" << std::endl;
+    }
+};
+
+class Bird : public Animal, public Flyable {
+private:
+    double wingspan;
+
+public:
+    Bird(const std::string& birdName, int birdAge, double birdWingspan)
+        : Animal(birdName, birdAge), wingspan(birdWingspan) {
+        if (verboseLifecycle) std::cout << "  Bird constructor called for " << name << std::endl;
+    }
+    ~Bird() {
+        if (verboseLifecycle) std::cout << "  Bird destructor called for " << name << std::endl;
+    }
+    void makeSound() const override {
+        std::cout << "  " << name << " chirps: Tweet! Tweet!" << std::endl;
+    }
+    void move() const override {
+        std::cout << "  " << name << " flies through the air" << std::endl;
+    }
+    void fly() const override {
+        std::cout << "  " << name << " soars with " << wingspan << "cm wingspan" << std::endl;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void printStats(const std::string& label, const PoolStats& stats) {
+    std::cout << "  " << std::left << std::setw(6) << label << std::right << " hits " << std::setw(9) << stats.hits
+              << "  misses " << std::setw(6) << stats.misses << "  recycled " << std::setw(9) << stats.recycled
+              << "  trimmed " << std::setw(6) << stats.trimmed << "  cached " << std::setw(6) << stats.cached
+              << std::endl;
+}
+
+void demonstratePool() {
+    verboseLifecycle = true;
+
+    std::cout << "1. Pooled animals behind base-class handles:" << std::endl;
+    std::vector<PoolPtr<Animal>> animals;
+    animals.push_back(makePooled<Dog>("Max", 4, "German Shepherd"));
+    animals.push_back(makePooled<Cat>("Luna", 3, false));
+    for (const PoolPtr<Animal>& animal : animals) {
+        animal->makeSound();
+    }
+    std::cout << "  Clearing the vector (virtual destructor chain, memory goes back to the pools):" << std::endl;
+    animals.clear();
+    std::cout << std::endl;
+
+    std::cout << "2. Bird through its second base class (Flyable):" << std::endl;
+    PoolPtr<Bird> bird = makePooled<Bird>("Eagle", 2, 180.0);
+    void* birdAddress = bird.get();
+    PoolPtr<Flyable> flyer = std::move(bird);
+    std::cout << "  Bird at " << birdAddress << ", its Flyable part at " << static_cast<void*>(flyer.get())
+              << std::endl;
+    flyer->fly();
+    flyer.reset();
+    PoolPtr<Bird> nextBird = makePooled<Bird>("Robin", 1, 25.0);
+    std::cout << "  Next Bird reuses the same block: "
+              << (static_cast<void*>(nextBird.get()) == birdAddress ? "Yes" : "No") << std::endl;
+    nextBird.reset();
+    std::cout << std::endl;
+
+    verboseLifecycle = false;
+}
+
+// Keeps `population` animals alive and replaces a random one per operation,
+// like a simulation where animals are born and die at a high rate
+template <typename Handle, typename Create>
+std::size_t churn(std::size_t operations, std::size_t population, std::uint32_t seed, Create&& create) {
+    std::mt19937 rng(seed);
+    std::vector<Handle> animals;
+    animals.reserve(population);
+    for (std::size_t i = 0; i < population; ++i) {
+        animals.push_back(create(static_cast<int>(i % 3), static_cast<int>(i % 12)));
+    }
+    std::size_t checksum = 0;
+    for (std::size_t op = 0; op < operations; ++op) {
+        std::uint32_t random = rng();
+        Handle& slot = animals[random % population];
+        checksum += static_cast<std::size_t>(slot->getAge());
+        slot.reset();  // Destroy first so the pool can hand the block straight back
+        slot = create(static_cast<int>((random >> 8) % 3), static_cast<int>((random >> 12) % 12));
+    }
+    return checksum;
+}
+
+std::unique_ptr<Animal> createWithNew(int kind, int age) {
+    switch (kind) {
+    case 0:
+        return std::make_unique<Dog>("Rex", age, "Labrador");
+    case 1:
+        return std::make_unique<Cat>("Luna", age, true);
+    default:
+        return std::make_unique<Bird>("Tweety", age, 25.0);
+    }
+}
+
+PoolPtr<Animal> createPooled(int kind, int age) {
+    switch (kind) {
+    case 0:
+        return makePooled<Dog>("Rex", age, "Labrador");
+    case 1:
+        return makePooled<Cat>("Luna", age, true);
+    default:
+        return makePooled<Bird>("Tweety", age, 25.0);
+    }
+}
+
+void benchmark(std::size_t operations, std::size_t population) {
+    std::cout << "3. Churn: " << operations << " destroy+create operations on a population of " << population
+              << ":" << std::endl;
+
+    std::size_t newChecksum = 0, poolChecksum = 0;
+    std::size_t before = heapAllocations;
+    double newMs = bench::timeMs([&] {
+        newChecksum = churn<std::unique_ptr<Animal>>(operations, population, 15, createWithNew);
+    });
+    std::size_t newAllocations = heapAllocations - before;
+
+    std::size_t destructorsBefore = animalDestructors;
+    before = heapAllocations;
+    double poolMs = bench::timeMs([&] {
+        poolChecksum = churn<PoolPtr<Animal>>(operations, population, 15, createPooled);
+    });
+    std::size_t poolAllocations = heapAllocations - before;
+    std::size_t destructorsRun = animalDestructors - destructorsBefore;
+
+    std::cout << "  new/delete:        " << std::setw(9) << newMs << " ms, operator new calls " << newAllocations
+              << std::endl;
+    std::cout << "  Pools:             " << std::setw(9) << poolMs << " ms, operator new calls " << poolAllocations
+              << std::endl;
+    printStats("Dog", ObjectPool<Dog>::stats());
+    printStats("Cat", ObjectPool<Cat>::stats());
+    printStats("Bird", ObjectPool<Bird>::stats());
+    std::cout << "  Every pooled animal ran ~Animal: "
+              << (destructorsRun == operations + population ? "Yes" : "No") << std::endl;
+    std::cout << "  Results match: " << (newChecksum == poolChecksum ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+
+    const unsigned threads = 4;
+    std::cout << "4. The same churn on " << threads << " threads (each with its own pools):" << std::endl;
+    auto runThreads = [&](auto&& work) {
+        return bench::timeMs([&] {
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back(work, t);
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        });
+    };
+    newMs = runThreads([&](unsigned t) {
+        churn<std::unique_ptr<Animal>>(operations / threads, population, 16 + t, createWithNew);
+    });
+    poolMs = runThreads([&](unsigned t) {
+        churn<PoolPtr<Animal>>(operations / threads, population, 16 + t, createPooled);
+    });
+    std::cout << "  new/delete: " << newMs << " ms, pools: " << poolMs << " ms" << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Recycling Animal Pools ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstratePool();
+
+    std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t population = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000;
+    benchmark(operations, std::max<std::size_t>(population, 1));
+
+    std::cout << "=== End of Animal Pool Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * A small self-contained benchmark framework
+ *
+ * - Registry::add(name, function, maxSize) registers a benchmark; the
+ *   function receives a State and calls state.run(body) or
+ *   state.run(setup, body) once. Only body is timed; setup runs before
+ *   every call of body (e.g. to restore an input that body sorts in place).
+ * - Every benchmark runs for each input size 10^k in [minSize, maxSize]
+ *   (and at most its own maxSize, for memory-hungry cases)
+ * - Per size: warmup calls, then repetitions until `repetitions` samples
+ *   are taken or the time budget is used up (at least 3 samples). Bodies
+ *   that finish in under a millisecond are called in batches, and a sample
+ *   is the mean of one batch. Without a setup the whole batch is timed
+ *   with one pair of clock reads, so the clock cost is amortized; with a
+ *   setup every call is timed on its own, which adds roughly the cost of
+ *   two clock reads (tens of ns) to every sample.
+ * - The batch size is estimated from the last warmup call, or from the
+ *   first sample when warmup is 0 (that sample is then a cold, unbatched one)
+ * - Results report min, median and p99 (nearest rank) of the samples and
+ *   the median time per item, as a table and optionally as JSON
+ * - doNotOptimize(value) and clobberMemory() keep the compiler from
+ *   deleting work whose result is otherwise unused
+ * - timeMs(func) and bestTimeMs(repetitions, func) are the plain
+ *   wall-clock helpers the performance examples use for one-off timings
+ */
+
+namespace bench {
+
+// Forces `value` to be computed and treated as read by unknown code
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Forces all pending writes to memory to be treated as observable
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+// Wall time of one call of func, in milliseconds
+template <typename Func>
+double timeMs(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Fastest wall time of `repetitions` calls of func, in milliseconds
+template <typename Func>
+double bestTimeMs(int repetitions, Func&& func) {
+    double best = 1e300;
+    for (int rep = 0; rep < repetitions; ++rep) {
+        best = std::min(best, timeMs(func));
+    }
+    return best;
+}
+
+struct Options {
+    std::size_t minSize = 1000;
+    std::size_t maxSize = 1000000;
+    int warmup = 1;
+    int repetitions = 10;
+    double maxSeconds = 1.0;  // Time budget per benchmark and size
+    std::string filter;       // Only run benchmarks whose name contains this
+    std::string jsonPath;     // Write results as JSON here if not empty
+};
+
+struct Result {
+    std::string name;
+    std::size_t size = 0;
+    std::size_t items = 0;  // Items processed by one call of the body
+    int samples = 0;
+    std::size_t batch = 1;  // Body calls per sample
+    double minNs = 0;
+    double medianNs = 0;
+    double p99Ns = 0;
+
+    double nsPerItem() const { return items ? medianNs / static_cast<double>(items) : medianNs; }
+};
+
+class State {
+private:
+    std::size_t n;
+    const Options& options;
+    Result& result;
+
+    static double elapsedNs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template <typename Setup, typename Body>
+    static double timeOnce(Setup& setup, Body& body) {
+        setup();
+        clobberMemory();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        clobberMemory();
+        return elapsedNs(start);
+    }
+
+    // Bodies to run per sample so that a sample takes about a millisecond
+    static std::size_t batchFor(double callNs) {
+        const double targetSampleNs = 1e6;
+        std::size_t batch = callNs >= targetSampleNs ? 1 : static_cast<std::size_t>(targetSampleNs / (callNs + 1));
+        return std::clamp<std::size_t>(batch, 1, 100000);
+    }
+
+    // Collects samples; measureBatch(batch) returns the total time of
+    // `batch` body calls in ns
+    template <typename MeasureBatch>
+    void sample(double warmupNs, MeasureBatch&& measureBatch) {
+        std::size_t batch = warmupNs < 0 ? 1 : batchFor(warmupNs);
+        std::vector<double> samples;
+        auto budgetStart = std::chrono::steady_clock::now();
+        while (static_cast<int>(samples.size()) < options.repetitions) {
+            samples.push_back(measureBatch(batch) / static_cast<double>(batch));
+            if (warmupNs < 0 && samples.size() == 1) {
+                batch = batchFor(samples.front());
+            }
+            if (samples.size() >= 3 && elapsedNs(budgetStart) > options.maxSeconds * 1e9) {
+                break;
+            }
+        }
+
+        std::sort(samples.begin(), samples.end());
+        auto rank = [&](double q) {
+            std::size_t index = static_cast<std::size_t>(q * static_cast<double>(samples.size()) + 0.999999);
+            return samples[std::clamp<std::size_t>(index, 1, samples.size()) - 1];
+        };
+        result.samples = static_cast<int>(samples.size());
+        result.batch = batch;
+        result.minNs = samples.front();
+        result.medianNs = rank(0.5);
+        result.p99Ns = rank(0.99);
+    }
+
+    // Runs the warmup calls; returns the time of the last one, or -1 if
+    // warmup is disabled
+    template <typename Setup, typename Body>
+    double warmUp(Setup& setup, Body& body) {
+        double warmupNs = -1;
+        for (int i = 0; i < options.warmup; ++i) {
+            warmupNs = timeOnce(setup, body);
+        }
+        return warmupNs;
+    }
+
+public:
+    State(std::size_t size, const Options& runOptions, Result& runResult)
+        : n(size), options(runOptions), result(runResult) {
+        result.items = size;
+    }
+
+    std::size_t size() const { return n; }
+
+    // Items one call of the body processes (default: size()), for ns/item
+    void setItems(std::size_t items) { result.items = items; }
+
+    // Times body in batches with one pair of clock reads per batch
+    template <typename Body>
+    void run(Body&& body) {
+        auto noSetup = [] {};
+        double warmupNs = warmUp(noSetup, body);
+        sample(warmupNs, [&](std::size_t batch) {
+            clobberMemory();
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < batch; ++i) {
+                body();
+                clobberMemory();
+            }
+            return elapsedNs(start);
+        });
+    }
+
+    // Runs setup before every call of body and times each call on its own
+    template <typename Setup, typename Body>
+    void run(Setup&& setup, Body&& body) {
+        double warmupNs = warmUp(setup, body);
+        sample(warmupNs, [&](std::size_t batch) {
+            double total = 0;
+            for (std::size_t i = 0; i < batch; ++i) {
+                total += timeOnce(setup, body);
+            }
+            return total;
+        });
+    }
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(State&)> function;
+    std::size_t maxSize;
+};
+
+class Registry {
+private:
+    std::vector<Benchmark> benchmarks;
+
+public:
+    void add(const std::string& name, std::function<void(State&)> function, std::size_t maxSize = 100000000) {
+        benchmarks.push_back({name, std::move(function), maxSize});
+    }
+
+    std::size_t count() const { return benchmarks.size(); }
+
+    // Runs every matching benchmark for every size; `report` is called
+    // after each result so long runs show progress
+    template <typename Report>
+    std::vector<Result> runAll(const Options& options, Report&& report) const {
+        std::vector<Result> results;
+        for (const Benchmark& benchmark : benchmarks) {
+            if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            for (std::size_t n = options.minSize; n <= std::min(options.maxSize, benchmark.maxSize); n *= 10) {
+                Result result;
+                result.name = benchmark.name;
+                result.size = n;
+                State state(n, options, result);
+                benchmark.function(state);
+                report(result);
+                results.push_back(result);
+            }
+        }
+        return results;
+    }
+};
+
+inline void printHeader(std::ostream& out) {
+    out << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(11) << "n" << std::setw(8)
+        << "samples" << std::setw(13) << "min (us)" << std::setw(13) << "median (us)" << std::setw(13) << "p99 (us)"
+        << std::setw(12) << "ns/item" << std::endl;
+}
+
+inline void printResult(std::ostream& out, const Result& result) {
+    out << std::left << std::setw(40) << result.name << std::right << std::setw(11) << result.size << std::setw(8)
+        << result.samples << std::fixed << std::setprecision(2) << std::setw(13) << result.minNs / 1000
+        << std::setw(13) << result.medianNs / 1000 << std::setw(13) << result.p99Ns / 1000 << std::setw(12)
+        << result.nsPerItem() << std::defaultfloat << std::setprecision(6) << std::endl;
+}
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+inline void writeJson(const std::string& path, const Options& options, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    out << std::setprecision(10);
+    out << "{\n  \"context\": {\"threads\": " << std::thread::hardware_concurrency()
+        << ", \"min_size\": " << options.minSize << ", \"max_size\": " << options.maxSize
+        << ", \"warmup\": " << options.warmup << ", \"repetitions\": " << options.repetitions
+        << ", \"max_seconds\": " << options.maxSeconds << "},\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"size\": " << r.size
+            << ", \"items\": " << r.items << ", \"samples\": " << r.samples << ", \"batch\": " << r.batch
+            << ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs << ", \"p99_ns\": " << r.p99Ns
+            << ", \"ns_per_item\": " << r.nsPerItem() << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Parses --min-size, --max-size, --warmup, --repetitions, --max-seconds,
+// --filter and --json (each followed by a value)
+inline Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + flag);
+        }
+        const char* value = argv[++i];
+        if (flag == "--min-size") {
+            options.minSize = std::max<std::size_t>(1, std::strtoull(value, nullptr, 10));
+        } else if (flag == "--max-size") {
+            options.maxSize = std::strtoull(value, nullptr, 10);
+        } else if (flag == "--warmup") {
+            options.warmup = std::max(0, std::atoi(value));
+        } else if (flag == "--repetitions") {
+            options.repetitions = std::max(1, std::atoi(value));
+        } else if (flag == "--max-seconds") {
+            options.maxSeconds = std::atof(value);
+        } else if (flag == "--filter") {
+            options.filter = value;
+        } else if (flag == "--json") {
+            options.jsonPath = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + flag);
+        }
+    }
+    return options;
+}
+
+}  // namespace bench
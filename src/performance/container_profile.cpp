@@ -0,0 +1,306 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include "perf_counters.h"
+#include "bench.h"
+
+/**
+ * Hardware Counter Profiles of Container Workloads
+ *
+ * This example demonstrates:
+ * - The insert/iterate/erase patterns of demonstrateVector, demonstrateList
+ *   and demonstrateDeque in containers.cpp, scaled from a handful of
+ *   elements to realistic sizes
+ * - Wrapping each pattern with perf_event_open counters (perf_counters.h):
+ *   instructions, cycles, cache misses and branch misses per operation
+ * - Why std::list iteration depends on where its nodes live: the same
+ *   list traversed in allocation order and after list::sort relinked it
+ * - A table and JSON output; without counters (VMs, containers,
+ *   perf_event_paranoid) only the time per operation is reported
+ *
+ * Usage: ./perf_container_profile [elementCount] [jsonFile]
+ *        (default: 1000000, no JSON)
+ */
+
+// ---------------------------------------------------------------------------
+// Profiling
+// ---------------------------------------------------------------------------
+
+struct Profile {
+    std::string container;
+    std::string pattern;
+    std::size_t elements = 0;  // Container size the pattern works on
+    std::size_t operations = 0;
+    double ns = 0;
+    CounterValues counters;
+
+    double perOperation(long long value) const {
+        return static_cast<double>(value) / static_cast<double>(operations);
+    }
+};
+
+class Profiler {
+private:
+    HardwareCounters counters;
+    std::vector<Profile> profiles;
+
+public:
+    bool countersAvailable() const { return counters.available(); }
+    const std::vector<Profile>& results() const { return profiles; }
+
+    // Runs setup() and body() once to warm up the heap and caches, then
+    // setup() untimed again and counts and times body(), which performs
+    // `operations` operations on a container of `elements` elements
+    template <typename Setup, typename Body>
+    void profile(const std::string& container, const std::string& pattern, std::size_t elements,
+                 std::size_t operations, Setup&& setup, Body&& body) {
+        setup();
+        body();
+        setup();
+        bench::clobberMemory();
+        counters.start();
+        double ms = bench::timeMs([&] {
+            body();
+            bench::clobberMemory();
+        });
+        CounterValues values = counters.stop();
+        profiles.push_back({container, pattern, elements, operations, ms * 1e6, values});
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Workloads: every pattern of containers.cpp, for each container that has it
+// ---------------------------------------------------------------------------
+
+std::vector<int> randomValues(std::size_t n) {
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> value(0, 1000000);
+    std::vector<int> values(n);
+    for (int& v : values) {
+        v = value(rng);
+    }
+    return values;
+}
+
+// push_back, push_front, insert in the middle, iterate, remove and pop for
+// one sequence container
+template <typename Container>
+void profileSequence(Profiler& profiler, const std::string& name, const std::vector<int>& values,
+                     std::size_t middleInserts) {
+    constexpr bool isVector = std::is_same_v<Container, std::vector<int>>;
+    const std::size_t n = values.size();
+    Container container;
+
+    profiler.profile(
+        name, "push_back", n, n, [&] { container = Container(); },
+        [&] {
+            for (int v : values) {
+                container.push_back(v);
+            }
+            bench::doNotOptimize(container.size());
+        });
+
+    if constexpr (!isVector) {
+        profiler.profile(
+            name, "push_front", n, n, [&] { container = Container(); },
+            [&] {
+                for (int v : values) {
+                    container.push_front(v);
+                }
+                bench::doNotOptimize(container.size());
+            });
+    }
+
+    // Like myList.insert(++myList.begin(), 10), at the middle of a full container
+    typename Container::iterator middle;
+    profiler.profile(
+        name, "insert_middle", n, middleInserts,
+        [&] {
+            container.assign(values.begin(), values.end());
+            middle = std::next(container.begin(), static_cast<std::ptrdiff_t>(n / 2));
+        },
+        [&] {
+            for (std::size_t i = 0; i < middleInserts; ++i) {
+                if constexpr (std::is_same_v<Container, std::list<int>>) {
+                    container.insert(middle, static_cast<int>(i));  // list iterators stay valid
+                } else {
+                    container.insert(container.begin() + static_cast<std::ptrdiff_t>(container.size() / 2),
+                                     static_cast<int>(i));
+                }
+            }
+            bench::doNotOptimize(container.size());
+        });
+
+    profiler.profile(
+        name, "iterate", n, n, [&] { container.assign(values.begin(), values.end()); },
+        [&] {
+            long long sum = 0;
+            for (int v : container) {
+                sum += v;
+            }
+            bench::doNotOptimize(sum);
+        });
+
+    // Like myList.remove(3): drop every element with a given property
+    profiler.profile(
+        name, "remove_if", n, n, [&] { container.assign(values.begin(), values.end()); },
+        [&] {
+            auto isOdd = [](int v) { return v % 2 != 0; };
+            if constexpr (std::is_same_v<Container, std::list<int>>) {
+                container.remove_if(isOdd);
+            } else {
+                container.erase(std::remove_if(container.begin(), container.end(), isOdd), container.end());
+            }
+            bench::doNotOptimize(container.size());
+        });
+
+    profiler.profile(
+        name, isVector ? "pop_back" : "pop_front", n, n, [&] { container.assign(values.begin(), values.end()); },
+        [&] {
+            // Read each element before removing it, as a consumer would; this
+            // also keeps the loop from folding into a single size reset
+            while (!container.empty()) {
+                if constexpr (isVector) {
+                    bench::doNotOptimize(container.back());
+                    container.pop_back();
+                } else {
+                    bench::doNotOptimize(container.front());
+                    container.pop_front();
+                }
+            }
+            bench::doNotOptimize(container.size());
+        });
+}
+
+void profileScatteredList(Profiler& profiler, const std::vector<int>& values) {
+    std::list<int> list;
+    profiler.profile(
+        "std::list", "iterate_scattered", values.size(), values.size(),
+        [&] {
+            // list::sort relinks the nodes without moving them, so walking
+            // the list in value order jumps around the heap
+            list.assign(values.begin(), values.end());
+            list.sort();
+        },
+        [&] {
+            long long sum = 0;
+            for (int v : list) {
+                sum += v;
+            }
+            bench::doNotOptimize(sum);
+        });
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+// ---------------------------------------------------------------------------
+
+void printCounter(const Profile& profile, CounterKind kind, int width) {
+    if (profile.counters.has(kind)) {
+        std::cout << std::setw(width) << profile.perOperation(profile.counters[kind]);
+    } else {
+        std::cout << std::setw(width) << "n/a";
+    }
+}
+
+void printTable(const std::vector<Profile>& profiles) {
+    std::cout << "  " << std::left << std::setw(13) << "Container" << std::setw(19) << "Pattern" << std::right
+              << std::setw(10) << "ops" << std::setw(12) << "ns/op" << std::setw(11) << "instr/op" << std::setw(11)
+              << "cycles/op" << std::setw(15) << "cache-miss/op" << std::setw(16) << "branch-miss/op" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const Profile& profile : profiles) {
+        std::cout << "  " << std::left << std::setw(13) << profile.container << std::setw(19) << profile.pattern
+                  << std::right << std::setw(10) << profile.operations << std::setw(12)
+                  << profile.ns / static_cast<double>(profile.operations);
+        printCounter(profile, CounterKind::Instructions, 11);
+        printCounter(profile, CounterKind::Cycles, 11);
+        printCounter(profile, CounterKind::CacheMisses, 15);
+        printCounter(profile, CounterKind::BranchMisses, 16);
+        std::cout << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+void writeJson(const std::string& path, const std::vector<Profile>& profiles, bool countersAvailable) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    auto counter = [&](const Profile& profile, CounterKind kind) {
+        if (profile.counters.has(kind)) {
+            out << profile.perOperation(profile.counters[kind]);
+        } else {
+            out << "null";
+        }
+    };
+    out << std::setprecision(10);
+    out << "{\n  \"counters_available\": " << (countersAvailable ? "true" : "false") << ",\n  \"profiles\": [";
+    for (std::size_t i = 0; i < profiles.size(); ++i) {
+        const Profile& p = profiles[i];
+        out << (i ? ",\n" : "\n") << "    {\"container\": \"" << bench::jsonEscape(p.container) << "\", \"pattern\": \""
+            << bench::jsonEscape(p.pattern) << "\", \"elements\": " << p.elements
+            << ", \"operations\": " << p.operations
+            << ", \"ns_per_op\": " << p.ns / static_cast<double>(p.operations) << ", \"instructions_per_op\": ";
+        counter(p, CounterKind::Instructions);
+        out << ", \"cycles_per_op\": ";
+        counter(p, CounterKind::Cycles);
+        out << ", \"cache_misses_per_op\": ";
+        counter(p, CounterKind::CacheMisses);
+        out << ", \"branch_misses_per_op\": ";
+        counter(p, CounterKind::BranchMisses);
+        out << ", \"counter_running_fraction\": " << p.counters.runningFraction << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Container Workload Profiles ===" << std::endl;
+    std::cout << std::endl;
+
+    std::size_t count = argc > 1 ? std::max<std::size_t>(std::strtoull(argv[1], nullptr, 10), 2) : 1000000;
+    std::string jsonPath = argc > 2 ? argv[2] : "";
+    std::vector<int> values = randomValues(count);
+    std::size_t middleInserts = std::min<std::size_t>(count, 1000);
+
+    Profiler profiler;
+    profileSequence<std::vector<int>>(profiler, "std::vector", values, middleInserts);
+    profileSequence<std::list<int>>(profiler, "std::list", values, middleInserts);
+    profileScatteredList(profiler, values);
+    profileSequence<std::deque<int>>(profiler, "std::deque", values, middleInserts);
+
+    std::cout << "1. Per-operation costs with " << count << " elements (insert_middle: " << middleInserts
+              << " inserts):" << std::endl;
+    printTable(profiler.results());
+    if (!profiler.countersAvailable()) {
+        std::cout << "  (Hardware counters unavailable here, timing only; see /proc/sys/kernel/perf_event_paranoid)"
+                  << std::endl;
+    }
+    double leastRunning = 1.0;
+    for (const Profile& profile : profiler.results()) {
+        leastRunning = std::min(leastRunning, profile.counters.runningFraction);
+    }
+    if (leastRunning < 1.0) {
+        std::cout << "  (The PMU was multiplexed: counters ran for as little as " << leastRunning * 100
+                  << "% of a workload and were scaled up)" << std::endl;
+    }
+    if (!jsonPath.empty()) {
+        writeJson(jsonPath, profiler.results(), profiler.countersAvailable());
+        std::cout << "  Wrote " << profiler.results().size() << " profiles to " << jsonPath << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "=== End of Container Profile Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,536 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <set>
+#include <map>
+#include <unordered_set>
+#include <unordered_map>
+#include <queue>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <functional>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include "bench.h"
+#include "small_vector.h"
+
+/**
+ * cpp_bench: Benchmarks for the Operations the Learning Modules Demonstrate
+ *
+ * Uses the framework in bench.h (warmup, repetitions, min/median/p99,
+ * doNotOptimize/clobberMemory, JSON output). Benchmark groups:
+ * - containers/  insert and lookup in the containers of containers.cpp
+ * - algorithms/  sort, search, set, heap and numeric algorithms from
+ *                algorithms.cpp
+ * - polymorphism/ virtual getArea() calls on the Shape hierarchy
+ * - classes/     constructing, copying and moving a stand-in for the
+ *                Student of classes.cpp (same members: SmallVector grades,
+ *                noexcept moves), without its lifecycle logging and
+ *                instance counter, since classes.cpp is a standalone program
+ *
+ * Every benchmark runs for input sizes 10^k between --min-size and
+ * --max-size (1e3 to 1e8 supported; node-based containers and object
+ * collections stop at 1e7 to stay within memory).
+ *
+ * Usage: ./cpp_bench [--min-size N] [--max-size N] [--warmup N]
+ *                    [--repetitions N] [--max-seconds S] [--filter TEXT]
+ *                    [--json FILE]
+ *        (default: sizes 1e3 to 1e6, 1 warmup, 10 repetitions, 1 s budget)
+ */
+
+// ---------------------------------------------------------------------------
+// Inputs
+// ---------------------------------------------------------------------------
+
+constexpr std::size_t nodeLimit = 10000000;  // Largest size for node/object-heavy cases
+
+// n distinct keys in random order
+std::vector<int> shuffledKeys(std::size_t n, std::uint32_t seed = 1) {
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+    return keys;
+}
+
+std::vector<int> randomValues(std::size_t n, std::uint32_t seed = 2) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> value(0, 1000000000);
+    std::vector<int> values(n);
+    for (int& v : values) {
+        v = value(rng);
+    }
+    return values;
+}
+
+// ---------------------------------------------------------------------------
+// containers.cpp: insert and lookup
+// ---------------------------------------------------------------------------
+
+// n insertions into an empty container, through `insert(container, key)`
+template <typename Container, typename Insert>
+void benchmarkInsert(bench::State& state, Insert insert) {
+    std::vector<int> keys = shuffledKeys(state.size());
+    std::unique_ptr<Container> container;
+    state.run([&] { container = std::make_unique<Container>(); },
+              [&] {
+                  for (int key : keys) {
+                      insert(*container, key);
+                  }
+                  bench::doNotOptimize(container->size());
+              });
+}
+
+// n successful lookups in a container holding n keys
+template <typename Container, typename Find>
+void benchmarkLookup(bench::State& state, Container container, Find find) {
+    std::vector<int> probes = shuffledKeys(state.size(), 3);
+    state.run([&] {
+        std::size_t found = 0;
+        for (int key : probes) {
+            found += find(container, key);
+        }
+        bench::doNotOptimize(found);
+    });
+}
+
+void registerContainerBenchmarks(bench::Registry& registry) {
+    registry.add("containers/vector_push_back", [](bench::State& state) {
+        benchmarkInsert<std::vector<int>>(state, [](auto& c, int key) { c.push_back(key); });
+    });
+    registry.add("containers/deque_push_back", [](bench::State& state) {
+        benchmarkInsert<std::deque<int>>(state, [](auto& c, int key) { c.push_back(key); });
+    });
+    registry.add(
+        "containers/list_push_back",
+        [](bench::State& state) { benchmarkInsert<std::list<int>>(state, [](auto& c, int key) { c.push_back(key); }); },
+        nodeLimit);
+    registry.add(
+        "containers/set_insert",
+        [](bench::State& state) { benchmarkInsert<std::set<int>>(state, [](auto& c, int key) { c.insert(key); }); },
+        nodeLimit);
+    registry.add(
+        "containers/map_insert",
+        [](bench::State& state) {
+            benchmarkInsert<std::map<int, int>>(state, [](auto& c, int key) { c[key] = key; });
+        },
+        nodeLimit);
+    registry.add(
+        "containers/unordered_set_insert",
+        [](bench::State& state) {
+            benchmarkInsert<std::unordered_set<int>>(state, [](auto& c, int key) { c.insert(key); });
+        },
+        nodeLimit);
+    registry.add(
+        "containers/unordered_map_insert",
+        [](bench::State& state) {
+            benchmarkInsert<std::unordered_map<int, int>>(state, [](auto& c, int key) { c[key] = key; });
+        },
+        nodeLimit);
+    registry.add(
+        "containers/priority_queue_push_pop",
+        [](bench::State& state) {
+            std::vector<int> keys = shuffledKeys(state.size());
+            state.run([&] {
+                std::priority_queue<int> queue;
+                for (int key : keys) {
+                    queue.push(key);
+                }
+                long long sum = 0;
+                while (!queue.empty()) {
+                    sum += queue.top();
+                    queue.pop();
+                }
+                bench::doNotOptimize(sum);
+            });
+        });
+
+    registry.add("containers/sorted_vector_lookup", [](bench::State& state) {
+        std::vector<int> sorted(state.size());
+        std::iota(sorted.begin(), sorted.end(), 0);
+        benchmarkLookup(state, std::move(sorted),
+                        [](const auto& c, int key) { return std::binary_search(c.begin(), c.end(), key); });
+    });
+    registry.add(
+        "containers/set_find",
+        [](bench::State& state) {
+            std::vector<int> keys = shuffledKeys(state.size());
+            benchmarkLookup(state, std::set<int>(keys.begin(), keys.end()),
+                            [](const auto& c, int key) { return c.find(key) != c.end(); });
+        },
+        nodeLimit);
+    registry.add(
+        "containers/map_find",
+        [](bench::State& state) {
+            std::map<int, int> map;
+            for (int key : shuffledKeys(state.size())) {
+                map[key] = key;
+            }
+            benchmarkLookup(state, std::move(map), [](const auto& c, int key) { return c.find(key) != c.end(); });
+        },
+        nodeLimit);
+    registry.add(
+        "containers/unordered_set_find",
+        [](bench::State& state) {
+            std::vector<int> keys = shuffledKeys(state.size());
+            benchmarkLookup(state, std::unordered_set<int>(keys.begin(), keys.end()),
+                            [](const auto& c, int key) { return c.find(key) != c.end(); });
+        },
+        nodeLimit);
+    registry.add(
+        "containers/unordered_map_find",
+        [](bench::State& state) {
+            std::unordered_map<int, int> map;
+            for (int key : shuffledKeys(state.size())) {
+                map[key] = key;
+            }
+            benchmarkLookup(state, std::move(map), [](const auto& c, int key) { return c.find(key) != c.end(); });
+        },
+        nodeLimit);
+}
+
+// ---------------------------------------------------------------------------
+// algorithms.cpp: sort, search, set, heap and numeric operations
+// ---------------------------------------------------------------------------
+
+// Runs `algorithm(work)` on a fresh copy of random input each time
+template <typename Algorithm>
+void benchmarkOnCopy(bench::State& state, Algorithm algorithm) {
+    std::vector<int> input = randomValues(state.size());
+    std::vector<int> work;
+    state.run([&] { work = input; },
+              [&] {
+                  algorithm(work);
+                  bench::clobberMemory();
+              });
+}
+
+void registerAlgorithmBenchmarks(bench::Registry& registry) {
+    registry.add("algorithms/sort", [](bench::State& state) {
+        benchmarkOnCopy(state, [](std::vector<int>& v) { std::sort(v.begin(), v.end()); });
+    });
+    registry.add("algorithms/partial_sort_10pct", [](bench::State& state) {
+        benchmarkOnCopy(state, [](std::vector<int>& v) {
+            std::partial_sort(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(v.size() / 10), v.end());
+        });
+    });
+    registry.add("algorithms/nth_element", [](bench::State& state) {
+        benchmarkOnCopy(state, [](std::vector<int>& v) {
+            std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(v.size() / 2), v.end());
+        });
+    });
+    registry.add("algorithms/reverse", [](bench::State& state) {
+        // Any order is valid input, so no per-call copy: the batch is timed as a whole
+        std::vector<int> values = randomValues(state.size());
+        state.run([&] {
+            std::reverse(values.begin(), values.end());
+            bench::clobberMemory();
+        });
+    });
+    registry.add("algorithms/make_heap", [](bench::State& state) {
+        benchmarkOnCopy(state, [](std::vector<int>& v) { std::make_heap(v.begin(), v.end()); });
+    });
+    registry.add("algorithms/heap_sort", [](bench::State& state) {
+        // make_heap once, then pop_heap every element, as with push_heap/pop_heap in algorithms.cpp
+        benchmarkOnCopy(state, [](std::vector<int>& v) {
+            std::make_heap(v.begin(), v.end());
+            for (auto end = v.end(); end != v.begin(); --end) {
+                std::pop_heap(v.begin(), end);
+            }
+        });
+    });
+
+    registry.add("algorithms/find_missing", [](bench::State& state) {
+        std::vector<int> values = randomValues(state.size());
+        state.run([&] { bench::doNotOptimize(std::find(values.begin(), values.end(), -1)); });
+    });
+    registry.add("algorithms/count_if", [](bench::State& state) {
+        std::vector<int> values = randomValues(state.size());
+        state.run([&] {
+            bench::doNotOptimize(std::count_if(values.begin(), values.end(), [](int v) { return v % 2 == 0; }));
+        });
+    });
+    registry.add("algorithms/lower_bound", [](bench::State& state) {
+        std::vector<int> sorted = randomValues(state.size());
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<int> probes = randomValues(state.size(), 4);
+        state.run([&] {
+            long long sum = 0;
+            for (int probe : probes) {
+                sum += std::lower_bound(sorted.begin(), sorted.end(), probe) - sorted.begin();
+            }
+            bench::doNotOptimize(sum);
+        });
+    });
+
+    auto setOperation = [](auto operation) {
+        return [operation](bench::State& state) {
+            std::vector<int> a = randomValues(state.size(), 5);
+            std::vector<int> b = randomValues(state.size(), 6);
+            std::sort(a.begin(), a.end());
+            std::sort(b.begin(), b.end());
+            std::vector<int> out;
+            out.reserve(2 * state.size());
+            state.setItems(2 * state.size());
+            state.run([&] { out.clear(); },
+                      [&] {
+                          operation(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+                          bench::doNotOptimize(out.data());
+                      });
+        };
+    };
+    registry.add("algorithms/set_union", setOperation([](auto... args) { std::set_union(args...); }));
+    registry.add("algorithms/set_intersection", setOperation([](auto... args) { std::set_intersection(args...); }));
+    registry.add("algorithms/set_difference", setOperation([](auto... args) { std::set_difference(args...); }));
+
+    registry.add("algorithms/accumulate", [](bench::State& state) {
+        std::vector<int> values = randomValues(state.size());
+        state.run([&] { bench::doNotOptimize(std::accumulate(values.begin(), values.end(), 0LL)); });
+    });
+    registry.add("algorithms/inner_product", [](bench::State& state) {
+        std::vector<int> a = randomValues(state.size(), 7);
+        std::vector<int> b = randomValues(state.size(), 8);
+        state.run([&] { bench::doNotOptimize(std::inner_product(a.begin(), a.end(), b.begin(), 0LL)); });
+    });
+    registry.add("algorithms/partial_sum", [](bench::State& state) {
+        std::vector<int> values = randomValues(state.size());
+        std::vector<long long> sums(state.size());
+        state.run([&] {
+            std::partial_sum(values.begin(), values.end(), sums.begin());
+            bench::doNotOptimize(sums.data());
+        });
+    });
+    registry.add("algorithms/transform", [](bench::State& state) {
+        std::vector<int> values = randomValues(state.size());
+        std::vector<int> squares(state.size());
+        state.run([&] {
+            std::transform(values.begin(), values.end(), squares.begin(), [](int v) { return v * 2 + 1; });
+            bench::doNotOptimize(squares.data());
+        });
+    });
+}
+
+// ---------------------------------------------------------------------------
+// polymorphism.cpp: virtual dispatch on the Shape hierarchy
+// ---------------------------------------------------------------------------
+
+class Shape {
+public:
+    virtual ~Shape() = default;
+    virtual double getArea() const = 0;
+};
+
+class Circle : public Shape {
+private:
+    double radius;
+
+public:
+    explicit Circle(double r) : radius(r) {}
+    double getArea() const override { return 3.14159 * radius * radius; }
+};
+
+class Rectangle : public Shape {
+private:
+    double width, height;
+
+public:
+    Rectangle(double w, double h) : width(w), height(h) {}
+    double getArea() const override { return width * height; }
+};
+
+class Triangle : public Shape {
+private:
+    double base, height;
+
+public:
+    Triangle(double b, double h) : base(b), height(h) {}
+    double getArea() const override { return 0.5 * base * height; }
+};
+
+std::vector<std::unique_ptr<Shape>> makeShapes(std::size_t n, bool shuffled) {
+    std::vector<std::unique_ptr<Shape>> shapes;
+    shapes.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        double size = 1.0 + static_cast<double>(i % 10);
+        std::size_t kind = shuffled ? i % 3 : 3 * i / n;
+        if (kind == 0) {
+            shapes.push_back(std::make_unique<Circle>(size));
+        } else if (kind == 1) {
+            shapes.push_back(std::make_unique<Rectangle>(size, size + 1));
+        } else {
+            shapes.push_back(std::make_unique<Triangle>(size, size + 2));
+        }
+    }
+    if (shuffled) {
+        std::shuffle(shapes.begin(), shapes.end(), std::mt19937(9));
+    }
+    return shapes;
+}
+
+void registerPolymorphismBenchmarks(bench::Registry& registry) {
+    auto totalArea = [](bool shuffled) {
+        return [shuffled](bench::State& state) {
+            std::vector<std::unique_ptr<Shape>> shapes = makeShapes(state.size(), shuffled);
+            state.run([&] {
+                double total = 0;
+                for (const auto& shape : shapes) {
+                    total += shape->getArea();
+                }
+                bench::doNotOptimize(total);
+            });
+        };
+    };
+    registry.add("polymorphism/virtual_area_mixed", totalArea(true), nodeLimit);
+    registry.add("polymorphism/virtual_area_grouped", totalArea(false), nodeLimit);
+
+    // The same computation without virtual calls, for comparison
+    registry.add("polymorphism/direct_area_switch", [](bench::State& state) {
+        struct PlainShape {
+            int kind;
+            double a, b;
+        };
+        std::vector<PlainShape> shapes(state.size());
+        for (std::size_t i = 0; i < shapes.size(); ++i) {
+            double size = 1.0 + static_cast<double>(i % 10);
+            int kind = static_cast<int>(i % 3);
+            shapes[i] = {kind, size, size + (kind == 1 ? 1 : 2)};
+        }
+        std::shuffle(shapes.begin(), shapes.end(), std::mt19937(9));
+        state.run([&] {
+            double total = 0;
+            for (const PlainShape& shape : shapes) {
+                switch (shape.kind) {
+                case 0:
+                    total += 3.14159 * shape.a * shape.a;
+                    break;
+                case 1:
+                    total += shape.a * shape.b;
+                    break;
+                default:
+                    total += 0.5 * shape.a * shape.b;
+                    break;
+                }
+            }
+            bench::doNotOptimize(total);
+        });
+    });
+}
+
+// ---------------------------------------------------------------------------
+// classes.cpp: object construction, copy and move
+//
+// Student is a stand-in with the data members and move operations of the
+// Student in classes.cpp, minus its lifecycle logging and instance counter,
+// so the numbers show the cost of the object itself.
+// ---------------------------------------------------------------------------
+
+class Student {
+private:
+    std::string name;
+    int age;
+    SmallVector<double, 8> grades;
+
+public:
+    Student(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+    Student(const Student&) = default;
+    Student(Student&&) noexcept = default;
+    Student& operator=(const Student&) = default;
+    Student& operator=(Student&&) noexcept = default;
+    void addGrade(double grade) {
+        if (grade >= 0 && grade <= 100) {
+            grades.push_back(grade);
+        }
+    }
+    int getAge() const { return age; }
+};
+
+std::vector<Student> makeStudents(std::size_t n) {
+    std::vector<Student> students;
+    students.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        students.emplace_back("Student with a long name", 18 + static_cast<int>(i % 10));
+        students.back().addGrade(85.5);
+        students.back().addGrade(92.0);
+    }
+    return students;
+}
+
+void registerClassBenchmarks(bench::Registry& registry) {
+    registry.add(
+        "classes/student_construct",
+        [](bench::State& state) {
+            std::vector<Student> students;
+            state.run([&] { students = {}; },
+                      [&] {
+                          students = makeStudents(state.size());
+                          bench::doNotOptimize(students.data());
+                      });
+        },
+        nodeLimit);
+    registry.add(
+        "classes/student_copy",
+        [](bench::State& state) {
+            std::vector<Student> original = makeStudents(state.size());
+            std::vector<Student> copy;
+            state.run([&] { copy = {}; },
+                      [&] {
+                          copy = original;
+                          bench::doNotOptimize(copy.data());
+                      });
+        },
+        nodeLimit);
+    registry.add(
+        "classes/student_move",
+        [](bench::State& state) {
+            std::vector<Student> source;
+            std::vector<Student> moved;
+            state.run(
+                [&] {
+                    source = makeStudents(state.size());
+                    moved = {};
+                    moved.reserve(state.size());
+                },
+                [&] {
+                    for (Student& student : source) {
+                        moved.push_back(std::move(student));
+                    }
+                    bench::doNotOptimize(moved.data());
+                });
+        },
+        nodeLimit);
+}
+
+int main(int argc, char* argv[]) {
+    bench::Options options;
+    try {
+        options = bench::parseOptions(argc, argv);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    bench::Registry registry;
+    registerContainerBenchmarks(registry);
+    registerAlgorithmBenchmarks(registry);
+    registerPolymorphismBenchmarks(registry);
+    registerClassBenchmarks(registry);
+
+    std::cout << "=== cpp_bench: " << registry.count() << " benchmarks, sizes " << options.minSize << " to "
+              << options.maxSize << " ===" << std::endl;
+    std::cout << std::endl;
+
+    bench::printHeader(std::cout);
+    std::vector<bench::Result> results =
+        registry.runAll(options, [](const bench::Result& result) { bench::printResult(std::cout, result); });
+
+    if (!options.jsonPath.empty()) {
+        bench::writeJson(options.jsonPath, options, results);
+        std::cout << std::endl << "Wrote " << results.size() << " results to " << options.jsonPath << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,269 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "flat_hash_map.h"
+#include "bench.h"
+
+/**
+ * Flat Hash Map for the Price Lookups
+ *
+ * This example demonstrates:
+ * - FlatHashMap/FlatHashSet (flat_hash_map.h) running the unordered_set /
+ *   unordered_map code of demonstrateUnorderedContainers unchanged
+ * - Heterogeneous lookup: finding std::string keys by std::string_view
+ *   without building (and allocating) a std::string per lookup
+ * - Tombstone-free deletion: after many rounds of erase/insert churn the
+ *   table has the same capacity and lookup speed as a fresh one
+ * - A benchmark against std::unordered_map<std::string, double> for hits,
+ *   misses, inserts and erases at 1e6 entries and up
+ *
+ * Usage: ./perf_flat_hash_map [maxEntries]   (default: 1000000)
+ *        Sizes run from 1e6 up to maxEntries in powers of ten. 1e8 entries
+ *        need about 8 GB for std::unordered_map and 6 GB for FlatHashMap.
+ */
+
+static std::size_t heapAllocations = 0;
+
+void* operator new(std::size_t size) {
+    ++heapAllocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+// Price keys "item-<n>" fit the small-string buffer, like "banana" does
+class KeyBuffer {
+private:
+    char text[24];
+
+public:
+    std::string_view make(const char* prefix, std::size_t number) {
+        std::size_t length = std::char_traits<char>::length(prefix);
+        std::copy(prefix, prefix + length, text);
+        char* end = std::to_chars(text + length, text + sizeof(text), number).ptr;
+        return std::string_view(text, static_cast<std::size_t>(end - text));
+    }
+};
+
+// Visits 0..n-1 in a scattered order: step is coprime with every 10^k
+std::size_t scattered(std::size_t i, std::size_t n) {
+    return static_cast<std::size_t>(static_cast<std::uint64_t>(i) * 1000003 % n);
+}
+
+// ---------------------------------------------------------------------------
+// Demonstrations
+// ---------------------------------------------------------------------------
+
+void demonstrateDropIn() {
+    std::cout << "1. demonstrateUnorderedContainers with the flat tables:" << std::endl;
+
+    FlatHashSet<std::string> fruits = {"apple", "banana", "orange"};
+    fruits.insert("grape");
+
+    std::cout << "  Flat set fruits: ";
+    for (const auto& fruit : fruits) {
+        std::cout << fruit << " ";
+    }
+    std::cout << std::endl;
+
+    FlatHashMap<std::string, double> prices;
+    prices["apple"] = 1.50;
+    prices["banana"] = 0.80;
+    prices["orange"] = 2.00;
+
+    std::cout << "  Flat map prices:" << std::endl;
+    for (const auto& pair : prices) {
+        std::cout << "    " << pair.first << ": $" << pair.second << std::endl;
+    }
+    std::cout << "  " << prices.size() << " entries in " << prices.capacity() << " slots, banana "
+              << (prices.contains("banana") ? "found" : "missing") << ", kiwi "
+              << (prices.contains("kiwi") ? "found" : "missing") << std::endl;
+    std::cout << std::endl;
+}
+
+void demonstrateHeterogeneousLookup() {
+    std::cout << "2. Looking up std::string keys by std::string_view:" << std::endl;
+
+    // Long product names do not fit the small-string buffer
+    const std::size_t products = 100000;
+    std::unordered_map<std::string, double> standard;
+    FlatHashMap<std::string, double> flat;
+    KeyBuffer buffer;
+    for (std::size_t i = 0; i < products; ++i) {
+        std::string name(buffer.make("catalogue/product-", i));
+        standard[name] = static_cast<double>(i);
+        flat[name] = static_cast<double>(i);
+    }
+
+    double standardSum = 0, flatSum = 0;
+    std::size_t before = heapAllocations;
+    for (std::size_t i = 0; i < products; ++i) {
+        std::string_view name = buffer.make("catalogue/product-", scattered(i, products));
+        standardSum += standard.find(std::string(name))->second;
+    }
+    std::size_t standardAllocations = heapAllocations - before;
+
+    before = heapAllocations;
+    for (std::size_t i = 0; i < products; ++i) {
+        std::string_view name = buffer.make("catalogue/product-", scattered(i, products));
+        flatSum += flat.find(name)->second;
+    }
+    std::size_t flatAllocations = heapAllocations - before;
+
+    std::cout << "  " << products << " lookups, std::unordered_map (via std::string): " << standardAllocations
+              << " allocations" << std::endl;
+    std::cout << "  " << products << " lookups, FlatHashMap (via std::string_view): " << flatAllocations
+              << " allocations" << std::endl;
+    std::cout << "  Results match: " << (standardSum == flatSum ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+void demonstrateChurn() {
+    std::cout << "3. Erase/insert churn without tombstones:" << std::endl;
+
+    const std::size_t entries = 200000;
+    const int rounds = 20;
+    FlatHashMap<std::string, double> prices;
+    KeyBuffer buffer;
+    for (std::size_t i = 0; i < entries; ++i) {
+        prices[std::string(buffer.make("item-", i))] = 1.0;
+    }
+
+    auto lookupNs = [&](std::size_t first) {
+        double sum = 0;
+        double ms = bench::timeMs([&] {
+            for (std::size_t i = 0; i < entries; ++i) {
+                sum += prices.find(buffer.make("item-", first + scattered(i, entries)))->second;
+            }
+        });
+        return sum == static_cast<double>(entries) ? ms * 1e6 / static_cast<double>(entries) : -1.0;
+    };
+
+    std::size_t freshCapacity = prices.capacity();
+    double freshNs = lookupNs(0);
+
+    // Every round replaces all entries by new keys
+    for (int round = 1; round <= rounds; ++round) {
+        for (std::size_t i = 0; i < entries; ++i) {
+            prices.erase(buffer.make("item-", (round - 1) * entries + i));
+            prices[std::string(buffer.make("item-", round * entries + i))] = 1.0;
+        }
+    }
+    double churnedNs = lookupNs(rounds * entries);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Fresh table:   " << entries << " entries, " << freshCapacity << " slots, " << freshNs
+              << " ns per hit" << std::endl;
+    std::cout << "  After " << rounds << " rounds: " << prices.size() << " entries, " << prices.capacity()
+              << " slots, " << churnedNs << " ns per hit" << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "  Capacity unchanged: " << (prices.capacity() == freshCapacity ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+struct Timings {
+    double insertNs = 0;
+    double hitNs = 0;
+    double missNs = 0;
+    double eraseNs = 0;
+    double checksum = 0;  // Sum of hit values, then misses found, then entries left
+};
+
+template <typename Map>
+Timings measure(std::size_t n) {
+    Timings timings;
+    KeyBuffer buffer;
+    auto perOperation = [n](double ms) { return ms * 1e6 / static_cast<double>(n); };
+    Map prices;
+
+    timings.insertNs = perOperation(bench::timeMs([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            prices[std::string(buffer.make("item-", i))] = static_cast<double>(i % 1000) / 100;
+        }
+    }));
+
+    double sum = 0;
+    timings.hitNs = perOperation(bench::timeMs([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += prices.find(std::string(buffer.make("item-", scattered(i, n))))->second;
+        }
+    }));
+
+    std::size_t found = 0;
+    timings.missNs = perOperation(bench::timeMs([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            found += prices.count(std::string(buffer.make("sold-", scattered(i, n))));
+        }
+    }));
+
+    timings.eraseNs = perOperation(bench::timeMs([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            prices.erase(std::string(buffer.make("item-", scattered(i, n))));
+        }
+    }));
+
+    timings.checksum = sum + static_cast<double>(found) + static_cast<double>(prices.size());
+    return timings;
+}
+
+void benchmark(std::size_t maxEntries) {
+    std::cout << "4. std::unordered_map<std::string, double> vs FlatHashMap (ns per operation):" << std::endl;
+    std::cout << "  " << std::left << std::setw(12) << "Entries" << std::setw(10) << "Op" << std::right
+              << std::setw(14) << "unordered_map" << std::setw(14) << "FlatHashMap" << std::setw(10) << "Speedup"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    bool allMatch = true;
+    for (std::size_t n = 1000000; n <= maxEntries; n *= 10) {
+        // One table at a time, so the largest size fits in memory
+        Timings standard = measure<std::unordered_map<std::string, double>>(n);
+        Timings flat = measure<FlatHashMap<std::string, double>>(n);
+        allMatch = allMatch && standard.checksum == flat.checksum;
+
+        auto row = [&](const char* op, double standardNs, double flatNs) {
+            std::cout << "  " << std::left << std::setw(12) << n << std::setw(10) << op << std::right
+                      << std::setw(14) << standardNs << std::setw(14) << flatNs << std::setw(9)
+                      << standardNs / flatNs << "x" << std::endl;
+        };
+        row("insert", standard.insertNs, flat.insertNs);
+        row("hit", standard.hitNs, flat.hitNs);
+        row("miss", standard.missNs, flat.missNs);
+        row("erase", standard.eraseNs, flat.eraseNs);
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "  Results match: " << (allMatch ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Flat Hash Map ===" << std::endl;
+    std::cout << std::endl;
+
+    std::size_t maxEntries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    demonstrateDropIn();
+    demonstrateHeterogeneousLookup();
+    demonstrateChurn();
+    benchmark(std::max<std::size_t>(maxEntries, 1000000));
+
+    std::cout << "=== End of Flat Hash Map Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,569 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * FlatHashMap<K, V> and FlatHashSet<K>
+ *
+ * Open-addressing hash tables in the style of Swiss tables, as drop-ins
+ * for the std::unordered_map / std::unordered_set calls in containers.cpp:
+ *
+ * - Elements live in one flat slot array, not in one node per entry. A
+ *   parallel array holds one control byte per slot: 0x80 for empty, or
+ *   the low 7 bits of the element's hash.
+ * - A lookup starts at the slot its hash selects and compares 16 control
+ *   bytes at once (SSE2: one load, one compare, one movemask). Only slots
+ *   whose byte matches are compared with the key. The first group that
+ *   contains an empty byte ends a miss.
+ * - Probing is linear, so deletion needs no tombstones. erase() shifts
+ *   the following elements of the cluster back into the hole, and a
+ *   table churned by erase/insert never fills up with deleted markers.
+ * - std::string keys can be looked up with std::string_view or const
+ *   char* without building a std::string (the default hash and key
+ *   equality are transparent).
+ * - The table grows by doubling once it is 7/8 full. Growth and erase()
+ *   move elements, so both invalidate iterators and references.
+ */
+
+namespace flat_hash {
+
+constexpr std::size_t groupWidth = 16;
+constexpr std::int8_t emptyControl = -128;
+
+// Bit i is set if control[i] == byte, for the 16 bytes at control
+inline std::uint32_t matchByte(const std::int8_t* control, std::int8_t byte) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < groupWidth; ++i) {
+        mask |= static_cast<std::uint32_t>(control[i] == byte) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i is set if slot i of the group is empty (the only negative control byte)
+inline std::uint32_t matchEmpty(const std::int8_t* control) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(group));
+#else
+    return matchByte(control, emptyControl);
+#endif
+}
+
+// std::hash, except that std::string also hashes string_view and const char*
+template <typename Key>
+struct Hash : std::hash<Key> {};
+
+template <>
+struct Hash<std::string> {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+};
+
+// Spreads the bits of weak hashes (std::hash of an integer is the integer)
+inline std::uint64_t mix(std::size_t hash) {
+    std::uint64_t h = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 32);
+}
+
+template <typename Key, typename Value>
+struct MapPolicy {
+    using key_type = Key;
+    using value_type = std::pair<const Key, Value>;
+
+    static const Key& key(const value_type& value) { return value.first; }
+
+    // Moves *from into raw memory at to and destroys *from. The key is
+    // const only towards users; the table may move it out of a slot it is
+    // about to destroy.
+    static void relocate(value_type* to, value_type* from) {
+        ::new (static_cast<void*>(to)) value_type(std::move(const_cast<Key&>(from->first)), std::move(from->second));
+        std::destroy_at(from);
+    }
+};
+
+template <typename Key>
+struct SetPolicy {
+    using key_type = Key;
+    using value_type = Key;
+
+    static const Key& key(const value_type& value) { return value; }
+
+    static void relocate(value_type* to, value_type* from) {
+        ::new (static_cast<void*>(to)) value_type(std::move(*from));
+        std::destroy_at(from);
+    }
+};
+
+// The table behind FlatHashMap and FlatHashSet
+template <typename Policy, typename HashFn, typename KeyEqual>
+class Table {
+public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using hasher = HashFn;
+    using key_equal = KeyEqual;
+
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class Table;
+        template <bool>
+        friend class Iterator;
+        using TablePointer = std::conditional_t<Const, const Table*, Table*>;
+        TablePointer table = nullptr;
+        std::size_t index = 0;
+
+        Iterator(TablePointer owner, std::size_t slot) : table(owner), index(slot) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+        Iterator() = default;
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) : table(other.table), index(other.index) {}
+
+        reference operator*() const { return table->slots[index]; }
+        pointer operator->() const { return &table->slots[index]; }
+
+        Iterator& operator++() {
+            index = table->nextFull(index + 1);
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.index == b.index; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return a.index != b.index; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    std::int8_t* control = nullptr;  // slotCount + groupWidth - 1 bytes; the tail mirrors the head
+    value_type* slots = nullptr;
+    std::size_t slotCount = 0;  // 0 or a power of two >= groupWidth
+    std::size_t elementCount = 0;
+    [[no_unique_address]] HashFn hashFunction;
+    [[no_unique_address]] KeyEqual keyEqual;
+
+    template <typename K>
+    static constexpr bool transparent = requires {
+        typename HashFn::is_transparent;
+        typename KeyEqual::is_transparent;
+    } || std::is_same_v<std::remove_cvref_t<K>, key_type>;
+
+    std::size_t mask() const { return slotCount - 1; }
+    static std::size_t growthLimit(std::size_t slotTotal) { return slotTotal - slotTotal / 8; }
+
+    template <typename K>
+    std::uint64_t hashOf(const K& key) const {
+        return mix(hashFunction(key));
+    }
+    std::size_t home(std::uint64_t hash) const { return static_cast<std::size_t>(hash >> 7) & mask(); }
+    static std::int8_t fingerprint(std::uint64_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+
+    // Sets a control byte and its mirror behind the end of the table, so
+    // a group loaded near the end wraps around to the first slots
+    void setControl(std::size_t index, std::int8_t value) {
+        control[index] = value;
+        if (index < groupWidth - 1) {
+            control[slotCount + index] = value;
+        }
+    }
+
+    std::size_t nextFull(std::size_t index) const {
+        while (index < slotCount && control[index] == emptyControl) {
+            ++index;
+        }
+        return index;
+    }
+
+    // The slot holding key, or the first empty slot of its probe sequence
+    struct Probe {
+        std::size_t index;
+        bool found;
+    };
+
+    template <typename K>
+    Probe probe(const K& key, std::uint64_t hash) const {
+        std::int8_t h2 = fingerprint(hash);
+        for (std::size_t position = home(hash);; position = (position + groupWidth) & mask()) {
+            const std::int8_t* group = control + position;
+            for (std::uint32_t matches = matchByte(group, h2); matches != 0; matches &= matches - 1) {
+                std::size_t index = (position + std::countr_zero(matches)) & mask();
+                if (keyEqual(Policy::key(slots[index]), key)) {
+                    return {index, true};
+                }
+            }
+            if (std::uint32_t empty = matchEmpty(group)) {
+                return {(position + std::countr_zero(empty)) & mask(), false};
+            }
+        }
+    }
+
+    std::size_t firstEmpty(std::uint64_t hash) const {
+        for (std::size_t position = home(hash);; position = (position + groupWidth) & mask()) {
+            if (std::uint32_t empty = matchEmpty(control + position)) {
+                return (position + std::countr_zero(empty)) & mask();
+            }
+        }
+    }
+
+    template <typename K>
+    std::size_t findIndex(const K& key) const {
+        if (elementCount == 0) {
+            return slotCount;
+        }
+        Probe result = probe(key, hashOf(key));
+        return result.found ? result.index : slotCount;
+    }
+
+    void allocate(std::size_t newSlotCount) {
+        slotCount = newSlotCount;
+        control = new std::int8_t[slotCount + groupWidth - 1];
+        std::memset(control, emptyControl, slotCount + groupWidth - 1);
+        slots = std::allocator<value_type>().allocate(slotCount);
+    }
+
+    void release() {
+        if (slotCount == 0) {
+            return;
+        }
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            if (control[i] != emptyControl) {
+                std::destroy_at(&slots[i]);
+            }
+        }
+        delete[] control;
+        std::allocator<value_type>().deallocate(slots, slotCount);
+        control = nullptr;
+        slots = nullptr;
+        slotCount = 0;
+        elementCount = 0;
+    }
+
+    void rehash(std::size_t newSlotCount) {
+        std::int8_t* oldControl = control;
+        value_type* oldSlots = slots;
+        std::size_t oldSlotCount = slotCount;
+        allocate(newSlotCount);
+        for (std::size_t i = 0; i < oldSlotCount; ++i) {
+            if (oldControl[i] != emptyControl) {
+                std::uint64_t hash = hashOf(Policy::key(oldSlots[i]));
+                std::size_t index = firstEmpty(hash);
+                Policy::relocate(&slots[index], &oldSlots[i]);
+                setControl(index, fingerprint(hash));
+            }
+        }
+        if (oldSlotCount != 0) {
+            delete[] oldControl;
+            std::allocator<value_type>().deallocate(oldSlots, oldSlotCount);
+        }
+    }
+
+    // Removes slot index and closes the gap: every later element of the
+    // cluster that may live closer to its home slot moves back
+    void eraseAt(std::size_t index) {
+        std::destroy_at(&slots[index]);
+        --elementCount;
+        std::size_t gap = index;
+        for (std::size_t next = (gap + 1) & mask(); control[next] != emptyControl; next = (next + 1) & mask()) {
+            std::size_t nextHome = home(hashOf(Policy::key(slots[next])));
+            if (((next - nextHome) & mask()) >= ((next - gap) & mask())) {
+                Policy::relocate(&slots[gap], &slots[next]);
+                setControl(gap, control[next]);
+                gap = next;
+            }
+        }
+        setControl(gap, emptyControl);
+    }
+
+protected:
+    // Finds key or constructs a new element for it with construct(memory)
+    template <typename K, typename Construct>
+    std::pair<iterator, bool> insertWith(const K& key, Construct&& construct) {
+        if (slotCount == 0) {
+            rehash(groupWidth);
+        }
+        std::uint64_t hash = hashOf(key);
+        Probe result = probe(key, hash);
+        if (result.found) {
+            return {iterator(this, result.index), false};
+        }
+        if (elementCount + 1 > growthLimit(slotCount)) {
+            rehash(slotCount * 2);
+            result.index = firstEmpty(hash);
+        }
+        construct(static_cast<void*>(&slots[result.index]));
+        setControl(result.index, fingerprint(hash));
+        ++elementCount;
+        return {iterator(this, result.index), true};
+    }
+
+public:
+    Table() = default;
+
+    Table(const Table& other) : hashFunction(other.hashFunction), keyEqual(other.keyEqual) {
+        if (other.elementCount == 0) {
+            return;
+        }
+        allocate(other.slotCount);
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            if (other.control[i] != emptyControl) {
+                ::new (static_cast<void*>(&slots[i])) value_type(other.slots[i]);
+                setControl(i, other.control[i]);
+                ++elementCount;
+            }
+        }
+    }
+
+    Table(Table&& other) noexcept
+        : control(std::exchange(other.control, nullptr)),
+          slots(std::exchange(other.slots, nullptr)),
+          slotCount(std::exchange(other.slotCount, 0)),
+          elementCount(std::exchange(other.elementCount, 0)),
+          hashFunction(std::move(other.hashFunction)),
+          keyEqual(std::move(other.keyEqual)) {}
+
+    Table& operator=(Table other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~Table() { release(); }
+
+    void swap(Table& other) noexcept {
+        std::swap(control, other.control);
+        std::swap(slots, other.slots);
+        std::swap(slotCount, other.slotCount);
+        std::swap(elementCount, other.elementCount);
+        std::swap(hashFunction, other.hashFunction);
+        std::swap(keyEqual, other.keyEqual);
+    }
+
+    iterator begin() { return iterator(this, nextFull(0)); }
+    iterator end() { return iterator(this, slotCount); }
+    const_iterator begin() const { return const_iterator(this, nextFull(0)); }
+    const_iterator end() const { return const_iterator(this, slotCount); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_type size() const { return elementCount; }
+    bool empty() const { return elementCount == 0; }
+    size_type capacity() const { return slotCount; }
+    float load_factor() const { return slotCount ? static_cast<float>(elementCount) / static_cast<float>(slotCount) : 0; }
+
+    void clear() {
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            if (control[i] != emptyControl) {
+                std::destroy_at(&slots[i]);
+                setControl(i, emptyControl);
+            }
+        }
+        elementCount = 0;
+    }
+
+    // Makes room for `elements` elements without further growth
+    void reserve(size_type elements) {
+        std::size_t needed = groupWidth;
+        while (growthLimit(needed) < elements) {
+            needed *= 2;
+        }
+        if (needed > slotCount) {
+            rehash(needed);
+        }
+    }
+
+    template <typename K = key_type>
+        requires transparent<K>
+    iterator find(const K& key) {
+        return iterator(this, findIndex(key));
+    }
+
+    template <typename K = key_type>
+        requires transparent<K>
+    const_iterator find(const K& key) const {
+        return const_iterator(this, findIndex(key));
+    }
+
+    template <typename K = key_type>
+        requires transparent<K>
+    bool contains(const K& key) const {
+        return findIndex(key) != slotCount;
+    }
+
+    template <typename K = key_type>
+        requires transparent<K>
+    size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename K = key_type>
+        requires transparent<K>
+    size_type erase(const K& key) {
+        std::size_t index = findIndex(key);
+        if (index == slotCount) {
+            return 0;
+        }
+        eraseAt(index);
+        return 1;
+    }
+
+    // Unlike std::unordered_map::erase, returns nothing: the gap is filled
+    // by later elements, so there is no cheap "next" iterator
+    void erase(const_iterator position) { eraseAt(position.index); }
+
+    // Erases every element for which pred(element) is true
+    template <typename Pred>
+    size_type erase_if(Pred pred) {
+        size_type erased = 0;
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            // Erasing pulls a later element into slot i, so test i again
+            while (control[i] != emptyControl && pred(std::as_const(slots[i]))) {
+                eraseAt(i);
+                ++erased;
+            }
+        }
+        return erased;
+    }
+};
+
+}  // namespace flat_hash
+
+template <typename Key, typename Value, typename Hash = flat_hash::Hash<Key>, typename KeyEqual = std::equal_to<>>
+class FlatHashMap : public flat_hash::Table<flat_hash::MapPolicy<Key, Value>, Hash, KeyEqual> {
+private:
+    using Base = flat_hash::Table<flat_hash::MapPolicy<Key, Value>, Hash, KeyEqual>;
+
+public:
+    using typename Base::iterator;
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using mapped_type = Value;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<value_type> values) {
+        this->reserve(values.size());
+        for (const value_type& value : values) {
+            insert(value);
+        }
+    }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return this->insertWith(key, [&](void* memory) {
+            ::new (memory) value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                      std::forward_as_tuple(std::forward<Args>(args)...));
+        });
+    }
+
+    template <typename K, typename V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value) {
+        return try_emplace(std::forward<K>(key), std::forward<V>(value));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+
+    template <typename K, typename V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+        auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+    Value& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+    template <typename K = Key>
+    Value& at(const K& key) {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("FlatHashMap::at: key not found");
+        }
+        return it->second;
+    }
+
+    template <typename K = Key>
+    const Value& at(const K& key) const {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("FlatHashMap::at: key not found");
+        }
+        return it->second;
+    }
+};
+
+template <typename Key, typename Hash = flat_hash::Hash<Key>, typename KeyEqual = std::equal_to<>>
+class FlatHashSet : public flat_hash::Table<flat_hash::SetPolicy<Key>, Hash, KeyEqual> {
+private:
+    using Base = flat_hash::Table<flat_hash::SetPolicy<Key>, Hash, KeyEqual>;
+
+public:
+    using typename Base::iterator;
+    using typename Base::value_type;
+
+    FlatHashSet() = default;
+
+    FlatHashSet(std::initializer_list<Key> values) {
+        this->reserve(values.size());
+        for (const Key& value : values) {
+            insert(value);
+        }
+    }
+
+    std::pair<iterator, bool> insert(const Key& value) {
+        return this->insertWith(value, [&](void* memory) { ::new (memory) Key(value); });
+    }
+
+    std::pair<iterator, bool> insert(Key&& value) {
+        return this->insertWith(value, [&](void* memory) { ::new (memory) Key(std::move(value)); });
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(Key(std::forward<Args>(args)...));
+    }
+};
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual, typename Pred>
+std::size_t erase_if(FlatHashMap<Key, Value, Hash, KeyEqual>& map, Pred pred) {
+    return map.erase_if(pred);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Pred>
+std::size_t erase_if(FlatHashSet<Key, Hash, KeyEqual>& set, Pred pred) {
+    return set.erase_if(pred);
+}
@@ -0,0 +1,219 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include "flat_map.h"
+#include "bench.h"
+
+/**
+ * Sorted Flat Map for Read-Mostly Tables
+ *
+ * This example demonstrates:
+ * - FlatMap (flat_map.h) running demonstrateMap from containers.cpp with
+ *   exactly the same output as std::map<std::string, int>
+ * - Bulk construction from unsorted input with duplicate keys
+ * - Lookups: std::map, std::lower_bound over a sorted vector of strings,
+ *   FlatMap::find (branchless prefix search with a SIMD final step) and
+ *   FlatMap::findAll (batched, with interleaved prefetches)
+ * - Keys whose first eight bytes differ (names) and keys that share a long
+ *   prefix ("student/..."), where the prefix alone cannot decide
+ *
+ * Usage: ./perf_flat_map [entries] [lookups]   (default: 1000000 2000000)
+ */
+
+// ---------------------------------------------------------------------------
+// demonstrateMap from containers.cpp, for any map type
+// ---------------------------------------------------------------------------
+
+template <typename Map>
+std::string runDemonstrateMap() {
+    std::ostringstream out;
+    Map ages;
+
+    // Adding key-value pairs
+    ages["Alice"] = 25;
+    ages["Bob"] = 30;
+    ages["Charlie"] = 35;
+    ages.insert({"David", 28});
+
+    // Accessing values
+    out << "  Alice's age: " << ages["Alice"] << '\n';
+    out << "  Bob's age: " << ages.at("Bob") << '\n';
+
+    // Iterating through map
+    out << "  All ages:" << '\n';
+    for (const auto& pair : ages) {
+        out << "    " << pair.first << ": " << pair.second << '\n';
+    }
+
+    // Check if key exists
+    if (ages.find("Eve") != ages.end()) {
+        out << "  Eve's age: " << ages["Eve"] << '\n';
+    } else {
+        out << "  Eve not found in map" << '\n';
+    }
+    return out.str();
+}
+
+void demonstrateDropIn() {
+    std::cout << "1. demonstrateMap with FlatMap<std::string, int>:" << std::endl;
+    std::string flat = runDemonstrateMap<FlatMap<std::string, int>>();
+    std::cout << flat;
+    std::cout << "  Output identical to std::map: "
+              << (flat == runDemonstrateMap<std::map<std::string, int>>() ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+void demonstrateBulkConstruction() {
+    std::cout << "2. Bulk construction from unsorted input:" << std::endl;
+    std::vector<std::pair<std::string, int>> rows = {
+        {"Mallory", 41}, {"Alice", 25}, {"Trent", 52}, {"Bob", 30}, {"Alice", 99}, {"Eve", 33}};
+    FlatMap<std::string, int> ages(rows);
+    std::map<std::string, int> reference;
+    for (const auto& row : rows) {
+        reference.insert(row);
+    }
+
+    std::cout << "  " << rows.size() << " rows, " << ages.size() << " keys:";
+    for (const auto& [name, age] : ages) {
+        std::cout << " " << name << "=" << age;
+    }
+    std::cout << std::endl;
+    std::cout << "  Matches std::map::insert (first Alice wins): "
+              << (std::equal(ages.begin(), ages.end(), reference.begin(), reference.end(),
+                             [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; })
+                      ? "Yes"
+                      : "No")
+              << std::endl;
+    std::cout << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+std::vector<std::string> randomNames(std::size_t count, std::mt19937& rng) {
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> length(6, 14);
+    std::vector<std::string> names(count);
+    for (std::string& name : names) {
+        name.resize(static_cast<std::size_t>(length(rng)));
+        for (char& c : name) {
+            c = static_cast<char>(letter(rng));
+        }
+        name[0] = static_cast<char>(name[0] - 'a' + 'A');
+    }
+    return names;
+}
+
+std::vector<std::string> sharedPrefixNames(std::size_t count, std::mt19937& rng) {
+    std::vector<std::string> names(count);
+    for (std::string& name : names) {
+        name = "student/" + std::to_string(rng() % 1000000000);
+    }
+    return names;
+}
+
+void benchmarkKeys(const char* title, std::vector<std::string> names, std::size_t lookups, std::mt19937& rng) {
+    std::vector<std::pair<std::string, int>> rows;
+    rows.reserve(names.size());
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        rows.emplace_back(names[i], static_cast<int>(i % 100));
+    }
+
+    std::map<std::string, int> tree;
+    double treeBuildMs = bench::timeMs([&] {
+        for (const auto& row : rows) {
+            tree.insert(row);
+        }
+    });
+    FlatMap<std::string, int> flat;
+    double flatBuildMs = bench::timeMs([&] { flat = FlatMap<std::string, int>(rows); });
+    std::vector<std::string> sortedKeys;
+    std::vector<int> sortedValues;
+    for (const auto& [name, value] : flat) {
+        sortedKeys.push_back(name);
+        sortedValues.push_back(value);
+    }
+
+    // Half hits, half misses, in random order
+    std::vector<std::string> queries(lookups);
+    std::uniform_int_distribution<std::size_t> pick(0, names.size() - 1);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        queries[i] = i % 2 == 0 ? names[pick(rng)] : names[pick(rng)] + "~";
+    }
+
+    long long treeSum = 0, vectorSum = 0, findSum = 0, batchSum = 0;
+    double treeMs = bench::timeMs([&] {
+        for (const std::string& query : queries) {
+            auto it = tree.find(query);
+            treeSum += it != tree.end() ? it->second + 1 : 0;
+        }
+    });
+    double vectorMs = bench::timeMs([&] {
+        for (const std::string& query : queries) {
+            auto it = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), query);
+            if (it != sortedKeys.end() && *it == query) {
+                vectorSum += sortedValues[static_cast<std::size_t>(it - sortedKeys.begin())] + 1;
+            }
+        }
+    });
+    double findMs = bench::timeMs([&] {
+        for (const std::string& query : queries) {
+            auto it = flat.find(query);
+            findSum += it != flat.end() ? it->second + 1 : 0;
+        }
+    });
+    std::vector<std::size_t> positions(lookups);
+    double batchMs = bench::timeMs([&] {
+        flat.findAll(queries.data(), queries.size(), positions.data());
+        for (std::size_t position : positions) {
+            batchSum += position != flat.size() ? flat.valueAt(position) + 1 : 0;
+        }
+    });
+
+    auto nsPerLookup = [lookups](double ms) { return ms * 1e6 / static_cast<double>(lookups); };
+    std::cout << "  " << title << " (" << flat.size() << " keys):" << std::endl;
+    std::cout << "    Build:  std::map inserts " << treeBuildMs << " ms, FlatMap bulk " << flatBuildMs << " ms"
+              << std::endl;
+    std::cout << "    std::map::find:          " << nsPerLookup(treeMs) << " ns/lookup" << std::endl;
+    std::cout << "    sorted vector + lower_bound: " << nsPerLookup(vectorMs) << " ns/lookup" << std::endl;
+    std::cout << "    FlatMap::find:           " << nsPerLookup(findMs) << " ns/lookup (" << treeMs / findMs
+              << "x vs std::map)" << std::endl;
+    std::cout << "    FlatMap::findAll:        " << nsPerLookup(batchMs) << " ns/lookup (" << treeMs / batchMs
+              << "x vs std::map)" << std::endl;
+    std::cout << "    Results match: "
+              << (treeSum == vectorSum && treeSum == findSum && treeSum == batchSum ? "Yes" : "No") << std::endl;
+}
+
+void benchmark(std::size_t entries, std::size_t lookups) {
+    std::cout << "3. " << lookups << " lookups, half of them misses:" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::mt19937 rng(23);
+    benchmarkKeys("Names", randomNames(entries, rng), lookups, rng);
+    benchmarkKeys("Shared prefix \"student/\"", sharedPrefixNames(entries, rng), lookups, rng);
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Sorted Flat Map ===" << std::endl;
+    std::cout << std::endl;
+
+    std::size_t entries = argc > 1 ? std::max<std::size_t>(std::strtoull(argv[1], nullptr, 10), 1) : 1000000;
+    std::size_t lookups = argc > 2 ? std::max<std::size_t>(std::strtoull(argv[2], nullptr, 10), 1) : 2000000;
+
+    demonstrateDropIn();
+    demonstrateBulkConstruction();
+    benchmark(entries, lookups);
+
+    std::cout << "=== End of Flat Map Example ===" << std::endl;
+
+    return 0;
+}
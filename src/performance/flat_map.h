@@ -0,0 +1,428 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * FlatMap<K, V>
+ *
+ * A sorted map for tables that are built once and then read many times,
+ * with the std::map calls of containers.cpp (operator[], insert, at, find,
+ * ordered iteration):
+ *
+ * - Keys and values live in two sorted, contiguous arrays. A third array
+ *   holds an 8-byte order-preserving prefix of every key: the value of an
+ *   integer, or eight bytes of a string, big-endian. The string bytes are
+ *   taken after the leading part that all keys share ("student/..."), so
+ *   keys with a common prefix still have distinct prefixes.
+ * - find() binary-searches the prefixes without branches, down to a window
+ *   of eight, then counts the prefixes below the target with one SIMD
+ *   compare per four (AVX2, or a plain loop the compiler vectorizes).
+ *   Only a key whose prefix matches is compared in full.
+ * - The bulk constructor sorts unsorted input once. Like std::map::insert,
+ *   the first of several equal keys wins.
+ * - findAll() looks up a batch of keys in lockstep and prefetches the
+ *   next probes of every key, so their cache misses overlap.
+ * - Iteration is in key order. As in C++23 std::flat_map, *it is a pair of
+ *   references, std::pair<const K&, V&>, rather than a stored pair.
+ * - Inserting or erasing a single key shifts the arrays (O(n)), and it
+ *   invalidates iterators.
+ */
+
+namespace flat_map {
+
+// Monotone in the key: a < b implies prefix(a) <= prefix(b). Stored with
+// the sign bit flipped, so signed compares (the only 64-bit SIMD compare)
+// order them as unsigned numbers.
+inline std::int64_t orderedPrefix(std::string_view key) {
+    unsigned char bytes[8] = {};
+    std::memcpy(bytes, key.data(), std::min<std::size_t>(key.size(), 8));
+    std::uint64_t prefix = 0;
+    for (unsigned char byte : bytes) {
+        prefix = (prefix << 8) | byte;
+    }
+    return static_cast<std::int64_t>(prefix ^ (std::uint64_t(1) << 63));
+}
+
+template <std::integral Key>
+std::int64_t orderedPrefix(Key key) {
+    if constexpr (std::is_signed_v<Key>) {
+        return static_cast<std::int64_t>(key);
+    } else {
+        return static_cast<std::int64_t>(static_cast<std::uint64_t>(key) ^ (std::uint64_t(1) << 63));
+    }
+}
+
+constexpr std::size_t window = 8;
+
+// Number of prefixes < target among the `available` (at most `window`)
+// prefixes at base
+inline std::size_t countBelow(const std::int64_t* base, std::size_t available, std::int64_t target) {
+    if (available < window) {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < available; ++i) {
+            count += base[i] < target;
+        }
+        return count;
+    }
+#if defined(__AVX2__)
+    __m256i value = _mm256_set1_epi64x(target);
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + 4));
+    int lowMask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(value, low)));
+    int highMask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(value, high)));
+    return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(lowMask | (highMask << 4))));
+#else
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < window; ++i) {
+        count += base[i] < target;
+    }
+    return count;
+#endif
+}
+
+}  // namespace flat_map
+
+template <typename Key, typename Value>
+class FlatMap {
+private:
+    std::vector<std::int64_t> prefixes;
+    std::size_t sharedLength = 0;  // Leading bytes all (string) keys have in common
+    std::vector<Key> keys;
+    std::vector<Value> values;
+
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class FlatMap;
+        template <bool>
+        friend class Iterator;
+        using MapPointer = std::conditional_t<Const, const FlatMap*, FlatMap*>;
+        MapPointer map = nullptr;
+        std::size_t index = 0;
+
+        Iterator(MapPointer owner, std::size_t position) : map(owner), index(position) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, std::conditional_t<Const, const Value&, Value&>>;
+
+        // it->second needs an object to point at; the pair of references is it
+        struct pointer {
+            reference pair;
+            const reference* operator->() const { return &pair; }
+        };
+
+        Iterator() = default;
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) : map(other.map), index(other.index) {}
+
+        reference operator*() const { return {map->keys[index], map->values[index]}; }
+        pointer operator->() const { return {**this}; }
+
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++index;
+            return old;
+        }
+        Iterator& operator--() {
+            --index;
+            return *this;
+        }
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --index;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.index == b.index; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return a.index != b.index; }
+    };
+
+    static constexpr bool stringKeys = std::is_convertible_v<const Key&, std::string_view>;
+
+    static std::size_t commonLength(std::string_view a, std::string_view b) {
+        return static_cast<std::size_t>(std::mismatch(a.begin(), a.end(), b.begin(), b.end()).first - a.begin());
+    }
+
+    // The prefix key is searched by. A string outside the shared part of
+    // all keys gets the smallest or largest prefix.
+    template <typename K>
+    std::int64_t prefixOf(const K& key) const {
+        if constexpr (stringKeys) {
+            std::string_view text(key);
+            if (sharedLength != 0) {
+                int order = text.substr(0, sharedLength).compare(std::string_view(keys.front()).substr(0, sharedLength));
+                if (order != 0) {
+                    return order < 0 ? std::numeric_limits<std::int64_t>::min()
+                                     : std::numeric_limits<std::int64_t>::max();
+                }
+                text.remove_prefix(sharedLength);
+            }
+            return flat_map::orderedPrefix(text);
+        } else {
+            return flat_map::orderedPrefix(key);
+        }
+    }
+
+    // First position whose prefix is >= target
+    std::size_t prefixLowerBound(std::int64_t target) const {
+        const std::int64_t* base = prefixes.data();
+        std::size_t n = size();
+        while (n > flat_map::window) {
+            std::size_t half = n / 2;
+            base = base[half] < target ? base + half : base;
+            n -= half;
+        }
+        std::size_t offset = static_cast<std::size_t>(base - prefixes.data());
+        return offset + flat_map::countBelow(base, std::min(flat_map::window, size() - offset), target);
+    }
+
+    // First position whose key is >= key, given the prefix lower bound
+    template <typename K>
+    std::size_t keyLowerBound(const K& key, std::int64_t prefix, std::size_t position) const {
+        if (position == size() || prefixes[position] != prefix || !(keys[position] < key)) {
+            return position;
+        }
+        // Several keys share the prefix: search the run by full key
+        std::size_t runEnd = prefix == std::numeric_limits<std::int64_t>::max() ? size() : prefixLowerBound(prefix + 1);
+        return static_cast<std::size_t>(
+            std::lower_bound(keys.begin() + static_cast<std::ptrdiff_t>(position),
+                             keys.begin() + static_cast<std::ptrdiff_t>(runEnd), key, std::less<>()) -
+            keys.begin());
+    }
+
+    template <typename K>
+    std::size_t lowerBoundIndex(const K& key) const {
+        std::int64_t prefix = prefixOf(key);
+        return keyLowerBound(key, prefix, prefixLowerBound(prefix));
+    }
+
+    template <typename K>
+    std::size_t findIndex(const K& key) const {
+        std::size_t position = lowerBoundIndex(key);
+        return position < size() && keys[position] == key ? position : size();
+    }
+
+    template <typename K, typename V>
+    void insertAt(std::size_t position, K&& key, V&& value) {
+        auto offset = static_cast<std::ptrdiff_t>(position);
+        if constexpr (stringKeys) {
+            // A key outside the shared part shortens it for every key
+            std::size_t common = sharedLength == 0 ? 0 : commonLength(key, keys.front());
+            if (common < sharedLength) {
+                sharedLength = common;
+                keys.insert(keys.begin() + offset, std::forward<K>(key));
+                values.insert(values.begin() + offset, std::forward<V>(value));
+                rebuildPrefixes();
+                return;
+            }
+        }
+        prefixes.insert(prefixes.begin() + offset, prefixOf(key));
+        keys.insert(keys.begin() + offset, std::forward<K>(key));
+        values.insert(values.begin() + offset, std::forward<V>(value));
+    }
+
+    void rebuildPrefixes() {
+        prefixes.clear();
+        prefixes.reserve(keys.size());
+        for (const Key& key : keys) {
+            prefixes.push_back(prefixOf(key));
+        }
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatMap() = default;
+
+    // Bulk construction: sorts once, keeps the first of equal keys
+    explicit FlatMap(std::vector<value_type> entries) {
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const value_type& a, const value_type& b) { return a.first < b.first; });
+        keys.reserve(entries.size());
+        values.reserve(entries.size());
+        for (value_type& entry : entries) {
+            if (keys.empty() || keys.back() < entry.first) {
+                keys.push_back(std::move(entry.first));
+                values.push_back(std::move(entry.second));
+            }
+        }
+        if constexpr (stringKeys) {
+            // The keys are sorted, so the first and last share least
+            sharedLength = keys.size() < 2 ? 0 : commonLength(keys.front(), keys.back());
+        }
+        rebuildPrefixes();
+    }
+
+    FlatMap(std::initializer_list<value_type> entries) : FlatMap(std::vector<value_type>(entries)) {}
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    size_type size() const { return keys.size(); }
+    bool empty() const { return keys.empty(); }
+
+    void reserve(size_type count) {
+        prefixes.reserve(count);
+        keys.reserve(count);
+        values.reserve(count);
+    }
+
+    void clear() {
+        keys.clear();
+        values.clear();
+        prefixes.clear();
+        sharedLength = 0;
+    }
+
+    template <typename K>
+    iterator find(const K& key) {
+        return iterator(this, findIndex(key));
+    }
+
+    template <typename K>
+    const_iterator find(const K& key) const {
+        return const_iterator(this, findIndex(key));
+    }
+
+    template <typename K>
+    iterator lower_bound(const K& key) {
+        return iterator(this, lowerBoundIndex(key));
+    }
+
+    template <typename K>
+    bool contains(const K& key) const {
+        return findIndex(key) != size();
+    }
+
+    template <typename K>
+    size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename K>
+    Value& at(const K& key) {
+        std::size_t index = findIndex(key);
+        if (index == size()) {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return values[index];
+    }
+
+    template <typename K>
+    const Value& at(const K& key) const {
+        std::size_t index = findIndex(key);
+        if (index == size()) {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return values[index];
+    }
+
+    std::pair<iterator, bool> insert(const value_type& entry) {
+        std::size_t position = lowerBoundIndex(entry.first);
+        if (position < size() && keys[position] == entry.first) {
+            return {iterator(this, position), false};
+        }
+        insertAt(position, entry.first, entry.second);
+        return {iterator(this, position), true};
+    }
+
+    Value& operator[](const Key& key) {
+        std::size_t position = lowerBoundIndex(key);
+        if (position == size() || !(keys[position] == key)) {
+            insertAt(position, key, Value());
+        }
+        return values[position];
+    }
+
+    template <typename K>
+    size_type erase(const K& key) {
+        std::size_t index = findIndex(key);
+        if (index == size()) {
+            return 0;
+        }
+        auto offset = static_cast<std::ptrdiff_t>(index);
+        prefixes.erase(prefixes.begin() + offset);
+        keys.erase(keys.begin() + offset);
+        values.erase(values.begin() + offset);
+        if (keys.empty()) {
+            sharedLength = 0;
+        }
+        return 1;
+    }
+
+    // Looks up queries[0..count) and stores each position in results, or
+    // size() for a missing key. Batches of lookups walk the search steps
+    // together and prefetch the following step of every lookup.
+    template <typename K>
+    void findAll(const K* queries, std::size_t count, std::size_t* results) const {
+        constexpr std::size_t batch = 16;
+        for (std::size_t first = 0; first < count; first += batch) {
+            std::size_t lanes = std::min(batch, count - first);
+            std::int64_t targets[batch];
+            const std::int64_t* bases[batch];
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                targets[lane] = prefixOf(queries[first + lane]);
+                bases[lane] = prefixes.data();
+            }
+
+            // Every lookup shrinks its window by the same amount per step
+            for (std::size_t n = size(); n > flat_map::window;) {
+                std::size_t half = n / 2;
+                std::size_t nextHalf = (n - half) / 2;
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    const std::int64_t* base = bases[lane][half] < targets[lane] ? bases[lane] + half : bases[lane];
+                    __builtin_prefetch(base + nextHalf);
+                    bases[lane] = base;
+                }
+                n -= half;
+            }
+
+            std::size_t positions[batch];
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                std::size_t offset = static_cast<std::size_t>(bases[lane] - prefixes.data());
+                positions[lane] =
+                    offset + flat_map::countBelow(bases[lane], std::min(flat_map::window, size() - offset), targets[lane]);
+                __builtin_prefetch(keys.data() + std::min(positions[lane], size()));
+            }
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                const K& key = queries[first + lane];
+                std::size_t position = keyLowerBound(key, targets[lane], positions[lane]);
+                results[first + lane] = position < size() && keys[position] == key ? position : size();
+            }
+        }
+    }
+
+    // The value at a position findAll() returned
+    const Value& valueAt(std::size_t position) const { return values[position]; }
+};
@@ -0,0 +1,481 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include "bench.h"
+
+/**
+ * Incrementally Maintained Grade Leaderboard
+ *
+ * This example demonstrates:
+ * - An order-statistics tree: a treap whose nodes also store the size of
+ *   their subtree, so rank and "k-th best" queries take O(log n)
+ * - Top-K and range-by-score queries in O(log n + k)
+ * - Keeping the index up to date through an observer that Student
+ *   notifies from addGrade (the same pattern as spatial_grid.cpp)
+ * - A benchmark: polling the top 100 while grades stream in, compared
+ *   with recomputing every average and sorting the whole set per poll
+ *
+ * Usage: ./perf_grade_leaderboard [studentCount] [gradeUpdates] [updatesPerPoll]
+ *        (default: 100000 1000000 10000)
+ */
+
+class Student;
+
+// Implemented by anything that must follow a student's grades (e.g. an index)
+class GradeObserver {
+public:
+    virtual ~GradeObserver() = default;
+    virtual void gradesChanged(Student& student) = 0;
+    virtual void studentDestroyed(Student& student) = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Student from src/oop/classes.cpp (without logging) with an observer hook
+// ---------------------------------------------------------------------------
+
+class Student {
+private:
+    std::string name;
+    int age;
+    std::vector<double> grades;
+
+    GradeObserver* observer = nullptr;
+    std::int32_t boardNode = -1;  // Node inside the observing leaderboard
+
+    friend class Leaderboard;
+
+public:
+    Student(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+
+    // Copies would share the observer registration, so forbid them
+    Student(const Student&) = delete;
+    Student& operator=(const Student&) = delete;
+
+    ~Student() {
+        if (observer) {
+            observer->studentDestroyed(*this);
+        }
+    }
+
+    void addGrade(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            grades.push_back(grade);
+            if (observer) {
+                observer->gradesChanged(*this);
+            }
+        }
+    }
+
+    double getAverageGrade() const {
+        if (grades.empty()) {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (double grade : grades) {
+            sum += grade;
+        }
+        return sum / grades.size();
+    }
+
+    std::string getName() const { return name; }
+    int getAge() const { return age; }
+};
+
+// ---------------------------------------------------------------------------
+// Leaderboard: order-statistics treap keyed on average grade
+//
+// Rank 0 is the best student. Students with equal averages are ordered by
+// the time they joined the leaderboard. Nodes live in one vector and link
+// to each other by index; freed nodes are reused.
+// ---------------------------------------------------------------------------
+
+struct Standing {
+    Student* student;
+    double average;
+};
+
+class Leaderboard : public GradeObserver {
+private:
+    struct Node {
+        double average;
+        std::uint64_t sequence;  // Tie-breaker: insertion order
+        Student* student;
+        std::int32_t left = -1;
+        std::int32_t right = -1;
+        std::uint32_t size = 1;
+        std::uint32_t priority;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::int32_t> freeNodes;
+    std::int32_t root = -1;
+    std::uint64_t nextSequence = 0;
+    std::uint32_t randomState = 0x9E3779B9u;
+
+    std::uint32_t nextPriority() {
+        // xorshift32: cheap, good enough to keep the treap balanced
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
+
+    std::uint32_t sizeOf(std::int32_t t) const { return t < 0 ? 0 : nodes[t].size; }
+
+    void update(std::int32_t t) { nodes[t].size = 1 + sizeOf(nodes[t].left) + sizeOf(nodes[t].right); }
+
+    // True if a ranks ahead of b
+    static bool ranksBefore(double averageA, std::uint64_t sequenceA, double averageB, std::uint64_t sequenceB) {
+        return averageA > averageB || (averageA == averageB && sequenceA < sequenceB);
+    }
+
+    // Splits t into the nodes ranking before (average, sequence) and the rest
+    void split(std::int32_t t, double average, std::uint64_t sequence, std::int32_t& before, std::int32_t& rest) {
+        if (t < 0) {
+            before = rest = -1;
+            return;
+        }
+        if (ranksBefore(nodes[t].average, nodes[t].sequence, average, sequence)) {
+            split(nodes[t].right, average, sequence, nodes[t].right, rest);
+            before = t;
+        } else {
+            split(nodes[t].left, average, sequence, before, nodes[t].left);
+            rest = t;
+        }
+        update(t);
+    }
+
+    // Joins two treaps where every node of a ranks before every node of b
+    std::int32_t merge(std::int32_t a, std::int32_t b) {
+        if (a < 0 || b < 0) {
+            return a < 0 ? b : a;
+        }
+        if (nodes[a].priority > nodes[b].priority) {
+            nodes[a].right = merge(nodes[a].right, b);
+            update(a);
+            return a;
+        }
+        nodes[b].left = merge(a, nodes[b].left);
+        update(b);
+        return b;
+    }
+
+    bool nodeRanksBefore(std::int32_t a, std::int32_t b) const {
+        return ranksBefore(nodes[a].average, nodes[a].sequence, nodes[b].average, nodes[b].sequence);
+    }
+
+    // Treap insertion: walk down while the existing nodes have higher
+    // priority, then split the remaining subtree around the new node
+    void link(std::int32_t node) {
+        std::int32_t* slot = &root;
+        while (*slot >= 0 && nodes[*slot].priority > nodes[node].priority) {
+            ++nodes[*slot].size;
+            slot = nodeRanksBefore(node, *slot) ? &nodes[*slot].left : &nodes[*slot].right;
+        }
+        split(*slot, nodes[node].average, nodes[node].sequence, nodes[node].left, nodes[node].right);
+        update(node);
+        *slot = node;
+    }
+
+    // Treap removal: find the node, then replace it by its merged children
+    void unlink(std::int32_t node) {
+        std::int32_t* slot = &root;
+        while (*slot != node) {
+            --nodes[*slot].size;
+            slot = nodeRanksBefore(node, *slot) ? &nodes[*slot].left : &nodes[*slot].right;
+        }
+        *slot = merge(nodes[node].left, nodes[node].right);
+        nodes[node].left = nodes[node].right = -1;
+        nodes[node].size = 1;
+    }
+
+    // In-order walk that skips `skip` nodes and then appends up to `remaining`
+    void collect(std::int32_t t, std::uint32_t skip, std::size_t& remaining, std::vector<Standing>& out) const {
+        if (t < 0 || remaining == 0) {
+            return;
+        }
+        std::uint32_t leftSize = sizeOf(nodes[t].left);
+        if (skip < leftSize) {
+            collect(nodes[t].left, skip, remaining, out);
+        }
+        if (skip <= leftSize && remaining > 0) {
+            out.push_back({nodes[t].student, nodes[t].average});
+            --remaining;
+        }
+        collect(nodes[t].right, skip > leftSize ? skip - leftSize - 1 : 0, remaining, out);
+    }
+
+    // Number of students whose average is above `score` (or at least
+    // `score` when inclusive is set)
+    std::size_t countAbove(double score, bool inclusive) const {
+        std::size_t count = 0;
+        for (std::int32_t t = root; t >= 0;) {
+            bool above = inclusive ? nodes[t].average >= score : nodes[t].average > score;
+            if (above) {
+                count += sizeOf(nodes[t].left) + 1;
+                t = nodes[t].right;
+            } else {
+                t = nodes[t].left;
+            }
+        }
+        return count;
+    }
+
+public:
+    Leaderboard() = default;
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    ~Leaderboard() {
+        for (Node& node : nodes) {
+            if (node.student && node.student->observer == this) {
+                node.student->observer = nullptr;
+                node.student->boardNode = -1;
+            }
+        }
+    }
+
+    void insert(Student& student) {
+        if (student.observer == this) {
+            return;
+        }
+        std::int32_t node;
+        if (!freeNodes.empty()) {
+            node = freeNodes.back();
+            freeNodes.pop_back();
+        } else {
+            node = static_cast<std::int32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        nodes[node] = Node{student.getAverageGrade(), nextSequence++, &student, -1, -1, 1, nextPriority()};
+        student.observer = this;
+        student.boardNode = node;
+        link(node);
+    }
+
+    void remove(Student& student) {
+        if (student.observer != this) {
+            return;
+        }
+        std::int32_t node = student.boardNode;
+        unlink(node);
+        nodes[node].student = nullptr;
+        freeNodes.push_back(node);
+        student.observer = nullptr;
+        student.boardNode = -1;
+    }
+
+    void gradesChanged(Student& student) override {
+        Node& node = nodes[student.boardNode];
+        double average = student.getAverageGrade();
+        if (average != node.average) {
+            unlink(student.boardNode);
+            node.average = average;
+            link(student.boardNode);
+        }
+    }
+
+    void studentDestroyed(Student& student) override {
+        remove(student);
+    }
+
+    std::size_t size() const { return sizeOf(root); }
+
+    // 0-based position of a tracked student (0 = best)
+    std::size_t rank(const Student& student) const {
+        const Node& key = nodes[student.boardNode];
+        std::size_t count = 0;
+        for (std::int32_t t = root; t >= 0;) {
+            if (ranksBefore(nodes[t].average, nodes[t].sequence, key.average, key.sequence)) {
+                count += sizeOf(nodes[t].left) + 1;
+                t = nodes[t].right;
+            } else {
+                t = nodes[t].left;
+            }
+        }
+        return count;
+    }
+
+    // `count` standings starting at rank `first`
+    std::vector<Standing> standings(std::size_t first, std::size_t count) const {
+        std::vector<Standing> out;
+        if (first < size()) {
+            count = std::min(count, size() - first);
+            out.reserve(count);
+            collect(root, static_cast<std::uint32_t>(first), count, out);
+        }
+        return out;
+    }
+
+    std::vector<Standing> top(std::size_t k) const { return standings(0, k); }
+
+    // Every student with minScore <= average <= maxScore, best first
+    std::vector<Standing> range(double minScore, double maxScore) const {
+        std::size_t first = countAbove(maxScore, false);
+        std::size_t last = countAbove(minScore, true);
+        return last > first ? standings(first, last - first) : std::vector<Standing>();
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void printStandings(const std::vector<Standing>& standings) {
+    for (const Standing& standing : standings) {
+        std::cout << "  " << std::left << std::setw(8) << standing.student->getName() << std::right
+                  << " " << standing.average << std::endl;
+    }
+}
+
+void demonstrateLeaderboard() {
+    std::cout << "1. Leaderboard updated by addGrade:" << std::endl;
+    std::deque<Student> students;
+    Leaderboard board;
+    for (const char* name : {"Alice", "Bob", "Charlie", "Diana", "Eve"}) {
+        board.insert(students.emplace_back(name, 20));
+    }
+    students[0].addGrade(85.5);
+    students[0].addGrade(92.0);
+    students[1].addGrade(78.0);
+    students[2].addGrade(95.0);
+    students[3].addGrade(88.0);
+    students[4].addGrade(88.0);
+    std::cout << "  Top 3:" << std::endl;
+    printStandings(board.top(3));
+
+    students[1].addGrade(100.0);
+    students[1].addGrade(100.0);
+    std::cout << "  Bob after two perfect grades is at rank " << board.rank(students[1]) << " of "
+              << board.size() << std::endl;
+
+    std::cout << "  Averages between 85 and 90:" << std::endl;
+    printStandings(board.range(85.0, 90.0));
+
+    students.pop_front();  // Alice's destructor removes her from the board
+    std::cout << "  After Alice leaves, size " << board.size() << ", leader "
+              << board.top(1).front().student->getName() << std::endl;
+    std::cout << std::endl;
+}
+
+// The reference approach: average every student and sort the whole set
+std::vector<Standing> sortedTop(std::deque<Student>& students, std::size_t k) {
+    std::vector<std::pair<Standing, std::size_t>> all;
+    all.reserve(students.size());
+    for (std::size_t i = 0; i < students.size(); ++i) {
+        all.push_back({{&students[i], students[i].getAverageGrade()}, i});
+    }
+    std::sort(all.begin(), all.end(), [](const auto& a, const auto& b) {
+        return a.first.average > b.first.average || (a.first.average == b.first.average && a.second < b.second);
+    });
+    std::vector<Standing> top;
+    for (std::size_t i = 0; i < std::min(k, all.size()); ++i) {
+        top.push_back(all[i].first);
+    }
+    return top;
+}
+
+// Compares top lists taken from two separate student sets (names are unique)
+bool sameStandings(const std::vector<Standing>& a, const std::vector<Standing>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Standing& x, const Standing& y) {
+        return x.student->getName() == y.student->getName() && x.average == y.average;
+    });
+}
+
+void benchmark(std::size_t studentCount, std::size_t updates, std::size_t updatesPerPoll) {
+    std::cout << "2. Streaming " << updates << " grades into " << studentCount << " students, polling the top 100 every "
+              << updatesPerPoll << " grades:" << std::endl;
+
+    std::mt19937 rng(12);
+    std::uniform_int_distribution<std::size_t> pickStudent(0, studentCount - 1);
+    std::uniform_int_distribution<int> pickGrade(0, 200);
+    std::vector<std::pair<std::size_t, double>> stream(updates);
+    for (auto& [student, grade] : stream) {
+        student = pickStudent(rng);
+        grade = pickGrade(rng) / 2.0;
+    }
+
+    std::vector<double> firstGrades(studentCount);
+    for (double& grade : firstGrades) {
+        grade = pickGrade(rng) / 2.0;
+    }
+    auto makeStudents = [&](std::deque<Student>& students) {
+        for (std::size_t i = 0; i < studentCount; ++i) {
+            students.emplace_back("Student" + std::to_string(i), 20).addGrade(firstGrades[i]);
+        }
+    };
+
+    // Full sort per poll
+    std::vector<std::vector<Standing>> sortedPolls;
+    std::deque<Student> sortedStudents;
+    makeStudents(sortedStudents);
+    double sortUpdateMs = 0, sortPollMs = 0;
+    for (std::size_t begin = 0; begin < updates; begin += updatesPerPoll) {
+        std::size_t end = std::min(updates, begin + updatesPerPoll);
+        sortUpdateMs += bench::timeMs([&] {
+            for (std::size_t i = begin; i < end; ++i) {
+                sortedStudents[stream[i].first].addGrade(stream[i].second);
+            }
+        });
+        sortPollMs += bench::timeMs([&] { sortedPolls.push_back(sortedTop(sortedStudents, 100)); });
+    }
+
+    // Leaderboard maintained incrementally
+    std::vector<std::vector<Standing>> boardPolls;
+    std::deque<Student> boardStudents;
+    Leaderboard board;
+    makeStudents(boardStudents);
+    double insertMs = bench::timeMs([&] {
+        for (Student& student : boardStudents) {
+            board.insert(student);
+        }
+    });
+    double boardUpdateMs = 0, boardPollMs = 0;
+    for (std::size_t begin = 0; begin < updates; begin += updatesPerPoll) {
+        std::size_t end = std::min(updates, begin + updatesPerPoll);
+        boardUpdateMs += bench::timeMs([&] {
+            for (std::size_t i = begin; i < end; ++i) {
+                boardStudents[stream[i].first].addGrade(stream[i].second);
+            }
+        });
+        boardPollMs += bench::timeMs([&] { boardPolls.push_back(board.top(100)); });
+    }
+
+    bool match = sortedPolls.size() == boardPolls.size();
+    for (std::size_t p = 0; p < boardPolls.size() && match; ++p) {
+        match = sameStandings(sortedPolls[p], boardPolls[p]);
+    }
+
+    std::size_t polls = sortedPolls.size();
+    std::cout << "  Full sort per poll:   updates " << std::setw(9) << sortUpdateMs << " ms, polls " << std::setw(9)
+              << sortPollMs << " ms (" << sortPollMs / polls << " ms per poll)" << std::endl;
+    std::cout << "  Leaderboard:          updates " << std::setw(9) << boardUpdateMs << " ms, polls " << std::setw(9)
+              << boardPollMs << " ms (" << boardPollMs / polls << " ms per poll), initial insert " << insertMs
+              << " ms" << std::endl;
+    std::cout << "  Results match: " << (match ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Grade Leaderboard ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateLeaderboard();
+
+    std::size_t studentCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::size_t updates = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    std::size_t updatesPerPoll = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10000;
+    benchmark(std::max<std::size_t>(studentCount, 1), updates, std::max<std::size_t>(updatesPerPoll, 1));
+
+    std::cout << "=== End of Grade Leaderboard Example ===" << std::endl;
+
+    return 0;
+}
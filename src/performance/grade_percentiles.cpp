@@ -0,0 +1,329 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <thread>
+#include "bench.h"
+
+/**
+ * Streaming Percentiles for Grade Distributions
+ *
+ * This example demonstrates:
+ * - A fixed-bin histogram sketch: grades are limited to [0, 100] by
+ *   Student::addGrade, so a fixed set of bins covers every possible value
+ * - Quantile queries (p50/p90/p99) in O(bins), independent of how many
+ *   grades were recorded, with a documented error bound
+ * - Merging sketches, and per-thread shards that are merged on read
+ * - Accuracy and throughput compared with exact std::nth_element
+ *
+ * Usage: ./perf_grade_percentiles [gradeCount]   (default: 10000000)
+ */
+
+// ---------------------------------------------------------------------------
+// GradeHistogram
+//
+// Bin i (for i < 100 * binsPerPoint) counts grades in
+// [i / binsPerPoint, (i + 1) / binsPerPoint); the last bin holds exactly 100.
+//
+// quantile(q) answers the same question as sorting all n grades and taking
+// the element at index floor(q * (n - 1)): it finds the bin that contains
+// that element and returns the bin's midpoint (clamped to the observed
+// minimum and maximum). The exact element lies in the same bin, so
+//
+//     |quantile(q) - exact| <= 0.5 / binsPerPoint
+//
+// e.g. at most 0.005 grade points with the default 100 bins per point.
+// Memory is 8 bytes per bin (80 KB by default) whatever the grade count.
+// ---------------------------------------------------------------------------
+
+class GradeHistogram {
+private:
+    int binsPerPoint;
+    std::vector<std::uint64_t> bins;
+    std::uint64_t total = 0;
+    double minimum = 100.0;
+    double maximum = 0.0;
+
+    friend class ConcurrentGradeHistogram;
+
+public:
+    explicit GradeHistogram(int resolution = 100)
+        : binsPerPoint(resolution), bins(static_cast<std::size_t>(100 * resolution) + 1, 0) {}
+
+    std::size_t binOf(double grade) const {
+        return std::min(static_cast<std::size_t>(grade * binsPerPoint), bins.size() - 1);
+    }
+
+    // Same validation as Student::addGrade: out-of-range grades are ignored
+    void add(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            ++bins[binOf(grade)];
+            ++total;
+            minimum = std::min(minimum, grade);
+            maximum = std::max(maximum, grade);
+        }
+    }
+
+    // Combines another sketch with the same resolution into this one
+    void merge(const GradeHistogram& other) {
+        for (std::size_t i = 0; i < bins.size(); ++i) {
+            bins[i] += other.bins[i];
+        }
+        total += other.total;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+    }
+
+    std::uint64_t count() const { return total; }
+    std::size_t binCount() const { return bins.size(); }
+    double errorBound() const { return 0.5 / binsPerPoint; }
+
+    double quantile(double q) const {
+        if (total == 0) {
+            return 0.0;
+        }
+        q = std::clamp(q, 0.0, 1.0);
+        auto target = static_cast<std::uint64_t>(q * static_cast<double>(total - 1));
+        std::uint64_t seen = 0;
+        std::size_t bin = 0;
+        for (; bin < bins.size() - 1; ++bin) {
+            seen += bins[bin];
+            if (seen > target) {
+                break;
+            }
+        }
+        double midpoint = bin == bins.size() - 1 ? 100.0 : (bin + 0.5) / binsPerPoint;
+        // A snapshot taken while writers run can see counted bins before the
+        // shard's min/max were updated; std::clamp requires minimum <= maximum
+        if (minimum > maximum) {
+            return midpoint;
+        }
+        return std::clamp(midpoint, minimum, maximum);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// ConcurrentGradeHistogram
+//
+// Every writer thread gets its own shard and is its only writer, so
+// recording a grade is a plain (relaxed atomic) load and store with no
+// contention. snapshot() merges the shards into a GradeHistogram; it may
+// run while writers are active and then sees each shard at some recent
+// point, which is what a continuously polled dashboard wants.
+// ---------------------------------------------------------------------------
+
+class ConcurrentGradeHistogram {
+public:
+    class Shard {
+    private:
+        int binsPerPoint;
+        std::size_t binCount;
+        std::unique_ptr<std::atomic<std::uint64_t>[]> bins;
+        std::atomic<double> minimum{100.0};
+        std::atomic<double> maximum{0.0};
+
+        friend class ConcurrentGradeHistogram;
+
+        static void bump(std::atomic<std::uint64_t>& counter) {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+    public:
+        explicit Shard(int resolution)
+            : binsPerPoint(resolution), binCount(static_cast<std::size_t>(100 * resolution) + 1),
+              bins(new std::atomic<std::uint64_t>[binCount]) {
+            for (std::size_t i = 0; i < binCount; ++i) {
+                bins[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        // Must only be called by the thread that owns this shard
+        void add(double grade) {
+            if (grade >= 0.0 && grade <= 100.0) {
+                bump(bins[std::min(static_cast<std::size_t>(grade * binsPerPoint), binCount - 1)]);
+                if (grade < minimum.load(std::memory_order_relaxed)) {
+                    minimum.store(grade, std::memory_order_relaxed);
+                }
+                if (grade > maximum.load(std::memory_order_relaxed)) {
+                    maximum.store(grade, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+private:
+    int binsPerPoint;
+    mutable std::mutex mutex;
+    std::deque<Shard> shards;  // deque: adding a shard never moves the others
+
+public:
+    explicit ConcurrentGradeHistogram(int resolution = 100) : binsPerPoint(resolution) {}
+
+    // Call once per writer thread and keep the reference
+    Shard& addShard() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return shards.emplace_back(binsPerPoint);
+    }
+
+    GradeHistogram snapshot() const {
+        GradeHistogram merged(binsPerPoint);
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const Shard& shard : shards) {
+            for (std::size_t i = 0; i < merged.bins.size(); ++i) {
+                std::uint64_t count = shard.bins[i].load(std::memory_order_relaxed);
+                merged.bins[i] += count;
+                merged.total += count;
+            }
+            merged.minimum = std::min(merged.minimum, shard.minimum.load(std::memory_order_relaxed));
+            merged.maximum = std::max(merged.maximum, shard.maximum.load(std::memory_order_relaxed));
+        }
+        return merged;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+// Exact quantile with the same rank definition as GradeHistogram::quantile
+double exactQuantile(std::vector<double>& grades, double q) {
+    auto target = grades.begin() + static_cast<std::ptrdiff_t>(q * static_cast<double>(grades.size() - 1));
+    std::nth_element(grades.begin(), target, grades.end());
+    return *target;
+}
+
+// Exam-like grades: most around 75, a tail of weak results, arbitrary decimals
+std::vector<double> makeGrades(std::size_t count, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> typical(75.0, 10.0);
+    std::uniform_real_distribution<double> weak(0.0, 60.0);
+    std::bernoulli_distribution isWeak(0.1);
+    std::vector<double> grades(count);
+    for (double& grade : grades) {
+        grade = std::clamp(isWeak(rng) ? weak(rng) : typical(rng), 0.0, 100.0);
+    }
+    return grades;
+}
+
+void demonstrateSketch() {
+    std::cout << "1. Percentiles of a small class:" << std::endl;
+    GradeHistogram morning, afternoon;
+    for (double grade : {85.5, 92.0, 78.5, 88.0, 91.5}) {
+        morning.add(grade);
+    }
+    for (double grade : {95.0, 87.0, 150.0, 67.25}) {  // 150 is ignored, as in addGrade
+        afternoon.add(grade);
+    }
+    GradeHistogram all = morning;
+    all.merge(afternoon);
+    std::cout << "  " << all.count() << " grades, p50 " << all.quantile(0.5) << ", p90 " << all.quantile(0.9)
+              << ", max " << all.quantile(1.0) << " (error bound +/- " << all.errorBound() << ")" << std::endl;
+    std::cout << std::endl;
+}
+
+void benchmark(std::size_t gradeCount) {
+    const double quantiles[] = {0.5, 0.9, 0.99};
+    std::vector<double> grades = makeGrades(gradeCount, 13);
+
+    std::cout << "2. Accuracy over " << gradeCount << " grades:" << std::endl;
+    GradeHistogram sketch;
+    double sketchAddMs = bench::timeMs([&] {
+        for (double grade : grades) {
+            sketch.add(grade);
+        }
+    });
+    std::vector<double> collected;
+    double collectMs = bench::timeMs([&] {
+        for (double grade : grades) {
+            collected.push_back(grade);
+        }
+    });
+
+    bool withinBound = true;
+    double exactQueryMs = 0, sketchQueryMs = 0;
+    for (double q : quantiles) {
+        double exact = 0, estimate = 0;
+        exactQueryMs += bench::timeMs([&] { exact = exactQuantile(collected, q); });
+        sketchQueryMs += bench::timeMs([&] { estimate = sketch.quantile(q); });
+        double error = std::abs(estimate - exact);
+        withinBound = withinBound && error <= sketch.errorBound() + 1e-12;
+        std::cout << "  p" << std::setw(2) << std::left << q * 100 << std::right << "  exact " << std::setw(9)
+                  << exact << "  sketch " << std::setw(9) << estimate << "  error " << error << std::endl;
+    }
+    std::cout << "  All errors within +/- " << sketch.errorBound() << ": " << (withinBound ? "Yes" : "No")
+              << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "3. Throughput (single thread):" << std::endl;
+    std::cout << "  Record:   sketch " << sketchAddMs << " ms, collect into std::vector " << collectMs << " ms"
+              << std::endl;
+    std::cout << "  Query p50/p90/p99: sketch " << sketchQueryMs << " ms, nth_element " << exactQueryMs << " ms"
+              << std::endl;
+    std::cout << "  Memory:   sketch " << sketch.binCount() * sizeof(std::uint64_t) / 1024 << " KB, vector "
+              << collected.capacity() * sizeof(double) / (1024 * 1024) << " MB" << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "4. Per-thread shards merged on read:" << std::endl;
+    for (unsigned threads : {1u, 2u, 4u}) {
+        ConcurrentGradeHistogram concurrent;
+        std::atomic<bool> done{false};
+        std::size_t polls = 0;
+        double ms = bench::timeMs([&] {
+            std::vector<std::thread> writers;
+            for (unsigned t = 0; t < threads; ++t) {
+                writers.emplace_back([&, t] {
+                    ConcurrentGradeHistogram::Shard& shard = concurrent.addShard();
+                    for (std::size_t i = t; i < grades.size(); i += threads) {
+                        shard.add(grades[i]);
+                    }
+                });
+            }
+            // A dashboard polling p99 while the writers run
+            std::thread reader([&] {
+                while (!done.load()) {
+                    concurrent.snapshot().quantile(0.99);
+                    ++polls;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+            });
+            for (std::thread& writer : writers) {
+                writer.join();
+            }
+            done = true;
+            reader.join();
+        });
+        GradeHistogram merged = concurrent.snapshot();
+        bool same = merged.count() == sketch.count();
+        for (double q : quantiles) {
+            same = same && merged.quantile(q) == sketch.quantile(q);
+        }
+        std::cout << "  " << threads << " writer threads: " << ms << " ms, " << polls
+                  << " polls during ingest, final result matches single-threaded sketch: " << (same ? "Yes" : "No")
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Streaming Grade Percentiles ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateSketch();
+
+    std::size_t gradeCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    benchmark(std::max<std::size_t>(gradeCount, 1));
+
+    std::cout << "=== End of Grade Percentiles Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,319 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include "bench.h"
+
+/**
+ * Columnar Gradebook
+ *
+ * This example demonstrates:
+ * - Columnar storage: one array per field instead of one object per student
+ * - Keeping every student's grades in a single contiguous buffer,
+ *   addressed through per-student offsets
+ * - Running sums and counts, so an average is O(1) instead of O(grades)
+ * - Batch APIs that compute all averages in one vectorizable pass
+ * - A benchmark against Student::getAverageGrade from classes.cpp
+ *
+ * Usage: ./perf_gradebook [studentCount] [polls]   (default: 1000000 20)
+ */
+
+// ---------------------------------------------------------------------------
+// Reference: the Student class from src/oop/classes.cpp (without logging)
+// ---------------------------------------------------------------------------
+
+class Student {
+private:
+    std::string name;
+    int age;
+    std::vector<double> grades;
+
+public:
+    Student(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+
+    void addGrade(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            grades.push_back(grade);
+        }
+    }
+
+    // Re-sums every grade on every call
+    double getAverageGrade() const {
+        if (grades.empty()) {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (double grade : grades) {
+            sum += grade;
+        }
+        return sum / grades.size();
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Gradebook
+// ---------------------------------------------------------------------------
+
+using StudentId = std::uint32_t;
+
+class Gradebook {
+private:
+    // Student columns (index = StudentId)
+    std::vector<std::string> names;
+    std::vector<int> ages;
+    std::vector<std::uint32_t> offsets;     // Start of the student's segment in gradeBuffer
+    std::vector<std::uint32_t> capacities;  // Reserved slots in that segment
+    std::vector<double> counts;             // Number of grades (double, so averages vectorize)
+    std::vector<double> sums;               // Running sum, added in insertion order
+
+    // All grades of all students, segment after segment
+    std::vector<double> gradeBuffer;
+    std::size_t unusedSlots = 0;  // Slots left behind by relocated segments
+
+    static constexpr std::uint32_t initialCapacity = 4;
+
+    // Moves a full segment to the end of the buffer with twice the room
+    void growSegment(StudentId id) {
+        std::uint32_t count = static_cast<std::uint32_t>(counts[id]);
+        std::uint32_t newCapacity = std::max(initialCapacity, capacities[id] * 2);
+        std::uint32_t newOffset = static_cast<std::uint32_t>(gradeBuffer.size());
+        gradeBuffer.resize(gradeBuffer.size() + newCapacity);
+        std::copy_n(gradeBuffer.begin() + offsets[id], count, gradeBuffer.begin() + newOffset);
+        unusedSlots += capacities[id];
+        offsets[id] = newOffset;
+        capacities[id] = newCapacity;
+        if (unusedSlots > gradeBuffer.size() / 2) {
+            compact();
+        }
+    }
+
+public:
+    void reserve(std::size_t studentCount, std::size_t gradesPerStudent) {
+        names.reserve(studentCount);
+        ages.reserve(studentCount);
+        offsets.reserve(studentCount);
+        capacities.reserve(studentCount);
+        counts.reserve(studentCount);
+        sums.reserve(studentCount);
+        gradeBuffer.reserve(studentCount * std::max<std::size_t>(gradesPerStudent, initialCapacity));
+    }
+
+    StudentId addStudent(const std::string& name, int age) {
+        StudentId id = static_cast<StudentId>(names.size());
+        names.push_back(name);
+        ages.push_back(age);
+        offsets.push_back(static_cast<std::uint32_t>(gradeBuffer.size()));
+        capacities.push_back(initialCapacity);
+        counts.push_back(0.0);
+        sums.push_back(0.0);
+        gradeBuffer.resize(gradeBuffer.size() + initialCapacity);
+        return id;
+    }
+
+    // Same validation as Student::addGrade
+    void addGrade(StudentId id, double grade) {
+        if (grade < 0.0 || grade > 100.0) {
+            return;
+        }
+        if (counts[id] == capacities[id]) {
+            growSegment(id);
+        }
+        gradeBuffer[offsets[id] + static_cast<std::uint32_t>(counts[id])] = grade;
+        counts[id] += 1.0;
+        sums[id] += grade;
+    }
+
+    // O(1). Bit-identical to Student::getAverageGrade, because the running
+    // sum adds the grades in the same order as the loop there.
+    double getAverageGrade(StudentId id) const {
+        return counts[id] == 0.0 ? 0.0 : sums[id] / counts[id];
+    }
+
+    // All averages in one branch-free pass (the compiler vectorizes it)
+    void computeAverages(std::vector<double>& averages) const {
+        std::size_t n = sums.size();
+        averages.resize(n);
+        const double* s = sums.data();
+        const double* c = counts.data();
+        double* out = averages.data();
+        for (std::size_t i = 0; i < n; ++i) {
+            // Empty students have sum 0, so dividing by 1 yields 0
+            out[i] = s[i] / std::max(c[i], 1.0);
+        }
+    }
+
+    // Rebuilds the running sums from the grade buffer (one sequential pass)
+    void recomputeSums() {
+        for (std::size_t id = 0; id < sums.size(); ++id) {
+            double sum = 0.0;
+            const double* grades = gradeBuffer.data() + offsets[id];
+            for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(counts[id]); ++i) {
+                sum += grades[i];
+            }
+            sums[id] = sum;
+        }
+    }
+
+    // Rewrites the buffer without gaps, keeping each segment's capacity
+    void compact() {
+        std::vector<double> packed;
+        packed.reserve(gradeBuffer.size() - unusedSlots);
+        for (std::size_t id = 0; id < offsets.size(); ++id) {
+            std::uint32_t newOffset = static_cast<std::uint32_t>(packed.size());
+            auto segment = gradeBuffer.begin() + offsets[id];
+            packed.insert(packed.end(), segment, segment + capacities[id]);
+            offsets[id] = newOffset;
+        }
+        gradeBuffer.swap(packed);
+        unusedSlots = 0;
+    }
+
+    std::span<const double> grades(StudentId id) const {
+        return {gradeBuffer.data() + offsets[id], static_cast<std::size_t>(counts[id])};
+    }
+
+    const std::string& getName(StudentId id) const { return names[id]; }
+    int getAge(StudentId id) const { return ages[id]; }
+    std::size_t gradeCount(StudentId id) const { return static_cast<std::size_t>(counts[id]); }
+    std::size_t size() const { return names.size(); }
+    std::size_t bufferSize() const { return gradeBuffer.size(); }
+
+    void displayInfo(StudentId id) const {
+        std::cout << "  Student: " << names[id] << ", Age: " << ages[id];
+        if (counts[id] > 0.0) {
+            std::cout << ", Average Grade: " << getAverageGrade(id);
+        }
+        std::cout << std::endl;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void demonstrateGradebook() {
+    std::cout << "1. Adding students and grades:" << std::endl;
+    Gradebook book;
+    StudentId alice = book.addStudent("Alice", 20);
+    StudentId bob = book.addStudent("Bob", 22);
+    StudentId charlie = book.addStudent("Charlie", 19);
+    book.addGrade(alice, 85.5);
+    book.addGrade(alice, 92.0);
+    book.addGrade(alice, 78.5);
+    book.addGrade(bob, 95.0);
+    book.addGrade(bob, 88.0);
+    book.addGrade(bob, 150.0);  // Rejected, same as Student::addGrade
+    book.displayInfo(alice);
+    book.displayInfo(bob);
+    book.displayInfo(charlie);
+    std::cout << std::endl;
+
+    std::cout << "2. Growing a segment past its initial capacity:" << std::endl;
+    for (int i = 0; i < 6; ++i) {
+        book.addGrade(charlie, 70.0 + i);
+    }
+    std::cout << "  Charlie's grades:";
+    for (double grade : book.grades(charlie)) {
+        std::cout << " " << grade;
+    }
+    std::cout << std::endl;
+    std::cout << "  Buffer slots before compact: " << book.bufferSize() << std::endl;
+    book.compact();
+    std::cout << "  Buffer slots after compact: " << book.bufferSize() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "3. All averages in one pass:" << std::endl;
+    std::vector<double> averages;
+    book.computeAverages(averages);
+    for (StudentId id = 0; id < book.size(); ++id) {
+        std::cout << "  " << book.getName(id) << ": " << averages[id] << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void benchmarkGradebook(std::size_t studentCount, int polls) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> gradeCountDist(1, 10);
+    std::uniform_real_distribution<double> gradeDist(0.0, 100.0);
+
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    Gradebook book;
+    book.reserve(studentCount, 6);
+    for (std::size_t i = 0; i < studentCount; ++i) {
+        students.emplace_back("s", 20);
+        StudentId id = book.addStudent("s", 20);
+        int gradeCount = gradeCountDist(rng);
+        for (int g = 0; g < gradeCount; ++g) {
+            double grade = gradeDist(rng);
+            students.back().addGrade(grade);
+            book.addGrade(id, grade);
+        }
+    }
+
+    std::vector<double> studentAverages(studentCount), bookAverages;
+    double studentMs = bench::timeMs([&] {
+        for (int poll = 0; poll < polls; ++poll) {
+            for (std::size_t i = 0; i < studentCount; ++i) {
+                studentAverages[i] = students[i].getAverageGrade();
+            }
+        }
+    });
+    double bookMs = bench::timeMs([&] {
+        for (int poll = 0; poll < polls; ++poll) {
+            book.computeAverages(bookAverages);
+        }
+    });
+
+    // Random single lookups, as a request handler would do
+    std::uniform_int_distribution<std::size_t> pick(0, studentCount - 1);
+    std::vector<std::size_t> lookups(studentCount);
+    for (std::size_t& index : lookups) {
+        index = pick(rng);
+    }
+    double checksumStudent = 0, checksumBook = 0;
+    double studentLookupMs = bench::timeMs([&] {
+        for (std::size_t index : lookups) {
+            checksumStudent += students[index].getAverageGrade();
+        }
+    });
+    double bookLookupMs = bench::timeMs([&] {
+        for (std::size_t index : lookups) {
+            checksumBook += book.getAverageGrade(static_cast<StudentId>(index));
+        }
+    });
+
+    std::cout << "  " << studentCount << " students, 1-10 grades each" << std::endl;
+    std::cout << "  All averages x" << polls << ": Student " << studentMs << " ms, Gradebook "
+              << bookMs << " ms (x" << studentMs / bookMs << ")" << std::endl;
+    std::cout << "  " << studentCount << " random lookups: Student " << studentLookupMs
+              << " ms, Gradebook " << bookLookupMs << " ms (x" << studentLookupMs / bookLookupMs
+              << ")" << std::endl;
+    std::cout << "  Averages identical: "
+              << (studentAverages == bookAverages && checksumStudent == checksumBook ? "Yes" : "No")
+              << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Columnar Gradebook ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateGradebook();
+
+    std::size_t studentCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int polls = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::cout << "4. Benchmark:" << std::endl;
+    benchmarkGradebook(studentCount, polls);
+    std::cout << std::endl;
+
+    std::cout << "=== End of Gradebook Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,389 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <string_view>
+#include <unistd.h>
+#include "lifecycle_trace.h"
+#include "bench.h"
+
+/**
+ * Asynchronous Lifecycle Tracing
+ *
+ * This example demonstrates:
+ * - The cost of the lifecycle logging in classes.cpp, inheritance.cpp and
+ *   polymorphism.cpp: every constructor and destructor writes a line to
+ *   std::cout synchronously
+ * - The tracer from lifecycle_trace.h: per-thread lock-free ring buffers
+ *   of 32-byte binary events, drained into a file by a background thread
+ * - Rebuilding the original human-readable output offline from the file
+ * - The same classes in src/oop print through the tracer's echo function,
+ *   or trace when run with LIFECYCLE_TRACE=<file>
+ * - The compile-time switch: perf_lifecycle_trace_off is this program
+ *   built with LIFECYCLE_TRACE_ENABLED=0, where tracing compiles to nothing
+ *
+ * Usage: ./perf_lifecycle_trace [iterations] [threads]
+ *        (default: 200000, all hardware threads)
+ *        ./perf_lifecycle_trace --decode <trace file>
+ */
+
+// Echo function printing synchronously with std::endl, as the classes did
+// before the tracer; used as the baseline and as the expected output
+static std::ostream* printLifecycle = nullptr;
+static std::mutex printMutex;  // Keeps lines from several threads apart
+
+void printEvent(lifecycle::TypeId type, lifecycle::EventKind kind, std::string_view name) {
+    std::lock_guard<std::mutex> lock(printMutex);
+    lifecycle::writeLine(*printLifecycle, type, kind, name);
+    *printLifecycle << std::endl;
+}
+
+// Sends events that occur while the tracer is stopped to `out` (or nowhere)
+void printLifecycleTo(std::ostream* out) {
+    printLifecycle = out;
+    lifecycle::Tracer::setEcho(out ? printEvent : nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// Student from src/oop/classes.cpp, Animal hierarchy from
+// src/oop/inheritance.cpp and Shape hierarchy from src/oop/polymorphism.cpp,
+// logging through LIFECYCLE_TRACE exactly like the originals. The learning
+// modules are standalone programs, so the workload keeps its own copies.
+// ---------------------------------------------------------------------------
+
+class Student {
+private:
+    std::string name;
+    int age;
+    std::vector<double> grades;
+
+public:
+    Student() : name("Unknown"), age(0) { LIFECYCLE_TRACE(Student, DefaultConstructed, this, name); }
+
+    Student(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {
+        LIFECYCLE_TRACE(Student, Constructed, this, name);
+    }
+
+    Student(const Student& other) : name(other.name), age(other.age), grades(other.grades) {
+        LIFECYCLE_TRACE(Student, CopyConstructed, this, name);
+    }
+
+    Student(Student&& other) noexcept
+        : name(std::move(other.name)), age(other.age), grades(std::move(other.grades)) {
+        LIFECYCLE_TRACE(Student, MoveConstructed, this, name);
+    }
+
+    Student& operator=(const Student& other) {
+        if (this != &other) {
+            name = other.name;
+            age = other.age;
+            grades = other.grades;
+        }
+        LIFECYCLE_TRACE(Student, CopyAssigned, this, name);
+        return *this;
+    }
+
+    Student& operator=(Student&& other) noexcept {
+        if (this != &other) {
+            name = std::move(other.name);
+            age = other.age;
+            grades = std::move(other.grades);
+        }
+        LIFECYCLE_TRACE(Student, MoveAssigned, this, name);
+        return *this;
+    }
+
+    ~Student() { LIFECYCLE_TRACE(Student, Destroyed, this, name); }
+
+    void addGrade(double grade) {
+        if (grade >= 0 && grade <= 100) {
+            grades.push_back(grade);
+        }
+    }
+    std::string getName() const { return name; }
+};
+
+class Animal {
+protected:
+    std::string name;
+    int age;
+
+public:
+    Animal(const std::string& animalName, int animalAge) : name(animalName), age(animalAge) {
+        LIFECYCLE_TRACE(Animal, Constructed, this, name);
+    }
+    virtual ~Animal() { LIFECYCLE_TRACE(Animal, Destroyed, this, name); }
+    virtual void move() const = 0;
+};
+
+class Dog : public Animal {
+private:
+    std::string breed;
+
+public:
+    Dog(const std::string& dogName, int dogAge, const std::string& dogBreed)
+        : Animal(dogName, dogAge), breed(dogBreed) {
+        LIFECYCLE_TRACE(Dog, Constructed, this, name);
+    }
+    ~Dog() override { LIFECYCLE_TRACE(Dog, Destroyed, this, name); }
+    void move() const override {}
+};
+
+class Cat : public Animal {
+private:
+    bool isIndoor;
+
+public:
+    Cat(const std::string& catName, int catAge, bool indoor = true) : Animal(catName, catAge), isIndoor(indoor) {
+        LIFECYCLE_TRACE(Cat, Constructed, this, name);
+    }
+    ~Cat() override { LIFECYCLE_TRACE(Cat, Destroyed, this, name); }
+    void move() const override {}
+};
+
+class Bird : public Animal {
+private:
+    double wingspan;
+
+public:
+    Bird(const std::string& birdName, int birdAge, double birdWingspan)
+        : Animal(birdName, birdAge), wingspan(birdWingspan) {
+        LIFECYCLE_TRACE(Bird, Constructed, this, name);
+    }
+    ~Bird() override { LIFECYCLE_TRACE(Bird, Destroyed, this, name); }
+    void move() const override {}
+};
+
+class Shape {
+protected:
+    std::string name;
+    double x, y;
+
+public:
+    Shape(const std::string& shapeName, double posX = 0, double posY = 0) : name(shapeName), x(posX), y(posY) {
+        LIFECYCLE_TRACE(Shape, Constructed, this, name);
+    }
+    virtual ~Shape() { LIFECYCLE_TRACE(Shape, Destroyed, this, name); }
+    virtual double getArea() const = 0;
+};
+
+class Circle : public Shape {
+private:
+    double radius;
+
+public:
+    Circle(double r, double posX = 0, double posY = 0) : Shape("Circle", posX, posY), radius(r) {
+        LIFECYCLE_TRACE(Circle, Constructed, this, name);
+    }
+    ~Circle() override { LIFECYCLE_TRACE(Circle, Destroyed, this, name); }
+    double getArea() const override { return 3.14159 * radius * radius; }
+};
+
+class Rectangle : public Shape {
+private:
+    double width, height;
+
+public:
+    Rectangle(double w, double h, double posX = 0, double posY = 0)
+        : Shape("Rectangle", posX, posY), width(w), height(h) {
+        LIFECYCLE_TRACE(Rectangle, Constructed, this, name);
+    }
+    ~Rectangle() override { LIFECYCLE_TRACE(Rectangle, Destroyed, this, name); }
+    double getArea() const override { return width * height; }
+};
+
+class Triangle : public Shape {
+private:
+    double base, height;
+
+public:
+    Triangle(double b, double h, double posX = 0, double posY = 0)
+        : Shape("Triangle", posX, posY), base(b), height(h) {
+        LIFECYCLE_TRACE(Triangle, Constructed, this, name);
+    }
+    ~Triangle() override { LIFECYCLE_TRACE(Triangle, Destroyed, this, name); }
+    double getArea() const override { return 0.5 * base * height; }
+};
+
+// ---------------------------------------------------------------------------
+// Workload: the object churn of the three OOP examples
+// ---------------------------------------------------------------------------
+
+// Produces 33 lifecycle events; returns a value so the work is not removed
+double churn(int i) {
+    double sum = 0;
+    {
+        Student student("Alice", 20);
+        student.addGrade(85.5);
+        Student copy(student);
+        Student moved(std::move(copy));
+        Student defaulted;
+        defaulted = moved;
+        sum += static_cast<double>(moved.getName().size());
+    }
+    {
+        std::unique_ptr<Animal> animals[] = {std::make_unique<Dog>("Max", 4, "German Shepherd"),
+                                             std::make_unique<Cat>("Luna", 3, false),
+                                             std::make_unique<Bird>("Eagle", 2, 180.0)};
+        for (const auto& animal : animals) {
+            animal->move();
+        }
+    }
+    {
+        std::unique_ptr<Shape> shapes[] = {std::make_unique<Circle>(5.0 + i % 3),
+                                           std::make_unique<Rectangle>(4.0, 6.0),
+                                           std::make_unique<Triangle>(3.0, 4.0)};
+        for (const auto& shape : shapes) {
+            sum += shape->getArea();
+        }
+    }
+    return sum;
+}
+
+constexpr int eventsPerChurn = 33;
+
+// Unique per process, so concurrent runs do not overwrite each other
+std::string defaultTracePath() {
+    std::string name = "lifecycle-" + std::to_string(getpid()) + ".trace";
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void demonstrateTrace(const std::string& path) {
+    std::cout << "1. Trace one round and rebuild its output offline:" << std::endl;
+
+    if (!LIFECYCLE_TRACE_ENABLED) {
+        std::cout << "  Tracing is compiled out (LIFECYCLE_TRACE_ENABLED=0)" << std::endl;
+        std::cout << std::endl;
+        return;
+    }
+
+    std::ostringstream printed;
+    printLifecycleTo(&printed);
+    churn(0);
+    printLifecycleTo(nullptr);
+
+    lifecycle::Tracer::instance().start(path);
+    churn(0);
+    lifecycle::Tracer::Stats stats = lifecycle::Tracer::instance().stop();
+
+    std::vector<lifecycle::DecodedEvent> events = lifecycle::decodeTrace(path);
+    std::filesystem::remove(path);
+    std::ostringstream rebuilt;
+    for (const lifecycle::DecodedEvent& event : events) {
+        lifecycle::writeLine(rebuilt, event.type, event.kind, event.name);
+        rebuilt << '\n';
+    }
+    std::cout << "  " << events.size() << " events in " << stats.bytes << " bytes (" << path << ")" << std::endl;
+    std::istringstream firstLines(rebuilt.str());
+    std::string line;
+    for (int i = 0; i < 4 && std::getline(firstLines, line); ++i) {
+        std::cout << "  |" << line << std::endl;
+    }
+    std::cout << "  Rebuilt output matches synchronous printing: " << (rebuilt.str() == printed.str() ? "Yes" : "No")
+              << std::endl;
+    std::cout << std::endl;
+}
+
+double runChurn(int iterations, unsigned threads) {
+    std::vector<double> sums(threads);
+    double ms = bench::timeMs([&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < iterations; ++i) {
+                    sums[t] += churn(i);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    });
+    return ms;
+}
+
+void report(const std::string& label, double ms, double events) {
+    std::cout << "  " << std::left << std::setw(34) << label << std::right << std::setw(9) << ms << " ms  "
+              << std::setw(7) << ms * 1e6 / events << " ns/event" << std::endl;
+}
+
+void benchmark(int iterations, unsigned threads, const std::string& path) {
+    std::cout << "2. " << iterations << " rounds of object churn (" << eventsPerChurn << " events each) on " << threads
+              << " thread(s):" << std::endl;
+    double events = static_cast<double>(iterations) * eventsPerChurn * threads;
+
+    if (!LIFECYCLE_TRACE_ENABLED) {
+        report("Tracing compiled out", runChurn(iterations, threads), events);
+        std::cout << std::endl;
+        return;
+    }
+
+    std::ofstream devNull("/dev/null");
+    printLifecycleTo(&devNull);
+    report("Synchronous printing (std::endl)", runChurn(iterations, threads), events);
+    printLifecycleTo(nullptr);
+
+    report("Tracing inactive (not started)", runChurn(iterations, threads), events);
+
+    lifecycle::Tracer::instance().start(path);
+    double tracedMs = runChurn(iterations, threads);
+    lifecycle::Tracer::Stats stats = lifecycle::Tracer::instance().stop();
+    report("Tracing to ring buffers", tracedMs, events);
+    std::cout << "  Trace: " << stats.records << " records, " << stats.bytes / (1024 * 1024) << " MB, "
+              << stats.dropped << " events dropped on full rings" << std::endl;
+
+    std::size_t decoded = lifecycle::decodeTrace(path).size();
+    std::filesystem::remove(path);
+    std::cout << "  All events accounted for: "
+              << (static_cast<double>(decoded + stats.dropped) == events ? "Yes" : "No") << std::endl;
+    // The worker threads have exited and their rings were drained by stop()
+    std::cout << "  Rings allocated after the workers exited (main thread's only): " << lifecycle::Tracer::instance().ringCount()
+              << std::endl;
+    std::cout << std::endl;
+}
+
+// Prints a trace file as text: time, thread, object address and the line
+int decode(const std::string& path) {
+    std::vector<lifecycle::DecodedEvent> events = lifecycle::decodeTrace(path);
+    std::uint64_t start = events.empty() ? 0 : events.front().timestamp;
+    for (const lifecycle::DecodedEvent& event : events) {
+        std::cout << std::setw(12) << (event.timestamp - start) / 1000 << " us  thread " << event.thread << "  0x"
+                  << std::hex << event.object << std::dec;
+        lifecycle::writeLine(std::cout, event.type, event.kind, event.name);
+        std::cout << '\n';
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && std::strcmp(argv[1], "--decode") == 0) {
+        return decode(argv[2]);
+    }
+
+    std::cout << "=== Asynchronous Lifecycle Tracing ===" << std::endl;
+    std::cout << std::endl;
+
+    std::string path = defaultTracePath();
+    demonstrateTrace(path);
+
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    benchmark(iterations, std::max(1u, threads), path);
+
+    std::cout << "=== End of Lifecycle Trace Example ===" << std::endl;
+
+    return 0;
+}
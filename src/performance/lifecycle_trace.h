@@ -0,0 +1,539 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "output_sink.h"
+
+/**
+ * Lifecycle tracer
+ *
+ * Records constructor/destructor events of Student, the Animal hierarchy
+ * and the Shape hierarchy as compact binary records instead of printing
+ * them:
+ *
+ * - LIFECYCLE_TRACE(type, kind, object, name) appends one 32-byte Event
+ *   (timestamp, object address, type id, event kind, the first bytes of
+ *   the name) to a ring buffer owned by the calling thread. Names longer
+ *   than Event::inlineName continue in raw 32-byte records.
+ * - Each ring has exactly one producer (its thread) and one consumer (the
+ *   tracer's background thread), so recording is lock-free: a few stores
+ *   and one release store of the head index. A full ring drops the event
+ *   and counts it rather than block the traced code.
+ * - The background thread drains all rings into a trace file through an
+ *   OutputSink, in blocks tagged with the thread index.
+ * - decodeTrace()/writeLine() rebuild the human-readable lines the
+ *   classes used to print, offline, from the file.
+ * - While the tracer is not recording, events go to the echo function
+ *   chosen at runtime (Tracer::setEcho), or nowhere. The learning modules
+ *   use ConsoleSession: they echo every event to console() as they always
+ *   printed, unless LIFECYCLE_TRACE=<file> is set in the environment.
+ * - A ring is freed once its thread has exited and its last events have
+ *   been drained, so short-lived threads do not pin memory.
+ *
+ * Compile with LIFECYCLE_TRACE_ENABLED=0 to remove tracing entirely: the
+ * macro then expands to nothing and its arguments are not evaluated.
+ */
+
+#ifndef LIFECYCLE_TRACE_ENABLED
+#define LIFECYCLE_TRACE_ENABLED 1
+#endif
+
+namespace lifecycle {
+
+enum class TypeId : std::uint16_t { Student, Animal, Dog, Cat, Bird, Shape, Circle, Rectangle, Triangle, Count };
+
+enum class EventKind : std::uint8_t {
+    DefaultConstructed,
+    Constructed,
+    CopyConstructed,
+    MoveConstructed,
+    CopyAssigned,
+    MoveAssigned,
+    Destroyed
+};
+
+inline const char* typeName(TypeId type) {
+    static const char* names[] = {"Student", "Animal", "Dog",    "Cat",     "Bird",
+                                  "Shape",   "Circle", "Rectangle", "Triangle"};
+    return type < TypeId::Count ? names[static_cast<std::size_t>(type)] : "Unknown";
+}
+
+struct Event {
+    static constexpr std::size_t inlineName = 12;
+
+    std::uint64_t timestamp;  // Nanoseconds on the steady clock
+    std::uint64_t object;     // Address of the object
+    TypeId type;
+    EventKind kind;
+    std::uint8_t nameLength;  // Total length; the rest follows in raw records
+    char name[inlineName];
+};
+static_assert(sizeof(Event) == 32, "Events are 32-byte records");
+
+// Records needed for an event whose name has `nameLength` bytes
+constexpr std::size_t recordsFor(std::size_t nameLength) {
+    return nameLength <= Event::inlineName
+               ? 1
+               : 1 + (nameLength - Event::inlineName + sizeof(Event) - 1) / sizeof(Event);
+}
+
+// ---------------------------------------------------------------------------
+// EventRing: single-producer, single-consumer ring of Event records
+// ---------------------------------------------------------------------------
+
+class EventRing {
+public:
+    static constexpr std::size_t capacity = 1 << 18;  // Records (8 MB)
+
+private:
+    std::unique_ptr<Event[]> slots;
+    std::uint32_t thread;
+    alignas(64) std::atomic<std::uint64_t> head{0};  // Written by the producer
+    std::uint64_t cachedTail = 0;                     // Producer's copy of tail
+    std::atomic<std::uint64_t> dropped{0};            // Written by the producer
+    std::atomic<bool> retired{false};                 // Set when the producer thread exits
+    alignas(64) std::atomic<std::uint64_t> tail{0};  // Written by the consumer
+
+public:
+    explicit EventRing(std::uint32_t threadIndex) : slots(new Event[capacity]), thread(threadIndex) {}
+
+    std::uint32_t threadIndex() const { return thread; }
+    std::uint64_t droppedEvents() const { return dropped.load(std::memory_order_relaxed); }
+
+    // The producer has exited: once drained, the ring can be freed
+    void retire() { retired.store(true, std::memory_order_release); }
+    bool isRetired() const { return retired.load(std::memory_order_acquire); }
+
+    // Producer side: appends `count` records as one unit, or drops them all
+    bool push(const Event* records, std::size_t count) {
+        std::uint64_t position = head.load(std::memory_order_relaxed);
+        if (position + count - cachedTail > capacity) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (position + count - cachedTail > capacity) {
+                dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            slots[(position + i) & (capacity - 1)] = records[i];
+        }
+        head.store(position + count, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: passes everything recorded so far to consume(records,
+    // count) in at most two contiguous pieces, then frees the slots
+    template <typename Consume>
+    std::size_t drain(Consume&& consume) {
+        std::uint64_t from = tail.load(std::memory_order_relaxed);
+        std::uint64_t to = head.load(std::memory_order_acquire);
+        std::uint64_t position = from;
+        while (position < to) {
+            std::size_t offset = position & (capacity - 1);
+            std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(to - position, capacity - offset));
+            consume(&slots[offset], count);
+            position += count;
+        }
+        tail.store(to, std::memory_order_release);
+        return static_cast<std::size_t>(to - from);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Trace file format
+// ---------------------------------------------------------------------------
+
+struct TraceFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+};
+
+struct TraceBlockHeader {
+    std::uint32_t thread;
+    std::uint32_t records;
+};
+
+constexpr char traceMagic[8] = {'L', 'C', 'T', 'R', 'A', 'C', 'E', '\0'};
+constexpr std::uint32_t traceVersion = 1;
+
+// ---------------------------------------------------------------------------
+// Tracer: owns the rings and the background drain thread
+// ---------------------------------------------------------------------------
+
+// Receives events while the tracer is not recording
+using EchoFunction = void (*)(TypeId type, EventKind kind, std::string_view name);
+
+class Tracer {
+public:
+    struct Stats {
+        std::uint64_t records = 0;  // Records written to the file
+        std::uint64_t dropped = 0;  // Events lost to full rings
+        std::uint64_t bytes = 0;    // Size of the trace file
+    };
+
+private:
+    std::mutex mutex;  // Guards rings and the file
+    std::vector<std::shared_ptr<EventRing>> rings;
+    std::uint32_t nextThread = 0;     // Thread index of the next ring
+    std::uint64_t retiredDropped = 0;  // Dropped events of rings already freed
+    std::unique_ptr<OutputSink> file;
+    int fd = -1;
+    std::thread drainer;
+    std::atomic<bool> draining{false};
+    std::atomic<bool> recording{false};
+    std::atomic<EchoFunction> echoFunction{nullptr};
+    std::uint64_t recordsWritten = 0;
+    std::uint64_t droppedBefore = 0;  // Dropped events from earlier runs
+    std::chrono::microseconds interval{500};
+
+    // Called with mutex held. Passes every ring's pending records to
+    // consume and frees the rings whose threads have exited.
+    template <typename Consume>
+    void drainRings(Consume&& consume) {
+        for (auto it = rings.begin(); it != rings.end();) {
+            EventRing& ring = **it;
+            // Read before draining: a retired thread records nothing more
+            bool retired = ring.isRetired();
+            ring.drain([&](const Event* records, std::size_t count) { consume(ring, records, count); });
+            if (retired) {
+                retiredDropped += ring.droppedEvents();
+                it = rings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Called with mutex held
+    void drainAll() {
+        drainRings([&](const EventRing& ring, const Event* records, std::size_t count) {
+            TraceBlockHeader block{ring.threadIndex(), static_cast<std::uint32_t>(count)};
+            file->write(reinterpret_cast<const char*>(&block), sizeof(block));
+            file->write(reinterpret_cast<const char*>(records), count * sizeof(Event));
+            recordsWritten += count;
+        });
+    }
+
+    // Called with mutex held
+    std::uint64_t droppedTotal() const {
+        std::uint64_t total = retiredDropped;
+        for (const auto& ring : rings) {
+            total += ring->droppedEvents();
+        }
+        return total;
+    }
+
+    void drainLoop() {
+        while (draining.load(std::memory_order_acquire)) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                drainAll();
+            }
+            std::this_thread::sleep_for(interval);
+        }
+    }
+
+    std::shared_ptr<EventRing> addRing() {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Reclaim rings of threads that exited while the tracer was stopped
+        if (!file) {
+            drainRings([](const EventRing&, const Event*, std::size_t) {});
+        }
+        rings.push_back(std::make_shared<EventRing>(nextThread++));
+        return rings.back();
+    }
+
+    // Retires the thread's ring when the thread exits
+    struct LocalRing {
+        std::shared_ptr<EventRing> ring;
+        ~LocalRing() { ring->retire(); }
+    };
+
+public:
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    ~Tracer() { stop(); }
+
+    // The calling thread's ring. The tracer keeps it alive after the
+    // thread exits until its last events are drained, then frees it.
+    static EventRing& localRing() {
+        thread_local LocalRing local{instance().addRing()};
+        return *local.ring;
+    }
+
+    static bool active() { return instance().recording.load(std::memory_order_relaxed); }
+
+    // Rings currently allocated (threads that recorded and are still
+    // running, plus exited ones not drained yet)
+    std::size_t ringCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return rings.size();
+    }
+
+    // Where events go while not recording; nullptr discards them
+    static void setEcho(EchoFunction echo) { instance().echoFunction.store(echo, std::memory_order_relaxed); }
+    static EchoFunction echo() { return instance().echoFunction.load(std::memory_order_relaxed); }
+
+    // Starts recording into `path`, draining every `drainInterval`
+    void start(const std::string& path, std::chrono::microseconds drainInterval = std::chrono::microseconds(500)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file) {
+            throw std::logic_error("Tracer is already running");
+        }
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot create trace file " + path);
+        }
+        file = std::make_unique<OutputSink>(fd, 1 << 20);
+        TraceFileHeader header{};
+        std::memcpy(header.magic, traceMagic, sizeof(traceMagic));
+        header.version = traceVersion;
+        header.recordSize = sizeof(Event);
+        file->write(reinterpret_cast<const char*>(&header), sizeof(header));
+        drainRings([](const EventRing&, const Event*, std::size_t) {});  // Events recorded after the last stop()
+        droppedBefore = droppedTotal();
+        recordsWritten = 0;
+        interval = drainInterval;
+        draining = true;
+        drainer = std::thread([this] { drainLoop(); });
+        recording = true;
+    }
+
+    // Stops recording, writes out everything still buffered and closes the file
+    Stats stop() {
+        recording = false;
+        if (!drainer.joinable()) {
+            return {};
+        }
+        draining = false;
+        drainer.join();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        drainAll();
+        file->flush();
+        Stats stats;
+        stats.records = recordsWritten;
+        stats.bytes = file->getStats().bytes;
+        stats.dropped = droppedTotal() - droppedBefore;
+        file.reset();
+        ::close(fd);
+        fd = -1;
+        return stats;
+    }
+};
+
+inline std::uint64_t now() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+inline void record(TypeId type, EventKind kind, const void* object, std::string_view name) {
+    if (!Tracer::active()) {
+        if (EchoFunction echo = Tracer::echo()) {
+            echo(type, kind, name);
+        }
+        return;
+    }
+    constexpr std::size_t maxName = 255;
+    Event records[recordsFor(maxName)];
+    std::size_t length = std::min(name.size(), maxName);
+    Event& event = records[0];
+    event.timestamp = now();
+    event.object = reinterpret_cast<std::uintptr_t>(object);
+    event.type = type;
+    event.kind = kind;
+    event.nameLength = static_cast<std::uint8_t>(length);
+    std::memset(event.name, 0, sizeof(event.name));
+    std::size_t inlineLength = std::min(length, Event::inlineName);
+    std::memcpy(event.name, name.data(), inlineLength);
+    if (length > inlineLength) {
+        std::memcpy(reinterpret_cast<char*>(&records[1]), name.data() + inlineLength, length - inlineLength);
+    }
+    Tracer::localRing().push(records, recordsFor(length));
+}
+
+// ---------------------------------------------------------------------------
+// Offline decoding
+// ---------------------------------------------------------------------------
+
+struct DecodedEvent {
+    std::uint64_t timestamp;
+    std::uint64_t object;
+    std::uint32_t thread;
+    TypeId type;
+    EventKind kind;
+    std::string name;
+};
+
+// Reads a trace file and returns its events ordered by time
+inline std::vector<DecodedEvent> decodeTrace(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    TraceFileHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        throw std::runtime_error("Not a lifecycle trace: " + path);
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, traceMagic, sizeof(traceMagic)) != 0 || header.version != traceVersion ||
+        header.recordSize != sizeof(Event)) {
+        throw std::runtime_error("Not a lifecycle trace: " + path);
+    }
+
+    // Blocks of one thread are in order; join them into one stream per thread
+    std::vector<std::vector<Event>> streams;
+    std::size_t offset = sizeof(header);
+    while (offset + sizeof(TraceBlockHeader) <= bytes.size()) {
+        TraceBlockHeader block;
+        std::memcpy(&block, bytes.data() + offset, sizeof(block));
+        offset += sizeof(block);
+        std::size_t size = std::size_t(block.records) * sizeof(Event);
+        if (offset + size > bytes.size()) {
+            throw std::runtime_error("Truncated lifecycle trace: " + path);
+        }
+        if (block.thread >= streams.size()) {
+            streams.resize(block.thread + 1);
+        }
+        std::vector<Event>& stream = streams[block.thread];
+        std::size_t first = stream.size();
+        stream.resize(first + block.records);
+        std::memcpy(stream.data() + first, bytes.data() + offset, size);
+        offset += size;
+    }
+
+    std::vector<DecodedEvent> events;
+    for (std::uint32_t thread = 0; thread < streams.size(); ++thread) {
+        const std::vector<Event>& stream = streams[thread];
+        for (std::size_t i = 0; i < stream.size();) {
+            const Event& event = stream[i];
+            std::size_t records = recordsFor(event.nameLength);
+            if (i + records > stream.size()) {
+                throw std::runtime_error("Truncated lifecycle trace: " + path);
+            }
+            std::string name(event.name, std::min<std::size_t>(event.nameLength, Event::inlineName));
+            if (records > 1) {
+                name.append(reinterpret_cast<const char*>(&stream[i + 1]), event.nameLength - Event::inlineName);
+            }
+            events.push_back({event.timestamp, event.object, thread, event.type, event.kind, std::move(name)});
+            i += records;
+        }
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const DecodedEvent& a, const DecodedEvent& b) { return a.timestamp < b.timestamp; });
+    return events;
+}
+
+// Writes the line the original class printed for this event, without the
+// trailing newline. Out is any stream with operator<< (std::ostream, OutputSink).
+template <typename Out>
+void writeLine(Out& out, TypeId type, EventKind kind, std::string_view name) {
+    if (type == TypeId::Student) {
+        switch (kind) {
+        case EventKind::DefaultConstructed:
+            out << "  Default constructor called for " << name;
+            break;
+        case EventKind::Constructed:
+            out << "  Parameterized constructor called for " << name;
+            break;
+        case EventKind::CopyConstructed:
+            out << "  Copy constructor called for " << name;
+            break;
+        case EventKind::MoveConstructed:
+            out << "  Move constructor called for " << name;
+            break;
+        case EventKind::CopyAssigned:
+            out << "  Copy assignment called for " << name;
+            break;
+        case EventKind::MoveAssigned:
+            out << "  Move assignment called for " << name;
+            break;
+        case EventKind::Destroyed:
+            out << "  Destructor called for " << (name.empty() ? "(moved-from object)" : name);
+            break;
+        }
+        return;
+    }
+    bool destroyed = kind == EventKind::Destroyed;
+    if (type >= TypeId::Shape) {
+        out << "  " << typeName(type) << (destroyed ? " destructor: " : " constructor: ") << name;
+    } else {
+        out << "  " << typeName(type) << (destroyed ? " destructor called for " : " constructor called for ")
+            << name;
+    }
+}
+
+// Echo function printing each event to console(), as the classes did
+inline void echoToConsole(TypeId type, EventKind kind, std::string_view name) {
+    writeLine(console(), type, kind, name);
+    console() << '\n';
+}
+
+// Chooses where a program's lifecycle events go for its whole run. By
+// default they are echoed to console(); with LIFECYCLE_TRACE=<file> in the
+// environment they are traced into that file instead (decode it with
+// perf_lifecycle_trace --decode <file>), falling back to the console if
+// the file cannot be created. Declare it first in main so the destructors
+// of main's objects are still covered.
+class ConsoleSession {
+private:
+    bool tracing = false;
+
+public:
+    ConsoleSession() {
+#if LIFECYCLE_TRACE_ENABLED
+        if (const char* path = std::getenv("LIFECYCLE_TRACE"); path != nullptr && *path != '\0') {
+            try {
+                Tracer::instance().start(path);
+                tracing = true;
+                return;
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "lifecycle: %s, printing to the console instead\n", e.what());
+            }
+        }
+        Tracer::setEcho(echoToConsole);
+#endif
+    }
+
+    ~ConsoleSession() {
+        if (tracing) {
+            Tracer::Stats stats = Tracer::instance().stop();
+            std::fprintf(stderr, "lifecycle: %llu records traced to %s, %llu events dropped\n",
+                         static_cast<unsigned long long>(stats.records), std::getenv("LIFECYCLE_TRACE"),
+                         static_cast<unsigned long long>(stats.dropped));
+        }
+        Tracer::setEcho(nullptr);
+    }
+
+    ConsoleSession(const ConsoleSession&) = delete;
+    ConsoleSession& operator=(const ConsoleSession&) = delete;
+};
+
+}  // namespace lifecycle
+
+#if LIFECYCLE_TRACE_ENABLED
+#define LIFECYCLE_TRACE(type, kind, object, name) \
+    ::lifecycle::record(::lifecycle::TypeId::type, ::lifecycle::EventKind::kind, (object), (name))
+#else
+#define LIFECYCLE_TRACE(type, kind, object, name) ((void)0)
+#endif
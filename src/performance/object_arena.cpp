@@ -0,0 +1,583 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <type_traits>
+#include <utility>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "bench.h"
+
+/**
+ * Arena (Region) Allocation for Polymorphic Objects
+ *
+ * This example demonstrates:
+ * - A monotonic arena: objects are carved out of large blocks with a
+ *   "bump pointer" instead of one malloc per object
+ * - Releasing a whole batch of objects in O(1) by rewinding the arena
+ * - An owning handle (ArenaPtr) that runs the virtual destructor chain
+ *   but never frees memory itself
+ * - Upcasting handles (ArenaPtr<Dog> -> ArenaPtr<Animal>), including
+ *   multiple inheritance (Bird -> Flyable)
+ * - A debug mode that catches use-after-reset
+ * - A benchmark comparing std::make_unique with the arena
+ *
+ * Debug checks are on when NDEBUG is not defined (or with -DARENA_DEBUG).
+ * The default Release build has them off; perf_object_arena_debug is the
+ * same program built with -DARENA_DEBUG. Destroying an arena while handles
+ * still own objects aborts in every build, since those handles would be
+ * left pointing at a dead Arena.
+ *
+ * Usage: ./perf_object_arena [objectsPerCycle] [cycles]   (default: 1000000 5)
+ */
+
+#if !defined(NDEBUG) || defined(ARENA_DEBUG)
+#define ARENA_DEBUG_CHECKS 1
+#else
+#define ARENA_DEBUG_CHECKS 0
+#endif
+
+// Reports misuse of the arena. Aborts in debug mode, does nothing otherwise.
+inline void arenaCheck(bool condition, const char* message) {
+    if constexpr (ARENA_DEBUG_CHECKS) {
+        if (!condition) {
+            std::cerr << "Arena error: " << message << std::endl;
+            std::abort();
+        }
+    }
+}
+
+// When true, constructors and destructors print like the oop/ examples
+static bool verboseLifecycle = false;
+
+// ---------------------------------------------------------------------------
+// Arena and ArenaPtr
+// ---------------------------------------------------------------------------
+
+class Arena;
+
+// Owning handle for an object that lives inside an Arena.
+// Destroying the handle runs the destructor; the memory is reclaimed
+// only when the arena is reset. The handle refers back to its Arena, so
+// handles must be destroyed before the arena (~Arena enforces this).
+template <typename T>
+class ArenaPtr {
+private:
+    T* object = nullptr;
+    Arena* arena = nullptr;
+    std::uint32_t generation = 0;
+
+    template <typename U>
+    friend class ArenaPtr;
+
+public:
+    ArenaPtr() = default;
+    ArenaPtr(T* obj, Arena* owner, std::uint32_t gen) : object(obj), arena(owner), generation(gen) {}
+
+    ArenaPtr(const ArenaPtr&) = delete;
+    ArenaPtr& operator=(const ArenaPtr&) = delete;
+
+    ArenaPtr(ArenaPtr&& other) noexcept
+        : object(std::exchange(other.object, nullptr)), arena(other.arena), generation(other.generation) {}
+
+    // Upcast, e.g. ArenaPtr<Dog> -> ArenaPtr<Animal>. Requires a virtual
+    // destructor so that destroying through the base pointer is correct.
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*> &&
+                                                      std::has_virtual_destructor_v<T>>>
+    ArenaPtr(ArenaPtr<U>&& other) noexcept
+        : object(std::exchange(other.object, nullptr)), arena(other.arena), generation(other.generation) {}
+
+    ArenaPtr& operator=(ArenaPtr&& other) noexcept {
+        if (this != &other) {
+            reset();
+            object = std::exchange(other.object, nullptr);
+            arena = other.arena;
+            generation = other.generation;
+        }
+        return *this;
+    }
+
+    ~ArenaPtr() { reset(); }
+
+    // Runs the destructor now (memory stays in the arena)
+    void reset();
+
+    // False once the owning arena has been reset or released
+    bool isValid() const;
+
+    T* get() const {
+        arenaCheck(object == nullptr || isValid(), "access through a handle after Arena::reset()");
+        return object;
+    }
+    T& operator*() const { return *get(); }
+    T* operator->() const { return get(); }
+    explicit operator bool() const { return object != nullptr; }
+};
+
+class Arena {
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t currentBlock = 0;
+    std::byte* cursor = nullptr;
+    std::byte* limit = nullptr;
+    std::size_t blockSize;
+    std::size_t bytesInUse = 0;
+    std::size_t liveObjects = 0;
+    std::uint32_t currentGeneration = 1;
+
+    template <typename T>
+    friend class ArenaPtr;
+
+    // Moves to the next retained block or allocates a new one
+    void nextBlock(std::size_t minimumSize) {
+        std::size_t next = blocks.empty() ? 0 : currentBlock + 1;
+        if (next >= blocks.size() || blocks[next].size < minimumSize) {
+            std::size_t size = minimumSize > blockSize ? minimumSize : blockSize;
+            Block block{std::make_unique<std::byte[]>(size), size};
+            blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(next), std::move(block));
+        }
+        currentBlock = next;
+        cursor = blocks[next].memory.get();
+        limit = cursor + blocks[next].size;
+    }
+
+public:
+    explicit Arena(std::size_t bytesPerBlock = 1 << 20) : blockSize(bytesPerBlock) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Not a debug-only check: the surviving handles would dereference this
+    // arena later, so continuing is never safe
+    ~Arena() {
+        if (liveObjects != 0) {
+            std::cerr << "Arena error: arena destroyed while handles still own objects" << std::endl;
+            std::abort();
+        }
+    }
+
+    // Bump-pointer allocation: usually just an add and a compare
+    void* allocate(std::size_t size, std::size_t alignment) {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(cursor);
+        std::size_t padding = (alignment - address % alignment) % alignment;
+        if (cursor == nullptr || padding + size > static_cast<std::size_t>(limit - cursor)) {
+            nextBlock(size + alignment);
+            address = reinterpret_cast<std::uintptr_t>(cursor);
+            padding = (alignment - address % alignment) % alignment;
+        }
+        std::byte* result = cursor + padding;
+        cursor = result + size;
+        bytesInUse += padding + size;
+        return result;
+    }
+
+    // Constructs a T inside the arena and returns its owning handle
+    template <typename T, typename... Args>
+    ArenaPtr<T> make(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        T* object = new (memory) T(std::forward<Args>(args)...);
+        ++liveObjects;
+        return ArenaPtr<T>(object, this, currentGeneration);
+    }
+
+    // Frees every object at once: O(1), the blocks are kept for reuse.
+    // All handles must have been destroyed (their destructors have run).
+    void reset() {
+        arenaCheck(liveObjects == 0, "Arena::reset() called while handles still own objects");
+        if constexpr (ARENA_DEBUG_CHECKS) {
+            // Poison memory so stale reads show up as garbage immediately
+            for (Block& block : blocks) {
+                std::memset(block.memory.get(), 0xDD, block.size);
+            }
+        }
+        ++currentGeneration;
+        bytesInUse = 0;
+        liveObjects = 0;
+        currentBlock = 0;
+        if (!blocks.empty()) {
+            cursor = blocks[0].memory.get();
+            limit = cursor + blocks[0].size;
+        }
+    }
+
+    // Like reset(), but also returns the blocks to the system
+    void release() {
+        reset();
+        blocks.clear();
+        cursor = limit = nullptr;
+    }
+
+    std::uint32_t generation() const { return currentGeneration; }
+    std::size_t bytesUsed() const { return bytesInUse; }
+    std::size_t blockCount() const { return blocks.size(); }
+    std::size_t liveObjectCount() const { return liveObjects; }
+};
+
+template <typename T>
+void ArenaPtr<T>::reset() {
+    if (object == nullptr) {
+        return;
+    }
+    if (isValid()) {
+        object->~T();  // Virtual destructor: runs ~Dog then ~Animal
+        --arena->liveObjects;
+    } else {
+        arenaCheck(false, "handle destroyed after its Arena was reset");
+    }
+    object = nullptr;
+}
+
+template <typename T>
+bool ArenaPtr<T>::isValid() const {
+    return object != nullptr && arena->currentGeneration == generation;
+}
+
+// ---------------------------------------------------------------------------
+// Shapes (same formulas as src/oop/polymorphism.cpp)
+// ---------------------------------------------------------------------------
+
+class Shape {
+protected:
+    std::string name;
+    double x, y;
+
+public:
+    Shape(const std::string& shapeName, double posX = 0, double posY = 0)
+        : name(shapeName), x(posX), y(posY) {
+        if (verboseLifecycle) std::cout << "  Shape constructor: " << name << std::endl;
+    }
+
+    virtual ~Shape() {
+        if (verboseLifecycle) std::cout << "  Shape destructor: " << name << std::endl;
+    }
+
+    virtual double getArea() const = 0;
+    std::string getName() const { return name; }
+};
+
+class Circle : public Shape {
+private:
+    double radius;
+
+public:
+    Circle(const std::string& circleName, double r, double posX = 0, double posY = 0)
+        : Shape(circleName, posX, posY), radius(r) {
+        if (verboseLifecycle) std::cout << "  Circle constructor: " << name << std::endl;
+    }
+    ~Circle() {
+        if (verboseLifecycle) std::cout << "  Circle destructor: " << name << std::endl;
+    }
+    double getArea() const override { return 3.14159 * radius * radius; }
+};
+
+class Rectangle : public Shape {
+private:
+    double width, height;
+
+public:
+    Rectangle(const std::string& rectName, double w, double h, double posX = 0, double posY = 0)
+        : Shape(rectName, posX, posY), width(w), height(h) {
+        if (verboseLifecycle) std::cout << "  Rectangle constructor: " << name << std::endl;
+    }
+    ~Rectangle() {
+        if (verboseLifecycle) std::cout << "  Rectangle destructor: " << name << std::endl;
+    }
+    double getArea() const override { return width * height; }
+};
+
+class Triangle : public Shape {
+private:
+    double base, height;
+
+public:
+    Triangle(const std::string& triName, double b, double h, double posX = 0, double posY = 0)
+        : Shape(triName, posX, posY), base(b), height(h) {
+        if (verboseLifecycle) std::cout << "  Triangle constructor: " << name << std::endl;
+    }
+    ~Triangle() {
+        if (verboseLifecycle) std::cout << "  Triangle destructor: " << name << std::endl;
+    }
+    double getArea() const override { return 0.5 * base * height; }
+};
+
+// ---------------------------------------------------------------------------
+// Animals (same hierarchy as src/oop/inheritance.cpp)
+// ---------------------------------------------------------------------------
+
+class Animal {
+protected:
+    std::string name;
+    int age;
+
+public:
+    Animal(const std::string& animalName, int animalAge) : name(animalName), age(animalAge) {
+        if (verboseLifecycle) std::cout << "  Animal constructor called for " << name << std::endl;
+    }
+    virtual ~Animal() {
+        if (verboseLifecycle) std::cout << "  Animal destructor called for " << name << std::endl;
+    }
+    virtual void makeSound() const {
+        std::cout << "  " << name << " makes a generic animal sound" << std::endl;
+    }
+    virtual void move() const = 0;
+    std::string getName() const { return name; }
+    int getAge() const { return age; }
+};
+
+class Dog : public Animal {
+private:
+    std::string breed;
+
+public:
+    Dog(const std::string& dogName, int dogAge, const std::string& dogBreed)
+        : Animal(dogName, dogAge), breed(dogBreed) {
+        if (verboseLifecycle) std::cout << "  Dog constructor called for " << name << std::endl;
+    }
+    ~Dog() {
+        if (verboseLifecycle) std::cout << "  Dog destructor called for " << name << std::endl;
+    }
+    void makeSound() const override {
+        std::cout << "  " << name << " barks: Woof! Woof!" << std::endl;
+    }
+    void move() const override {
+        std::cout << "  " << name << " runs on four legs" << std::endl;
+    }
+};
+
+class Cat : public Animal {
+private:
+    bool isIndoor;
+
+public:
+    Cat(const std::string& catName, int catAge, bool indoor = true)
+        : Animal(catName, catAge), isIndoor(indoor) {
+        if (verboseLifecycle) std::cout << "  Cat constructor called for " << name << std::endl;
+    }
+    ~Cat() {
+        if (verboseLifecycle) std::cout << "  Cat destructor called for " << name << std::endl;
+    }
+    void makeSound() const override {
+        std::cout << "  " << name << " meows: Meow! Meow!" << std::endl;
+    }
+    void move() const override {
+        std::cout << "  " << name << " walks silently" << std::endl;
+    }
+};
+
+class Flyable {
+public:
+    virtual void fly() const = 0;
+    virtual ~Flyable() = default;
+};
+
+class Bird : public Animal, public Flyable {
+private:
+    double wingspan;
+
+public:
+    Bird(const std::string& birdName, int birdAge, double birdWingspan)
+        : Animal(birdName, birdAge), wingspan(birdWingspan) {
+        if (verboseLifecycle) std::cout << "  Bird constructor called for " << name << std::endl;
+    }
+    ~Bird() {
+        if (verboseLifecycle) std::cout << "  Bird destructor called for " << name << std::endl;
+    }
+    void makeSound() const override {
+        std::cout << "  " << name << " chirps: Tweet! Tweet!" << std::endl;
+    }
+    void move() const override {
+        std::cout << "  " << name << " flies through the air" << std::endl;
+    }
+    void fly() const override {
+        std::cout << "  " << name << " soars with " << wingspan << "cm wingspan" << std::endl;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void demonstrateArena() {
+    Arena arena(4096);
+
+    std::cout << "1. Building a batch of shapes and animals in one arena:" << std::endl;
+    verboseLifecycle = true;
+    std::vector<ArenaPtr<Shape>> shapes;
+    shapes.push_back(arena.make<Circle>("ArenaCircle", 3.0));
+    shapes.push_back(arena.make<Rectangle>("ArenaRectangle", 5.0, 3.0));
+
+    std::vector<ArenaPtr<Animal>> animals;
+    animals.push_back(arena.make<Dog>("Max", 4, "German Shepherd"));
+    animals.push_back(arena.make<Cat>("Luna", 3, false));
+    ArenaPtr<Flyable> eagle = arena.make<Bird>("Eagle", 2, 180.0);  // Second base class
+    std::cout << "  Objects: " << arena.liveObjectCount() << ", bytes used: " << arena.bytesUsed()
+              << ", blocks: " << arena.blockCount() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "2. Using the objects through base-class handles:" << std::endl;
+    for (const auto& shape : shapes) {
+        std::cout << "  " << shape->getName() << " area: " << shape->getArea() << std::endl;
+    }
+    for (const auto& animal : animals) {
+        animal->makeSound();
+        animal->move();
+    }
+    eagle->fly();
+    std::cout << std::endl;
+
+    std::cout << "3. Destroying the batch (destructor chains run, no free()):" << std::endl;
+    shapes.clear();
+    animals.clear();
+    eagle.reset();
+    verboseLifecycle = false;
+    arena.reset();
+    std::cout << "  After reset: objects " << arena.liveObjectCount() << ", bytes used "
+              << arena.bytesUsed() << ", blocks kept " << arena.blockCount() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "4. Use-after-reset detection:" << std::endl;
+    ArenaPtr<Shape> stale = arena.make<Triangle>("Stale", 4.0, 3.0);
+    std::cout << "  Handle valid before reset: " << (stale.isValid() ? "Yes" : "No") << std::endl;
+    if constexpr (ARENA_DEBUG_CHECKS) {
+        // The check aborts, so let a child process make the mistake
+        std::cout << "  Debug checks are on: resetting the arena in a child process..." << std::endl;
+        pid_t child = fork();
+        if (child == 0) {
+            arena.reset();  // Bug on purpose: the handle still owns its object
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        bool aborted = WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+        std::cout << "  Child " << (aborted ? "was aborted by the debug check" : "was NOT stopped") << std::endl;
+        stale.reset();
+    } else {
+        std::cout << "  Debug checks are OFF in this build (NDEBUG without ARENA_DEBUG)" << std::endl;
+        arena.reset();  // Bug on purpose: the handle still owns its object
+        std::cout << "  Handle valid after reset: " << (stale.isValid() ? "Yes" : "No")
+                  << " (nothing stopped the reset)" << std::endl;
+        std::cout << "  (Run perf_object_arena_debug to see the reset aborted)" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// One "request cycle": build objectCount shapes and animals, use them, destroy them
+double heapCycle(std::size_t objectCount) {
+    std::vector<std::unique_ptr<Shape>> shapes;
+    std::vector<std::unique_ptr<Animal>> animals;
+    shapes.reserve(objectCount);
+    animals.reserve(objectCount);
+    double checksum = 0;
+    for (std::size_t i = 0; i < objectCount; ++i) {
+        switch (i % 3) {
+            case 0:
+                shapes.push_back(std::make_unique<Circle>("c", 1.0 + i % 7));
+                animals.push_back(std::make_unique<Dog>("d", 3, "mix"));
+                break;
+            case 1:
+                shapes.push_back(std::make_unique<Rectangle>("r", 2.0, 1.0 + i % 5));
+                animals.push_back(std::make_unique<Cat>("c", 2));
+                break;
+            default:
+                shapes.push_back(std::make_unique<Triangle>("t", 3.0, 1.0 + i % 3));
+                animals.push_back(std::make_unique<Bird>("b", 1, 25.0));
+                break;
+        }
+    }
+    for (const auto& shape : shapes) {
+        checksum += shape->getArea();
+    }
+    for (const auto& animal : animals) {
+        checksum += animal->getAge();
+    }
+    return checksum;
+}
+
+double arenaCycle(Arena& arena, std::size_t objectCount) {
+    double checksum = 0;
+    {
+        std::vector<ArenaPtr<Shape>> shapes;
+        std::vector<ArenaPtr<Animal>> animals;
+        shapes.reserve(objectCount);
+        animals.reserve(objectCount);
+        for (std::size_t i = 0; i < objectCount; ++i) {
+            switch (i % 3) {
+                case 0:
+                    shapes.push_back(arena.make<Circle>("c", 1.0 + i % 7));
+                    animals.push_back(arena.make<Dog>("d", 3, "mix"));
+                    break;
+                case 1:
+                    shapes.push_back(arena.make<Rectangle>("r", 2.0, 1.0 + i % 5));
+                    animals.push_back(arena.make<Cat>("c", 2));
+                    break;
+                default:
+                    shapes.push_back(arena.make<Triangle>("t", 3.0, 1.0 + i % 3));
+                    animals.push_back(arena.make<Bird>("b", 1, 25.0));
+                    break;
+            }
+        }
+        for (const auto& shape : shapes) {
+            checksum += shape->getArea();
+        }
+        for (const auto& animal : animals) {
+            checksum += animal->getAge();
+        }
+    }
+    arena.reset();
+    return checksum;
+}
+
+void benchmarkArena(std::size_t objectCount, int cycles) {
+    double heapChecksum = 0, arenaChecksum = 0;
+    double heapMs = bench::timeMs([&] {
+        for (int cycle = 0; cycle < cycles; ++cycle) {
+            heapChecksum += heapCycle(objectCount);
+        }
+    });
+
+    Arena arena(8 << 20);
+    double arenaMs = bench::timeMs([&] {
+        for (int cycle = 0; cycle < cycles; ++cycle) {
+            arenaChecksum += arenaCycle(arena, objectCount);
+        }
+    });
+
+    std::cout << "  " << cycles << " cycles x " << objectCount << " shapes + " << objectCount
+              << " animals" << std::endl;
+    std::cout << "  make_unique: " << heapMs << " ms" << std::endl;
+    std::cout << "  Arena:       " << arenaMs << " ms (x" << heapMs / arenaMs << ", "
+              << arena.blockCount() << " blocks reused every cycle)" << std::endl;
+    std::cout << "  Checksums match: " << (heapChecksum == arenaChecksum ? "Yes" : "No") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Arena Allocation ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateArena();
+
+    std::size_t objectCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int cycles = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::cout << "5. Benchmark (build + use + destroy per cycle):" << std::endl;
+    if constexpr (ARENA_DEBUG_CHECKS) {
+        std::cout << "  (Debug build: every reset also poisons the arena's blocks)" << std::endl;
+    }
+    benchmarkArena(objectCount, cycles);
+    std::cout << std::endl;
+
+    std::cout << "=== End of Arena Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include "output_sink.h"
+#include "bench.h"
+
+/**
+ * Buffered Output without std::endl
+ *
+ * This example demonstrates:
+ * - Why `std::cout << ... << std::endl` is slow in batch runs: std::endl
+ *   flushes, so every line becomes its own write(2) system call
+ * - OutputSink from output_sink.h: one reusable buffer, std::to_chars
+ *   number formatting and explicit flush points
+ * - Writing to a file descriptor or to memory with the same interface
+ * - Lines per second and write(2) counts (from /proc/self/io) for
+ *   std::cout with std::endl, std::cout with '\n', and OutputSink
+ *
+ * Usage: ./perf_output_sink [lineCount]   (default: 1000000)
+ */
+
+// ---------------------------------------------------------------------------
+// The line printed by Student::displayInfo in src/oop/classes.cpp
+// ---------------------------------------------------------------------------
+
+struct StudentLine {
+    std::string name;
+    int age;
+    double averageGrade;
+};
+
+std::vector<StudentLine> makeStudents(std::size_t count) {
+    const char* names[] = {"Alice", "Bob", "Charlie", "Diana", "Eve"};
+    std::vector<StudentLine> students;
+    students.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        double average = 60.0 + static_cast<double>(i % 400) / 10.0 + 1.0 / 3.0;
+        students.push_back({names[i % 5], 18 + static_cast<int>(i % 10), average});
+    }
+    return students;
+}
+
+template <typename Stream>
+void displayInfo(Stream& out, const StudentLine& student) {
+    out << "  Student: " << student.name << ", Age: " << student.age << ", Average Grade: " << student.averageGrade;
+}
+
+// ---------------------------------------------------------------------------
+// Measurement
+// ---------------------------------------------------------------------------
+
+// write(2)-like system calls made by this process so far, or -1 if the
+// kernel does not provide /proc/self/io
+long long writeSyscalls() {
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    long long value = 0;
+    while (io >> key >> value) {
+        if (key == "syscw:") {
+            return value;
+        }
+    }
+    return -1;
+}
+
+// Points standard output at /dev/null while `func` runs, so the benchmark
+// measures the cost of producing output rather than of a terminal
+template <typename Func>
+void withStdoutDiscarded(Func&& func) {
+    std::cout.flush();
+    int saved = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    dup2(devNull, STDOUT_FILENO);
+    close(devNull);
+    func();
+    std::cout.flush();
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+struct Measurement {
+    double ms = 0;
+    long long writes = -1;
+};
+
+template <typename Func>
+Measurement measure(Func&& func) {
+    Measurement result;
+    withStdoutDiscarded([&] {
+        long long before = writeSyscalls();
+        result.ms = bench::timeMs(func);
+        long long after = writeSyscalls();
+        if (before >= 0 && after >= 0) {
+            result.writes = after - before;
+        }
+    });
+    return result;
+}
+
+void report(const std::string& label, const Measurement& m, std::size_t lines) {
+    std::cout << "  " << std::left << std::setw(28) << label << std::right << std::setw(9) << m.ms << " ms  "
+              << std::setw(12) << static_cast<long long>(static_cast<double>(lines) / (m.ms / 1000.0))
+              << " lines/s  write(2): ";
+    if (m.writes >= 0) {
+        std::cout << m.writes;
+    } else {
+        std::cout << "n/a";
+    }
+    std::cout << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void demonstrateSink() {
+    std::cout << "1. Writing to memory:" << std::endl;
+    std::string text;
+    {
+        OutputSink sink(text);
+        displayInfo(sink, {"Alice", 20, 88.0 + 2.0 / 3.0});
+        sink << '\n' << "  Passed: " << std::boolalpha << true << ", credits " << 7u << ", ratio " << 1e-7 << '\n';
+        sink.flush();
+        std::cout << "  " << sink.getStats().lines << " lines, " << sink.getStats().bytes << " bytes, "
+                  << sink.getStats().writeCalls << " write(2) calls" << std::endl;
+    }
+    std::cout << text;
+
+    // Pointers print as addresses, not as bool
+    const void* address = &text;
+    const int* nothing = nullptr;
+    std::ostringstream expected;
+    expected << 88.0 + 2.0 / 3.0 << " " << 1e-7 << " " << 123456789.0 << " " << 0.1 << " " << address << " "
+             << nothing;
+    std::string formatted;
+    {
+        OutputSink sink(formatted);
+        sink << 88.0 + 2.0 / 3.0 << " " << 1e-7 << " " << 123456789.0 << " " << 0.1 << " " << address << " "
+             << nothing;
+    }
+    std::cout << "  Number and pointer formatting matches std::ostream: " << (formatted == expected.str() ? "Yes" : "No")
+              << std::endl;
+    std::cout << std::endl;
+}
+
+void benchmark(std::size_t lineCount) {
+    std::cout << "2. Printing " << lineCount << " student lines to /dev/null:" << std::endl;
+    std::vector<StudentLine> students = makeStudents(lineCount);
+
+    Measurement endlRun = measure([&] {
+        for (const StudentLine& student : students) {
+            displayInfo(std::cout, student);
+            std::cout << std::endl;
+        }
+    });
+    Measurement newlineRun = measure([&] {
+        for (const StudentLine& student : students) {
+            displayInfo(std::cout, student);
+            std::cout << '\n';
+        }
+        std::cout.flush();
+    });
+    Measurement sinkRun = measure([&] {
+        OutputSink sink(STDOUT_FILENO);
+        for (const StudentLine& student : students) {
+            displayInfo(sink, student);
+            sink << '\n';
+        }
+        sink.flush();
+    });
+    std::string text;
+    text.reserve(lineCount * 64);
+    Measurement memoryRun = measure([&] {
+        OutputSink sink(text);
+        for (const StudentLine& student : students) {
+            displayInfo(sink, student);
+            sink << '\n';
+        }
+    });
+
+    report("std::cout << std::endl", endlRun, lineCount);
+    report("std::cout << '\\n'", newlineRun, lineCount);
+    report("OutputSink (fd)", sinkRun, lineCount);
+    report("OutputSink (memory)", memoryRun, lineCount);
+
+    // The same bytes must come out of std::ostream and OutputSink
+    std::ostringstream reference;
+    for (const StudentLine& student : students) {
+        displayInfo(reference, student);
+        reference << '\n';
+    }
+    std::cout << "  Results match: " << (reference.str() == text ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Buffered Output Sink ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateSink();
+
+    std::size_t lineCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    benchmark(lineCount);
+
+    std::cout << "=== End of Output Sink Example ===" << std::endl;
+
+    return 0;
+}
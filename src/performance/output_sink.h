@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unistd.h>
+
+/**
+ * OutputSink
+ *
+ * A buffered replacement for `std::cout << ... << std::endl`. Text is
+ * collected in one reusable buffer and only handed to the target when the
+ * buffer is full or flush() is called, so a program printing thousands of
+ * lines makes a handful of write(2) calls instead of one per line.
+ *
+ * - Targets: a file descriptor (OutputSink(STDOUT_FILENO)) or a
+ *   std::string in memory (OutputSink(text))
+ * - Numbers are formatted with std::to_chars straight into the buffer: no
+ *   locale, no allocation. Floating-point values use the same format as
+ *   an ostream with default flags (%g with 6 significant digits), so
+ *   replacing std::cout does not change the output.
+ * - `sink << '\n'` ends a line without flushing; call flush() at the
+ *   points where the output must be visible (the destructor flushes too)
+ * - Pointers print as hex addresses, like std::ostream
+ * - std::boolalpha/std::noboolalpha are the only supported manipulators
+ *
+ * console() is the shared sink for standard output. A program must not mix
+ * it with std::cout, or the two buffers will interleave out of order.
+ */
+
+class OutputSink {
+public:
+    static constexpr std::size_t defaultCapacity = 64 * 1024;
+
+    struct Stats {
+        std::size_t bytes = 0;       // Bytes handed to the target
+        std::size_t lines = 0;       // Newlines among them
+        std::size_t writeCalls = 0;  // write(2) calls (0 for memory targets)
+    };
+
+private:
+    int fd = -1;
+    std::string* memory = nullptr;
+    std::unique_ptr<char[]> buffer;
+    std::size_t capacity;
+    std::size_t used = 0;
+    bool boolAlpha = false;
+    bool failed = false;
+    Stats stats;
+
+    // Largest text std::to_chars produces for the supported types
+    static constexpr std::size_t maxNumberLength = 64;
+
+    void writeOut(const char* data, std::size_t size) {
+        stats.bytes += size;
+        stats.lines += static_cast<std::size_t>(std::count(data, data + size, '\n'));
+        if (memory) {
+            memory->append(data, size);
+            return;
+        }
+        while (size > 0 && !failed) {
+            ssize_t written = ::write(fd, data, size);
+            ++stats.writeCalls;
+            if (written < 0) {
+                failed = errno != EINTR;
+                continue;
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    // Makes room for `size` more bytes in the buffer
+    void reserve(std::size_t size) {
+        if (capacity - used < size) {
+            flush();
+        }
+    }
+
+    template <typename... FormatArgs>
+    OutputSink& appendNumber(FormatArgs... args) {
+        reserve(maxNumberLength);
+        auto result = std::to_chars(buffer.get() + used, buffer.get() + capacity, args...);
+        used = static_cast<std::size_t>(result.ptr - buffer.get());
+        return *this;
+    }
+
+public:
+    explicit OutputSink(int descriptor, std::size_t bufferCapacity = defaultCapacity)
+        : fd(descriptor), buffer(new char[std::max(bufferCapacity, maxNumberLength)]),
+          capacity(std::max(bufferCapacity, maxNumberLength)) {}
+
+    explicit OutputSink(std::string& text, std::size_t bufferCapacity = defaultCapacity)
+        : memory(&text), buffer(new char[std::max(bufferCapacity, maxNumberLength)]),
+          capacity(std::max(bufferCapacity, maxNumberLength)) {}
+
+    ~OutputSink() { flush(); }
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    // Hands everything buffered so far to the target
+    void flush() {
+        if (used > 0) {
+            writeOut(buffer.get(), used);
+            used = 0;
+        }
+    }
+
+    // False once a write(2) has failed; later output is discarded
+    bool good() const { return !failed; }
+    const Stats& getStats() const { return stats; }
+
+    OutputSink& write(const char* data, std::size_t size) {
+        if (size > capacity - used) {
+            flush();
+            if (size >= capacity) {
+                writeOut(data, size);  // Too large to be worth copying
+                return *this;
+            }
+        }
+        std::memcpy(buffer.get() + used, data, size);
+        used += size;
+        return *this;
+    }
+
+    OutputSink& operator<<(std::string_view text) { return write(text.data(), text.size()); }
+    OutputSink& operator<<(const char* text) { return *this << std::string_view(text); }
+    OutputSink& operator<<(const std::string& text) { return write(text.data(), text.size()); }
+
+    OutputSink& operator<<(char c) {
+        reserve(1);
+        buffer[used++] = c;
+        return *this;
+    }
+
+    OutputSink& operator<<(bool value) {
+        if (boolAlpha) {
+            return *this << (value ? "true" : "false");
+        }
+        return *this << (value ? '1' : '0');
+    }
+
+    // Pointers print as hex addresses like std::ostream ("0x7ffd...");
+    // without this overload they would convert to bool and print 1
+    OutputSink& operator<<(const void* pointer) {
+        if (pointer == nullptr) {
+            return *this << "0";
+        }
+        reserve(2 + maxNumberLength);
+        buffer[used++] = '0';
+        buffer[used++] = 'x';
+        return appendNumber(reinterpret_cast<std::uintptr_t>(pointer), 16);
+    }
+    OutputSink& operator<<(std::nullptr_t) { return *this << static_cast<const void*>(nullptr); }
+
+    OutputSink& operator<<(signed char c) { return *this << static_cast<char>(c); }
+    OutputSink& operator<<(unsigned char c) { return *this << static_cast<char>(c); }
+
+    template <std::integral T>
+        requires(!std::is_same_v<T, bool> && !std::is_same_v<T, char> && !std::is_same_v<T, signed char> &&
+                 !std::is_same_v<T, unsigned char>)
+    OutputSink& operator<<(T value) {
+        return appendNumber(value);
+    }
+
+    template <std::floating_point T>
+    OutputSink& operator<<(T value) {
+        return appendNumber(value, std::chars_format::general, 6);
+    }
+
+    OutputSink& operator<<(std::ios_base& (*manipulator)(std::ios_base&)) {
+        if (manipulator == static_cast<std::ios_base& (*)(std::ios_base&)>(std::boolalpha)) {
+            boolAlpha = true;
+        } else if (manipulator == static_cast<std::ios_base& (*)(std::ios_base&)>(std::noboolalpha)) {
+            boolAlpha = false;
+        } else {
+            throw std::invalid_argument("OutputSink supports only std::boolalpha and std::noboolalpha");
+        }
+        return *this;
+    }
+};
+
+// The sink for standard output; flushed at exit
+inline OutputSink& console() {
+    static OutputSink sink(STDOUT_FILENO);
+    return sink;
+}
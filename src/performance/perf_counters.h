@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Hardware Performance Counters
+ *
+ * Thin wrapper around Linux perf_event_open(2) that counts, for the
+ * calling thread and user space only:
+ *   instructions, CPU cycles, cache misses, branch misses
+ *
+ * Usage:
+ *   HardwareCounters counters;
+ *   counters.start();
+ *   ... workload ...
+ *   CounterValues values = counters.stop();
+ *
+ * The counters are opened as one group, so the kernel schedules them onto
+ * the PMU together and they always cover the same part of the workload.
+ * If the PMU is shared with other groups and multiplexed, the group only
+ * runs part of the time; the values are then scaled by
+ * time_enabled / time_running and runningFraction reports the share.
+ *
+ * If the counters cannot be opened (not Linux, a virtual machine without
+ * a PMU, or /proc/sys/kernel/perf_event_paranoid too strict), available()
+ * is false and every value reads as -1, so callers can fall back to timing.
+ */
+
+enum class CounterKind { Instructions, Cycles, CacheMisses, BranchMisses };
+
+struct CounterValues {
+    std::array<long long, 4> values{-1, -1, -1, -1};
+    double runningFraction = 1.0;  // Share of the time the group was on the PMU
+
+    long long operator[](CounterKind kind) const { return values[static_cast<int>(kind)]; }
+    bool has(CounterKind kind) const { return (*this)[kind] >= 0; }
+};
+
+class HardwareCounters {
+private:
+    std::array<int, 4> descriptors{-1, -1, -1, -1};
+    int leader = -1;  // Group leader: the first counter that could be opened
+
+#if defined(__linux__)
+    static int open(std::uint64_t config, int groupLeader) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        // Members follow the leader, which starts disabled
+        attr.disabled = groupLeader < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupLeader, 0));
+    }
+#endif
+
+public:
+    HardwareCounters() {
+#if defined(__linux__)
+        const std::uint64_t configs[] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES,
+                                         PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (std::size_t i = 0; i < descriptors.size(); ++i) {
+            descriptors[i] = open(configs[i], leader);
+            if (leader < 0) {
+                leader = descriptors[i];
+            }
+        }
+#endif
+    }
+
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    ~HardwareCounters() {
+#if defined(__linux__)
+        for (int fd : descriptors) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    // True if at least one counter could be opened
+    bool available() const { return leader >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        if (leader >= 0) {
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    CounterValues stop() {
+        CounterValues result;
+#if defined(__linux__)
+        if (leader < 0) {
+            return result;
+        }
+        ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then one
+        // value per member in the order they joined the group
+        std::uint64_t data[3 + 4] = {};
+        ssize_t bytes = read(leader, data, sizeof(data));
+        if (bytes < static_cast<ssize_t>(3 * sizeof(std::uint64_t))) {
+            return result;
+        }
+        std::uint64_t members = data[0];
+        std::uint64_t enabled = data[1];
+        std::uint64_t running = data[2];
+        if (running == 0) {
+            return result;  // The group never got onto the PMU
+        }
+        double scale = static_cast<double>(enabled) / static_cast<double>(running);
+        result.runningFraction = static_cast<double>(running) / static_cast<double>(enabled);
+        std::size_t member = 0;
+        for (std::size_t i = 0; i < descriptors.size() && member < members; ++i) {
+            if (descriptors[i] >= 0) {
+                result.values[i] = static_cast<long long>(static_cast<double>(data[3 + member]) * scale);
+                ++member;
+            }
+        }
+#endif
+        return result;
+    }
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+/**
+ * PolyCollection<Base>
+ *
+ * A container for objects of several classes derived from Base that keeps
+ * every dynamic type in its own contiguous segment (a std::vector<T>),
+ * in the spirit of Boost.PolyCollection.
+ *
+ * - emplace<T>(args...) constructs a T in the segment for T
+ * - for_each(f) visits all elements as Base&, one segment (type) at a time,
+ *   so the indirect branch of a virtual call keeps hitting the same target
+ * - for_each<Ts...>(f) visits the segments of Ts as their concrete types
+ *   first (f receives T&); if T is final the compiler can devirtualize
+ *   and inline the calls. Remaining segments are visited as Base&.
+ * - segment<T>() gives direct access to one segment as a std::span
+ *
+ * Elements are stored by value: T must be exactly the dynamic type, and
+ * adding to a segment may move its elements (like std::vector growth),
+ * invalidating references into that segment. Iteration order is by type,
+ * not by insertion.
+ */
+
+template <typename Base>
+class PolyCollection {
+private:
+    struct SegmentBase {
+        std::type_index type;
+
+        explicit SegmentBase(std::type_index segmentType) : type(segmentType) {}
+        virtual ~SegmentBase() = default;
+        virtual std::size_t size() const = 0;
+        virtual void clear() = 0;
+        // One virtual call per segment; visit is then called once per element
+        virtual void visitAll(void (*visit)(void* context, Base& item), void* context) = 0;
+    };
+
+    template <typename T>
+    struct Segment final : SegmentBase {
+        std::vector<T> items;
+
+        Segment() : SegmentBase(typeid(T)) {}
+        std::size_t size() const override { return items.size(); }
+        void clear() override { items.clear(); }
+
+        void visitAll(void (*visit)(void* context, Base& item), void* context) override {
+            for (T& item : items) {
+                visit(context, item);
+            }
+        }
+    };
+
+    // Few distinct types are expected, so a linear search beats a hash map
+    std::vector<std::unique_ptr<SegmentBase>> segments;
+
+    template <typename T>
+    Segment<T>* find() const {
+        for (const auto& segment : segments) {
+            if (segment->type == typeid(T)) {
+                return static_cast<Segment<T>*>(segment.get());
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    Segment<T>& findOrCreate() {
+        if (Segment<T>* segment = find<T>()) {
+            return *segment;
+        }
+        auto created = std::make_unique<Segment<T>>();
+        Segment<T>& segment = *created;
+        segments.push_back(std::move(created));
+        return segment;
+    }
+
+    template <typename T>
+    bool isOneOf(const SegmentBase& segment) const {
+        return segment.type == typeid(T);
+    }
+
+    template <typename F>
+    static void visitAsBase(SegmentBase& segment, F& f) {
+        segment.visitAll([](void* context, Base& item) { (*static_cast<F*>(context))(item); }, &f);
+    }
+
+public:
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        static_assert(std::is_base_of_v<Base, T>, "PolyCollection: T must derive from Base");
+        return findOrCreate<T>().items.emplace_back(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void reserve(std::size_t count) {
+        findOrCreate<T>().items.reserve(count);
+    }
+
+    template <typename T>
+    std::span<T> segment() {
+        Segment<T>* found = find<T>();
+        return found ? std::span<T>(found->items) : std::span<T>();
+    }
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (const auto& segment : segments) {
+            total += segment->size();
+        }
+        return total;
+    }
+
+    std::size_t segmentCount() const { return segments.size(); }
+
+    void clear() {
+        for (const auto& segment : segments) {
+            segment->clear();
+        }
+    }
+
+    // Visits every element as Base&, segment by segment
+    template <typename F>
+    void for_each(F&& f) {
+        for (const auto& segment : segments) {
+            visitAsBase(*segment, f);
+        }
+    }
+
+    // Visits the segments of Ts with their concrete types, then the rest as Base&
+    template <typename T, typename... Ts, typename F>
+    void for_each(F&& f) {
+        auto visitSegment = [&](auto* typed) {
+            if (typed) {
+                for (auto& item : typed->items) {
+                    f(item);
+                }
+            }
+        };
+        visitSegment(find<T>());
+        (visitSegment(find<Ts>()), ...);
+
+        for (const auto& segment : segments) {
+            if (!(isOneOf<T>(*segment) || (isOneOf<Ts>(*segment) || ...))) {
+                visitAsBase(*segment, f);
+            }
+        }
+    }
+};
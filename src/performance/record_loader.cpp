@@ -0,0 +1,854 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <filesystem>
+#include <stdexcept>
+#include <limits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "bench.h"
+
+/**
+ * Memory-Mapped Bulk Loading of Student and Course Records
+ *
+ * This example demonstrates:
+ * - A compact binary file format: fixed-size records plus shared grade
+ *   and string sections, all at fixed offsets from a small header
+ * - Loading the file with mmap and reading records in place through
+ *   lightweight views (no parsing, no copying, no allocations)
+ * - A one-off CSV importer that converts text into the binary format
+ * - Comparing CSV parsing with mmap loading, warm and cold (page cache
+ *   dropped), and with the cost of just faulting in every page
+ *
+ * Requires a POSIX system (mmap). Usage:
+ *   ./perf_record_loader [studentCount] [directory]   (default: 1000000, temp dir)
+ */
+
+// ---------------------------------------------------------------------------
+// Reference classes from src/oop/classes.cpp (without logging)
+// ---------------------------------------------------------------------------
+
+class Student {
+private:
+    std::string name;
+    int age;
+    std::vector<double> grades;
+
+public:
+    Student(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+
+    void addGrade(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            grades.push_back(grade);
+        }
+    }
+
+    double getAverageGrade() const {
+        if (grades.empty()) {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (double grade : grades) {
+            sum += grade;
+        }
+        return sum / grades.size();
+    }
+
+    std::string getName() const { return name; }
+    int getAge() const { return age; }
+};
+
+class Course {
+private:
+    std::string courseName;
+    std::string instructor;
+    int credits;
+
+public:
+    Course(const std::string& name, const std::string& instructorName, int creditHours)
+        : courseName(name), instructor(instructorName), credits(creditHours) {}
+
+    std::string getCourseName() const { return courseName; }
+    std::string getInstructor() const { return instructor; }
+    int getCredits() const { return credits; }
+};
+
+// ---------------------------------------------------------------------------
+// MappedFile: RAII wrapper around open + mmap
+// ---------------------------------------------------------------------------
+
+class MappedFile {
+private:
+    int fd = -1;
+    char* bytes = nullptr;
+    std::size_t length = 0;
+
+    static std::runtime_error error(const std::string& what, const std::string& path) {
+        return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+    }
+
+public:
+    MappedFile() = default;
+
+    // Maps an existing file read-only. With populate, all pages are faulted
+    // in up front (MAP_POPULATE) instead of on first access.
+    static MappedFile openReadOnly(const std::string& path, bool populate = false) {
+        MappedFile file;
+        file.fd = ::open(path.c_str(), O_RDONLY);
+        if (file.fd < 0) {
+            throw error("cannot open", path);
+        }
+        struct stat info;
+        if (fstat(file.fd, &info) != 0) {
+            throw error("cannot stat", path);
+        }
+        file.length = static_cast<std::size_t>(info.st_size);
+        if (file.length > 0) {
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            if (populate) {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            void* address = mmap(nullptr, file.length, PROT_READ, flags, file.fd, 0);
+            if (address == MAP_FAILED) {
+                throw error("cannot map", path);
+            }
+            file.bytes = static_cast<char*>(address);
+            // Records are read front to back: let the kernel read ahead aggressively
+            madvise(address, file.length, MADV_SEQUENTIAL);
+        }
+        return file;
+    }
+
+    // Creates (or truncates) a file of exactly `size` bytes and maps it writable
+    static MappedFile create(const std::string& path, std::size_t size) {
+        MappedFile file;
+        file.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file.fd < 0) {
+            throw error("cannot create", path);
+        }
+        if (ftruncate(file.fd, static_cast<off_t>(size)) != 0) {
+            throw error("cannot resize", path);
+        }
+        file.length = size;
+        if (size > 0) {
+            void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+            if (address == MAP_FAILED) {
+                throw error("cannot map", path);
+            }
+            file.bytes = static_cast<char*>(address);
+        }
+        return file;
+    }
+
+    MappedFile(MappedFile&& other) noexcept
+        : fd(std::exchange(other.fd, -1)), bytes(std::exchange(other.bytes, nullptr)),
+          length(std::exchange(other.length, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            fd = std::exchange(other.fd, -1);
+            bytes = std::exchange(other.bytes, nullptr);
+            length = std::exchange(other.length, 0);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { close(); }
+
+    void close() {
+        if (bytes != nullptr) {
+            munmap(bytes, length);
+            bytes = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        length = 0;
+    }
+
+    // Writes dirty pages back and evicts the file from the page cache,
+    // so the next mapping starts cold
+    void dropFromPageCache() {
+        if (bytes != nullptr) {
+            msync(bytes, length, MS_SYNC);
+        }
+        if (fd >= 0) {
+            fsync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        }
+    }
+
+    char* data() { return bytes; }
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+};
+
+// ---------------------------------------------------------------------------
+// Binary record format
+//
+//   FileHeader | StudentRecord[] | CourseRecord[] | double grades[] | strings
+//
+// Every section starts at an 8-byte aligned offset stored in the header.
+// Strings are referenced by (offset, length) into the string section and
+// grades by (first, count) into the grade section. Integers are stored in
+// the host byte order; the header records it so foreign files are rejected.
+// ---------------------------------------------------------------------------
+
+namespace records {
+
+constexpr char fileMagic[8] = {'S', 'T', 'U', 'R', 'E', 'C', 'S', '\0'};
+constexpr std::uint32_t formatVersion = 1;
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t studentCount;
+    std::uint64_t courseCount;
+    std::uint64_t gradeCount;
+    std::uint64_t stringBytes;
+    std::uint64_t studentOffset;
+    std::uint64_t courseOffset;
+    std::uint64_t gradeOffset;
+    std::uint64_t stringOffset;
+};
+
+struct StudentRecord {
+    std::uint64_t nameOffset;
+    std::uint64_t firstGrade;
+    std::uint32_t nameLength;
+    std::uint32_t gradeCount;
+    std::int32_t age;
+    std::uint32_t reserved;
+};
+
+struct CourseRecord {
+    std::uint64_t nameOffset;
+    std::uint64_t instructorOffset;
+    std::uint32_t nameLength;
+    std::uint32_t instructorLength;
+    std::int32_t credits;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 80, "FileHeader layout must not change");
+static_assert(sizeof(StudentRecord) == 32, "StudentRecord layout must not change");
+static_assert(sizeof(CourseRecord) == 32, "CourseRecord layout must not change");
+
+constexpr std::uint64_t alignUp(std::uint64_t value) { return (value + 7) & ~std::uint64_t(7); }
+
+// True if [offset, offset + length) lies inside [0, limit), without the
+// addition being able to wrap around
+constexpr bool rangeFits(std::uint64_t offset, std::uint64_t length, std::uint64_t limit) {
+    return length <= limit && offset <= limit - length;
+}
+
+// Computes where every section goes for the given totals. The arithmetic is
+// unchecked: callers must bound the counts first (see validateHeader)
+FileHeader makeHeader(std::uint64_t students, std::uint64_t courses, std::uint64_t grades,
+                      std::uint64_t stringBytes) {
+    FileHeader header{};
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = formatVersion;
+    header.byteOrder = byteOrderMark;
+    header.studentCount = students;
+    header.courseCount = courses;
+    header.gradeCount = grades;
+    header.stringBytes = stringBytes;
+    header.studentOffset = alignUp(sizeof(FileHeader));
+    header.courseOffset = alignUp(header.studentOffset + students * sizeof(StudentRecord));
+    header.gradeOffset = alignUp(header.courseOffset + courses * sizeof(CourseRecord));
+    header.stringOffset = header.gradeOffset + grades * sizeof(double);
+    return header;
+}
+
+std::uint64_t fileSize(const FileHeader& header) { return header.stringOffset + header.stringBytes; }
+
+} // namespace records
+
+// Read-only view of one student record inside a mapped file
+class StudentView {
+private:
+    const records::StudentRecord* record;
+    const double* grades;
+    const char* strings;
+
+public:
+    StudentView(const records::StudentRecord* studentRecord, const double* gradeSection,
+                const char* stringSection)
+        : record(studentRecord), grades(gradeSection), strings(stringSection) {}
+
+    std::string_view getName() const { return {strings + record->nameOffset, record->nameLength}; }
+    int getAge() const { return record->age; }
+    std::span<const double> getGrades() const { return {grades + record->firstGrade, record->gradeCount}; }
+
+    // Same summation order as Student::getAverageGrade, so results are identical
+    double getAverageGrade() const {
+        if (record->gradeCount == 0) {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (double grade : getGrades()) {
+            sum += grade;
+        }
+        return sum / record->gradeCount;
+    }
+
+    // Materializes a full Student when an owning object is really needed
+    Student toStudent() const {
+        Student student(std::string(getName()), getAge());
+        for (double grade : getGrades()) {
+            student.addGrade(grade);
+        }
+        return student;
+    }
+};
+
+// Read-only view of one course record inside a mapped file
+class CourseView {
+private:
+    const records::CourseRecord* record;
+    const char* strings;
+
+public:
+    CourseView(const records::CourseRecord* courseRecord, const char* stringSection)
+        : record(courseRecord), strings(stringSection) {}
+
+    std::string_view getCourseName() const { return {strings + record->nameOffset, record->nameLength}; }
+    std::string_view getInstructor() const {
+        return {strings + record->instructorOffset, record->instructorLength};
+    }
+    int getCredits() const { return record->credits; }
+
+    Course toCourse() const {
+        return Course(std::string(getCourseName()), std::string(getInstructor()), getCredits());
+    }
+};
+
+// ---------------------------------------------------------------------------
+// RecordFile: opens a binary record file and hands out views
+// ---------------------------------------------------------------------------
+
+class RecordFile {
+private:
+    MappedFile file;
+    const records::FileHeader* header = nullptr;
+    const records::StudentRecord* studentRecords = nullptr;
+    const records::CourseRecord* courseRecords = nullptr;
+    const double* grades = nullptr;
+    const char* strings = nullptr;
+
+    static void check(bool condition, const char* message) {
+        if (!condition) {
+            throw std::runtime_error(std::string("invalid record file: ") + message);
+        }
+    }
+
+    // O(1) validation: only the header is inspected, records are trusted
+    // until verify() is called
+    void validateHeader() {
+        check(file.size() >= sizeof(records::FileHeader), "too small for a header");
+        header = reinterpret_cast<const records::FileHeader*>(file.data());
+        check(std::memcmp(header->magic, records::fileMagic, sizeof(records::fileMagic)) == 0, "bad magic");
+        check(header->version == records::formatVersion, "unsupported version");
+        check(header->byteOrder == records::byteOrderMark, "foreign byte order");
+
+        // Bound every count by what the file could possibly hold before any
+        // offset is computed, so makeHeader cannot overflow
+        const std::uint64_t size = file.size();
+        check(header->studentCount <= size / sizeof(records::StudentRecord), "student count exceeds file size");
+        check(header->courseCount <= size / sizeof(records::CourseRecord), "course count exceeds file size");
+        check(header->gradeCount <= size / sizeof(double), "grade count exceeds file size");
+        check(header->stringBytes <= size, "string section exceeds file size");
+
+        records::FileHeader expected = records::makeHeader(header->studentCount, header->courseCount,
+                                                           header->gradeCount, header->stringBytes);
+        check(header->studentOffset == expected.studentOffset && header->courseOffset == expected.courseOffset &&
+                  header->gradeOffset == expected.gradeOffset && header->stringOffset == expected.stringOffset,
+              "section offsets do not match the counts");
+        check(records::fileSize(*header) <= file.size(), "truncated");
+
+        const char* base = file.data();
+        studentRecords = reinterpret_cast<const records::StudentRecord*>(base + header->studentOffset);
+        courseRecords = reinterpret_cast<const records::CourseRecord*>(base + header->courseOffset);
+        grades = reinterpret_cast<const double*>(base + header->gradeOffset);
+        strings = base + header->stringOffset;
+    }
+
+public:
+    explicit RecordFile(const std::string& path, bool populate = false)
+        : file(MappedFile::openReadOnly(path, populate)) {
+        validateHeader();
+    }
+
+    std::size_t studentCount() const { return header->studentCount; }
+    std::size_t courseCount() const { return header->courseCount; }
+
+    StudentView student(std::size_t index) const { return {studentRecords + index, grades, strings}; }
+    CourseView course(std::size_t index) const { return {courseRecords + index, strings}; }
+
+    // O(n) check that every record points inside its sections
+    void verify() const {
+        for (std::size_t i = 0; i < studentCount(); ++i) {
+            const records::StudentRecord& record = studentRecords[i];
+            check(records::rangeFits(record.nameOffset, record.nameLength, header->stringBytes),
+                  "student name out of range");
+            check(records::rangeFits(record.firstGrade, record.gradeCount, header->gradeCount),
+                  "student grades out of range");
+        }
+        for (std::size_t i = 0; i < courseCount(); ++i) {
+            const records::CourseRecord& record = courseRecords[i];
+            check(records::rangeFits(record.nameOffset, record.nameLength, header->stringBytes),
+                  "course name out of range");
+            check(records::rangeFits(record.instructorOffset, record.instructorLength, header->stringBytes),
+                  "course instructor out of range");
+        }
+    }
+
+    const MappedFile& mapping() const { return file; }
+};
+
+// ---------------------------------------------------------------------------
+// CSV import
+//
+//   student,<name>,<age>,<grade>;<grade>;...
+//   course,<name>,<instructor>,<credits>
+//
+// Fields may not contain commas, semicolons or newlines (no quoting).
+// ---------------------------------------------------------------------------
+
+namespace csv {
+
+// Splits `line` at the next `separator`, returning the part before it
+std::string_view nextField(std::string_view& line, char separator) {
+    std::size_t end = line.find(separator);
+    std::string_view field = line.substr(0, end);
+    line.remove_prefix(end == std::string_view::npos ? line.size() : end + 1);
+    return field;
+}
+
+template <typename Number>
+Number parseNumber(std::string_view text, std::size_t lineNumber) {
+    Number value{};
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        throw std::runtime_error("line " + std::to_string(lineNumber) + ": bad number '" +
+                                 std::string(text) + "'");
+    }
+    return value;
+}
+
+// Record lengths are stored as 32 bits; longer strings are rejected
+std::string_view checkedString(std::string_view value, std::size_t lineNumber) {
+    if (value.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("line " + std::to_string(lineNumber) + ": field longer than 4 GiB");
+    }
+    return value;
+}
+
+struct Totals {
+    std::uint64_t students = 0;
+    std::uint64_t courses = 0;
+    std::uint64_t grades = 0;
+    std::uint64_t stringBytes = 0;
+};
+
+// Calls onLine(line, lineNumber) for every non-empty line of the text
+template <typename OnLine>
+void forEachLine(std::string_view text, OnLine&& onLine) {
+    std::size_t lineNumber = 0;
+    while (!text.empty()) {
+        std::string_view line = nextField(text, '\n');
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (!line.empty()) {
+            onLine(line, lineNumber);
+        }
+    }
+}
+
+// Pass 1: counts records, grades and string bytes to size the output
+Totals measure(std::string_view text) {
+    Totals totals;
+    forEachLine(text, [&](std::string_view line, std::size_t lineNumber) {
+        std::string_view kind = nextField(line, ',');
+        if (kind == "student") {
+            ++totals.students;
+            totals.stringBytes += checkedString(nextField(line, ','), lineNumber).size();
+            nextField(line, ',');
+            std::string_view gradeList = nextField(line, ',');
+            while (!gradeList.empty()) {
+                nextField(gradeList, ';');
+                ++totals.grades;
+            }
+        } else if (kind == "course") {
+            ++totals.courses;
+            totals.stringBytes += checkedString(nextField(line, ','), lineNumber).size();
+            totals.stringBytes += checkedString(nextField(line, ','), lineNumber).size();
+        } else {
+            throw std::runtime_error("line " + std::to_string(lineNumber) + ": unknown record type");
+        }
+    });
+    return totals;
+}
+
+// Converts CSV text into the binary record format in two passes: the first
+// sizes the output file, the second writes every record straight into the
+// mapped output.
+records::FileHeader writeRecords(std::string_view text, const std::string& outputPath) {
+    Totals totals = measure(text);
+    records::FileHeader header =
+        records::makeHeader(totals.students, totals.courses, totals.grades, totals.stringBytes);
+    MappedFile output = MappedFile::create(outputPath, records::fileSize(header));
+
+    char* base = output.data();
+    std::memcpy(base, &header, sizeof(header));
+    auto* students = reinterpret_cast<records::StudentRecord*>(base + header.studentOffset);
+    auto* courses = reinterpret_cast<records::CourseRecord*>(base + header.courseOffset);
+    auto* grades = reinterpret_cast<double*>(base + header.gradeOffset);
+    char* strings = base + header.stringOffset;
+
+    std::uint64_t gradeCursor = 0;
+    std::uint64_t stringCursor = 0;
+    auto storeString = [&](std::string_view value) {
+        std::memcpy(strings + stringCursor, value.data(), value.size());
+        stringCursor += value.size();
+        return stringCursor - value.size();
+    };
+
+    forEachLine(text, [&](std::string_view line, std::size_t lineNumber) {
+        std::string_view kind = nextField(line, ',');
+        if (kind == "student") {
+            records::StudentRecord record{};
+            std::string_view name = checkedString(nextField(line, ','), lineNumber);
+            record.nameOffset = storeString(name);
+            record.nameLength = static_cast<std::uint32_t>(name.size());
+            record.age = parseNumber<std::int32_t>(nextField(line, ','), lineNumber);
+            record.firstGrade = gradeCursor;
+            std::string_view gradeList = nextField(line, ',');
+            while (!gradeList.empty()) {
+                double grade = parseNumber<double>(nextField(gradeList, ';'), lineNumber);
+                // Same rule as Student::addGrade: out-of-range grades are dropped
+                if (grade >= 0.0 && grade <= 100.0) {
+                    grades[gradeCursor++] = grade;
+                    ++record.gradeCount;
+                }
+            }
+            *students++ = record;
+        } else {
+            records::CourseRecord record{};
+            std::string_view name = checkedString(nextField(line, ','), lineNumber);
+            std::string_view instructor = checkedString(nextField(line, ','), lineNumber);
+            record.nameOffset = storeString(name);
+            record.nameLength = static_cast<std::uint32_t>(name.size());
+            record.instructorOffset = storeString(instructor);
+            record.instructorLength = static_cast<std::uint32_t>(instructor.size());
+            record.credits = parseNumber<std::int32_t>(nextField(line, ','), lineNumber);
+            *courses++ = record;
+        }
+    });
+
+    // Dropped grades leave unused slack at the end of the grade section;
+    // record the real count so verify() stays exact
+    if (gradeCursor != header.gradeCount) {
+        records::FileHeader packed = records::makeHeader(header.studentCount, header.courseCount,
+                                                         gradeCursor, header.stringBytes);
+        std::memmove(base + packed.stringOffset, strings, header.stringBytes);
+        std::memcpy(base, &packed, sizeof(packed));
+        header = packed;
+        output.close();
+        std::filesystem::resize_file(outputPath, records::fileSize(header));
+    }
+    return header;
+}
+
+// Converts a CSV file into a record file. The CSV is read through an mmap and
+// the output is built under a temporary name that is only renamed to
+// binaryPath once it is complete, so a parse error never leaves a partial
+// record file behind.
+records::FileHeader importFile(const std::string& csvPath, const std::string& binaryPath) {
+    MappedFile input = MappedFile::openReadOnly(csvPath);
+    std::string temporaryPath = binaryPath + ".tmp." + std::to_string(getpid());
+    try {
+        records::FileHeader header = writeRecords(std::string_view(input.data(), input.size()), temporaryPath);
+        std::filesystem::rename(temporaryPath, binaryPath);
+        return header;
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(temporaryPath, ignored);
+        throw;
+    }
+}
+
+// The traditional path: parse every field into owning objects
+void parseIntoObjects(const std::string& csvPath, std::vector<Student>& students, std::vector<Course>& courses) {
+    MappedFile input = MappedFile::openReadOnly(csvPath);
+    forEachLine(std::string_view(input.data(), input.size()), [&](std::string_view line, std::size_t lineNumber) {
+        std::string_view kind = nextField(line, ',');
+        if (kind == "student") {
+            std::string name(nextField(line, ','));
+            int age = parseNumber<int>(nextField(line, ','), lineNumber);
+            Student& student = students.emplace_back(name, age);
+            std::string_view gradeList = nextField(line, ',');
+            while (!gradeList.empty()) {
+                student.addGrade(parseNumber<double>(nextField(gradeList, ';'), lineNumber));
+            }
+        } else if (kind == "course") {
+            std::string name(nextField(line, ','));
+            std::string instructor(nextField(line, ','));
+            courses.emplace_back(name, instructor, parseNumber<int>(nextField(line, ','), lineNumber));
+        }
+    });
+}
+
+} // namespace csv
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+struct PageFaults {
+    long minor = 0;
+    long major = 0;
+};
+
+PageFaults currentPageFaults() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return {usage.ru_minflt, usage.ru_majflt};
+}
+
+void writeSampleCsv(const std::string& path, std::size_t studentCount) {
+    std::ofstream out(path, std::ios::binary);
+    std::mt19937 rng(10);
+    std::uniform_int_distribution<int> gradeCount(1, 7);
+    std::uniform_int_distribution<int> halfPoints(0, 200);
+    std::string buffer;
+    char number[32];
+
+    for (std::size_t i = 0; i < studentCount; ++i) {
+        buffer += "student,Student";
+        buffer += std::to_string(i);
+        buffer += ',';
+        buffer += std::to_string(18 + i % 10);
+        buffer += ',';
+        int grades = gradeCount(rng);
+        for (int g = 0; g < grades; ++g) {
+            if (g > 0) {
+                buffer += ';';
+            }
+            auto result = std::to_chars(number, number + sizeof(number), halfPoints(rng) / 2.0);
+            buffer.append(number, result.ptr);
+        }
+        buffer += '\n';
+        if (i % 100 == 0) {
+            buffer += "course,Course" + std::to_string(i / 100) + ",Prof. " + std::to_string(i % 7) + "," +
+                      std::to_string(1 + i % 5) + "\n";
+        }
+        if (buffer.size() > (1 << 20)) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void demonstrateFormat(const std::string& directory) {
+    std::cout << "1. Converting a small CSV file and reading it through views:" << std::endl;
+    std::string csvPath = directory + "/records_demo.csv";
+    std::string binaryPath = directory + "/records_demo.bin";
+    {
+        std::ofstream out(csvPath);
+        out << "student,Alice,20,85.5;92;78.5\n"
+            << "student,Bob,22,88;91.5;150\n"  // 150 is dropped, as addGrade would
+            << "course,Computer Science 101,Dr. Smith,3\n"
+            << "student,Charlie,25,\n";
+    }
+    records::FileHeader header = csv::importFile(csvPath, binaryPath);
+    std::cout << "  Binary file: " << records::fileSize(header) << " bytes, " << header.studentCount
+              << " students, " << header.courseCount << " courses, " << header.gradeCount << " grades"
+              << std::endl;
+
+    RecordFile file(binaryPath);
+    file.verify();
+    for (std::size_t i = 0; i < file.studentCount(); ++i) {
+        StudentView view = file.student(i);
+        Student student = view.toStudent();
+        std::cout << "  " << view.getName() << ", age " << view.getAge() << ", " << view.getGrades().size()
+                  << " grades, average " << view.getAverageGrade() << " (Student object: "
+                  << student.getAverageGrade() << ")" << std::endl;
+    }
+    CourseView course = file.course(0);
+    std::cout << "  " << course.getCourseName() << " taught by " << course.getInstructor() << ", "
+              << course.getCredits() << " credits" << std::endl;
+
+    // A file that is not a record file is rejected by the O(1) header check
+    try {
+        RecordFile invalid(csvPath);
+    } catch (const std::runtime_error& e) {
+        std::cout << "  Opening the CSV as a record file: " << e.what() << std::endl;
+    }
+
+    // A crafted header whose counts make the section offsets wrap around to
+    // values that look consistent is rejected before any offset is computed
+    std::string craftedPath = directory + "/records_crafted.bin";
+    {
+        records::FileHeader crafted = records::makeHeader(std::uint64_t(1) << 59, 0, 0, 0);
+        std::ofstream out(craftedPath, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&crafted), sizeof(crafted));
+    }
+    try {
+        RecordFile invalid(craftedPath);
+        std::cout << "  Crafted header accepted with " << invalid.studentCount() << " students" << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cout << "  Opening a header claiming 2^59 students: " << e.what() << std::endl;
+    }
+
+    // A CSV error aborts the import without leaving a partial output file
+    {
+        std::ofstream out(csvPath);
+        out << "student,Dana,21,90\n"
+            << "student,Eve,twenty,80\n";
+    }
+    std::filesystem::remove(binaryPath);
+    try {
+        csv::importFile(csvPath, binaryPath);
+    } catch (const std::runtime_error& e) {
+        std::cout << "  Importing a malformed CSV: " << e.what() << ", output file exists: "
+                  << (std::filesystem::exists(binaryPath) ? "Yes" : "No") << std::endl;
+    }
+
+    std::filesystem::remove(csvPath);
+    std::filesystem::remove(binaryPath);
+    std::filesystem::remove(craftedPath);
+    std::cout << std::endl;
+}
+
+double sumOfAverages(const RecordFile& file) {
+    double sum = 0;
+    for (std::size_t i = 0; i < file.studentCount(); ++i) {
+        sum += file.student(i).getAverageGrade();
+    }
+    return sum;
+}
+
+void reportLoad(const std::string& label, double ms, const PageFaults& before, double checksum) {
+    PageFaults after = currentPageFaults();
+    std::cout << "  " << std::left << std::setw(34) << label << std::right << std::setw(10) << ms << " ms"
+              << "  page faults " << std::setw(7) << after.minor - before.minor << " minor / "
+              << after.major - before.major << " major"
+              << "  (checksum " << std::setprecision(12) << checksum << std::setprecision(6) << ")" << std::endl;
+}
+
+void benchmark(const std::string& directory, std::size_t studentCount) {
+    std::string csvPath = directory + "/records_bench.csv";
+    std::string binaryPath = directory + "/records_bench.bin";
+
+    std::cout << "2. Bulk loading " << studentCount << " students:" << std::endl;
+    writeSampleCsv(csvPath, studentCount);
+    std::cout << "  CSV file: " << std::filesystem::file_size(csvPath) / (1024 * 1024) << " MiB" << std::endl;
+
+    records::FileHeader header{};
+    double importMs = bench::timeMs([&] { header = csv::importFile(csvPath, binaryPath); });
+    std::cout << "  One-off CSV import: " << importMs << " ms, binary file "
+              << records::fileSize(header) / (1024 * 1024) << " MiB" << std::endl;
+    std::cout << std::endl;
+
+    // Traditional approach: parse every field into Student and Course objects
+    double parsedChecksum = 0;
+    {
+        std::vector<Student> students;
+        std::vector<Course> courses;
+        PageFaults before = currentPageFaults();
+        double ms = bench::timeMs([&] {
+            csv::parseIntoObjects(csvPath, students, courses);
+            for (const Student& student : students) {
+                parsedChecksum += student.getAverageGrade();
+            }
+        });
+        reportLoad("Parse CSV into objects (warm):", ms, before, parsedChecksum);
+    }
+
+    auto runMapped = [&](const std::string& label, bool cold, bool populate) {
+        if (cold) {
+            MappedFile::openReadOnly(binaryPath).dropFromPageCache();
+        }
+        PageFaults before = currentPageFaults();
+        double checksum = 0;
+        double ms = bench::timeMs([&] {
+            RecordFile file(binaryPath, populate);
+            checksum = sumOfAverages(file);
+        });
+        reportLoad(label, ms, before, checksum);
+        return checksum;
+    };
+
+    double mappedChecksum = runMapped("mmap + views (cold):", true, false);
+    runMapped("mmap + MAP_POPULATE + views (cold):", true, true);
+    runMapped("mmap + views (warm):", false, false);
+
+    // Lower bound: fault in every page of the file without looking at records
+    {
+        PageFaults before = currentPageFaults();
+        std::size_t touched = 0;
+        double ms = bench::timeMs([&] {
+            MappedFile file = MappedFile::openReadOnly(binaryPath);
+            const long pageSize = sysconf(_SC_PAGESIZE);
+            for (std::size_t offset = 0; offset < file.size(); offset += static_cast<std::size_t>(pageSize)) {
+                touched += static_cast<unsigned char>(file.data()[offset]);
+            }
+        });
+        reportLoad("Touch every page only (warm):", ms, before, static_cast<double>(touched));
+    }
+
+    std::cout << "  Results match: " << (parsedChecksum == mappedChecksum ? "Yes" : "No") << std::endl;
+    std::filesystem::remove(csvPath);
+    std::filesystem::remove(binaryPath);
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Memory-Mapped Record Loader ===" << std::endl;
+    std::cout << std::endl;
+
+    std::size_t studentCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::string directory = argc > 2 ? argv[2] : std::filesystem::temp_directory_path().string();
+
+    try {
+        demonstrateFormat(directory);
+        benchmark(directory, studentCount);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== End of Record Loader Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,457 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <malloc.h>
+#include "roaring_bitmap.h"
+#include "bench.h"
+
+/**
+ * Compressed Bitmaps for Integer ID Sets
+ *
+ * This example demonstrates:
+ * - RoaringBitmap (roaring_bitmap.h) running demonstrateSet from
+ *   containers.cpp with the same output as std::set<int>
+ * - Union, intersection and difference matching the std::set_union /
+ *   std::set_intersection / std::set_difference calls in algorithms.cpp
+ * - rank/select, and how array, bitmap and run containers are chosen
+ * - Random inserts, ranges and erases checked against std::set
+ * - Memory and throughput against std::set<int> for mostly dense IDs
+ * - Hundreds of millions of IDs, which std::set<int> could not hold here
+ *
+ * Usage: ./perf_roaring_bitmap [ids] [largeIds]   (default: 2000000 200000000)
+ */
+
+// Live heap bytes, as malloc hands them out (without its headers)
+static std::size_t liveBytes = 0;
+
+void* operator new(std::size_t size) {
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        liveBytes += malloc_usable_size(memory);
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+// Not inlined: GCC would see free() applied to the result of operator new
+[[gnu::noinline]] void operator delete(void* memory) noexcept {
+    liveBytes -= malloc_usable_size(memory);
+    std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void* memory, std::size_t) noexcept {
+    liveBytes -= malloc_usable_size(memory);
+    std::free(memory);
+}
+
+// ---------------------------------------------------------------------------
+// demonstrateSet and demonstrateSetAlgorithms, for any set type
+// ---------------------------------------------------------------------------
+
+template <typename Set>
+std::string runDemonstrateSet() {
+    std::ostringstream out;
+    Set mySet = {5, 2, 8, 1, 9};
+
+    // Set automatically sorts and removes duplicates
+    mySet.insert(3);
+    mySet.insert(5);  // Duplicate, won't be added
+
+    out << "  Set elements (sorted): ";
+    for (auto num : mySet) {
+        out << num << " ";
+    }
+    out << '\n';
+
+    // Set operations
+    out << "  Contains 5: " << (mySet.count(5) ? "Yes" : "No") << '\n';
+    out << "  Contains 10: " << (mySet.count(10) ? "Yes" : "No") << '\n';
+
+    mySet.erase(5);
+    out << "  After removing 5: ";
+    for (auto num : mySet) {
+        out << num << " ";
+    }
+    out << '\n';
+    return out.str();
+}
+
+void demonstrateDropIn() {
+    std::cout << "1. demonstrateSet with RoaringBitmap:" << std::endl;
+    std::string roaring = runDemonstrateSet<RoaringBitmap>();
+    std::cout << roaring;
+    std::cout << "  Output identical to std::set<int>: "
+              << (roaring == runDemonstrateSet<std::set<int>>() ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+void printValues(const char* label, const RoaringBitmap& set) {
+    std::cout << "  " << label;
+    for (std::uint32_t n : set) {
+        std::cout << n << " ";
+    }
+    std::cout << std::endl;
+}
+
+void demonstrateSetAlgorithms() {
+    std::cout << "2. demonstrateSetAlgorithms with RoaringBitmap:" << std::endl;
+
+    std::vector<int> set1 = {1, 2, 3, 4, 5};
+    std::vector<int> set2 = {3, 4, 5, 6, 7};
+    RoaringBitmap a(set1.begin(), set1.end());
+    RoaringBitmap b(set2.begin(), set2.end());
+
+    printValues("Union: ", a | b);
+    printValues("Intersection: ", a & b);
+    printValues("Difference (set1 - set2): ", a - b);
+
+    std::vector<int> unionResult, intersectionResult, differenceResult;
+    std::set_union(set1.begin(), set1.end(), set2.begin(), set2.end(), std::back_inserter(unionResult));
+    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), std::back_inserter(intersectionResult));
+    std::set_difference(set1.begin(), set1.end(), set2.begin(), set2.end(), std::back_inserter(differenceResult));
+    bool match = (a | b) == RoaringBitmap(unionResult.begin(), unionResult.end()) &&
+                 (a & b) == RoaringBitmap(intersectionResult.begin(), intersectionResult.end()) &&
+                 (a - b) == RoaringBitmap(differenceResult.begin(), differenceResult.end());
+    std::cout << "  Matches std::set_union/intersection/difference: " << (match ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+void printContainers(const RoaringBitmap& set) {
+    std::vector<std::size_t> counts = set.containerCounts();
+    std::cout << counts[0] << " array, " << counts[1] << " bitmap, " << counts[2] << " run chunks";
+}
+
+void demonstrateContainers() {
+    std::cout << "3. Containers, rank and select:" << std::endl;
+
+    RoaringBitmap ids;
+    for (std::uint32_t id = 0; id < 1000; ++id) {
+        ids.insert(id * 7);  // Sparse: an array
+    }
+    for (std::uint32_t id = 65536; id < 2 * 65536; id += 2) {
+        ids.insert(id);  // Every other value: a bitmap
+    }
+    ids.addRange(3 * 65536 + 100, 3 * 65536 + 60000);  // One long stretch: a run
+    std::cout << "  " << ids.size() << " IDs in " << ids.memoryBytes() << " bytes: ";
+    printContainers(ids);
+    std::cout << std::endl;
+
+    std::cout << "  rank(70000) = " << ids.rank(70000) << " IDs <= 70000, select(" << ids.rank(70000) - 1
+              << ") = " << ids.select(ids.rank(70000) - 1) << std::endl;
+    std::cout << "  select(0) = " << ids.select(0) << ", select(" << ids.size() - 1
+              << ") = " << ids.select(ids.size() - 1) << std::endl;
+    std::cout << std::endl;
+}
+
+// Compares every observable of ids with the reference; counts the chunk kinds seen
+bool sameAs(const RoaringBitmap& ids, const std::set<std::uint32_t>& reference, std::mt19937& rng,
+            std::vector<std::size_t>& kindsSeen) {
+    std::vector<std::size_t> counts = ids.containerCounts();
+    for (std::size_t kind = 0; kind < counts.size(); ++kind) {
+        kindsSeen[kind] += counts[kind];
+    }
+    if (ids.size() != reference.size() || !std::equal(ids.begin(), ids.end(), reference.begin(), reference.end())) {
+        return false;
+    }
+    std::vector<std::uint32_t> forEachValues;
+    ids.forEach([&](std::uint32_t value) { forEachValues.push_back(value); });
+    if (!std::equal(forEachValues.begin(), forEachValues.end(), reference.begin(), reference.end())) {
+        return false;
+    }
+    std::vector<std::uint32_t> values(reference.begin(), reference.end());
+    for (int probe = 0; probe < 64; ++probe) {
+        std::uint32_t value = rng() % (4 << 16);
+        auto after = std::upper_bound(values.begin(), values.end(), value);
+        std::size_t below = static_cast<std::size_t>(after - values.begin());
+        if (ids.contains(value) != (reference.count(value) == 1) || ids.rank(value) != below) {
+            return false;
+        }
+        if (!values.empty()) {
+            std::size_t index = rng() % values.size();
+            if (ids.select(index) != values[index]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void demonstrateRandomOperations() {
+    std::cout << "4. Random operations against std::set:" << std::endl;
+    std::mt19937 rng(24);
+    std::vector<std::size_t> kindsSeen(3, 0);
+    std::size_t operations = 0, checks = 0, mismatches = 0;
+    for (int round = 0; round < 100; ++round) {
+        RoaringBitmap ids;
+        std::set<std::uint32_t> reference;
+        // Four chunks, each filled sparsely (array), densely (bitmap) or in stretches (runs)
+        for (std::uint32_t chunk = 0; chunk < 4; ++chunk) {
+            std::uint32_t base = chunk << 16;
+            switch (rng() % 3) {
+            case 0:
+                for (std::uint32_t n = rng() % 3000; n > 0; --n) {
+                    std::uint32_t value = base + rng() % 65536;
+                    ids.insert(value);
+                    reference.insert(value);
+                    ++operations;
+                }
+                break;
+            case 1:
+                for (std::uint32_t n = 4000 + rng() % 8000; n > 0; --n) {
+                    std::uint32_t value = base + rng() % 16384;
+                    ids.insert(value);
+                    reference.insert(value);
+                    ++operations;
+                }
+                break;
+            default:
+                for (int stretch = 1 + rng() % 4; stretch > 0; --stretch) {
+                    std::uint32_t first = base + rng() % 60000;
+                    std::uint32_t last = first + 1 + rng() % 5000;
+                    ids.addRange(first, last);
+                    for (std::uint32_t value = first; value < last; ++value) {
+                        reference.insert(value);
+                    }
+                    ++operations;
+                }
+                break;
+            }
+        }
+        if (round % 2 == 0) {
+            ids.runOptimize();
+        }
+        ++checks;
+        mismatches += !sameAs(ids, reference, rng, kindsSeen);
+
+        // Erase present and absent values until most are gone: runs split,
+        // bitmaps fall back to arrays and chunks empty out
+        std::size_t target = reference.size() / (2 + rng() % 20);
+        for (std::size_t step = 0; reference.size() > target; ++step) {
+            std::uint32_t value = rng() % (4 << 16);
+            if (step % 2 == 0) {
+                auto present = reference.lower_bound(value);
+                value = present != reference.end() ? *present : *reference.begin();
+            }
+            ++operations;
+            if (ids.erase(value) != reference.erase(value)) {
+                ++mismatches;
+            }
+            if (step % 1024 == 0) {
+                ++checks;
+                mismatches += !sameAs(ids, reference, rng, kindsSeen);
+            }
+        }
+        ++checks;
+        mismatches += !sameAs(ids, reference, rng, kindsSeen);
+    }
+    std::cout << "  " << operations << " inserts, ranges and erases, " << checks << " checks of contents, "
+              << "rank and select, " << mismatches << " mismatches" << std::endl;
+    std::cout << "  Chunks checked: " << kindsSeen[0] << " array, " << kindsSeen[1] << " bitmap, " << kindsSeen[2]
+              << " run" << std::endl;
+    std::cout << "  Matches std::set: " << (mismatches == 0 ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+// About `count` IDs: each ID below count / density is present with that probability
+std::vector<std::uint32_t> denseIds(std::size_t count, double density, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution present(density);
+    std::vector<std::uint32_t> ids;
+    ids.reserve(count + count / 8);
+    std::uint32_t universe = static_cast<std::uint32_t>(static_cast<double>(count) / density);
+    for (std::uint32_t id = 0; id < universe; ++id) {
+        if (present(rng)) {
+            ids.push_back(id);
+        }
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+    return ids;
+}
+
+void benchmark(std::size_t count) {
+    std::cout << "5. " << count << " mostly dense IDs (80% of a range), std::set<int> vs RoaringBitmap:" << std::endl;
+    std::vector<std::uint32_t> idsA = denseIds(count, 0.8, 24);
+    std::vector<std::uint32_t> idsB = denseIds(count, 0.8, 25);
+
+    std::size_t before = liveBytes;
+    std::set<int> setA, setB;
+    double setBuildMs = bench::timeMs([&] {
+        for (std::uint32_t id : idsA) {
+            setA.insert(static_cast<int>(id));
+        }
+    });
+    std::size_t setBytes = liveBytes - before;
+    for (std::uint32_t id : idsB) {
+        setB.insert(static_cast<int>(id));
+    }
+
+    before = liveBytes;
+    RoaringBitmap roaringA, roaringB;
+    double roaringBuildMs = bench::timeMs([&] {
+        for (std::uint32_t id : idsA) {
+            roaringA.insert(id);
+        }
+    });
+    std::size_t roaringBytes = liveBytes - before;
+    for (std::uint32_t id : idsB) {
+        roaringB.insert(id);
+    }
+
+    std::mt19937 rng(26);
+    std::uniform_int_distribution<std::uint32_t> probe(0, static_cast<std::uint32_t>(count * 5 / 4));
+    std::vector<std::uint32_t> probes(1000000);
+    for (std::uint32_t& p : probes) {
+        p = probe(rng);
+    }
+    std::size_t setFound = 0, roaringFound = 0;
+    double setContainsMs = bench::timeMs([&] {
+        for (std::uint32_t p : probes) {
+            setFound += setA.count(static_cast<int>(p));
+        }
+    });
+    double roaringContainsMs = bench::timeMs([&] {
+        for (std::uint32_t p : probes) {
+            roaringFound += roaringA.contains(p);
+        }
+    });
+
+    long long setSum = 0, roaringSum = 0;
+    double setIterateMs = bench::timeMs([&] {
+        for (int id : setA) {
+            setSum += id;
+        }
+    });
+    double roaringIterateMs = bench::timeMs([&] { roaringA.forEach([&](std::uint32_t id) { roaringSum += id; }); });
+
+    // The std::set_* calls of algorithms.cpp, on the sets' sorted ranges
+    std::vector<int> setUnion, setIntersection, setDifference;
+    double setOpsMs = bench::timeMs([&] {
+        std::set_union(setA.begin(), setA.end(), setB.begin(), setB.end(), std::back_inserter(setUnion));
+        std::set_intersection(setA.begin(), setA.end(), setB.begin(), setB.end(),
+                              std::back_inserter(setIntersection));
+        std::set_difference(setA.begin(), setA.end(), setB.begin(), setB.end(), std::back_inserter(setDifference));
+    });
+    RoaringBitmap roaringUnion, roaringIntersection, roaringDifference;
+    double roaringOpsMs = bench::timeMs([&] {
+        roaringUnion = roaringA | roaringB;
+        roaringIntersection = roaringA & roaringB;
+        roaringDifference = roaringA - roaringB;
+    });
+    auto same = [](const RoaringBitmap& roaring, const std::vector<int>& values) {
+        return roaring.size() == values.size() && std::equal(roaring.begin(), roaring.end(), values.begin());
+    };
+    bool match = setFound == roaringFound && setSum == roaringSum && same(roaringUnion, setUnion) &&
+                 same(roaringIntersection, setIntersection) && same(roaringDifference, setDifference);
+
+    auto row = [](const char* what, double setValue, double roaringValue, const char* unit) {
+        std::cout << "  " << std::left << std::setw(28) << what << std::right << std::setw(12) << setValue
+                  << std::setw(14) << roaringValue << " " << std::setw(6) << unit << std::setw(9)
+                  << setValue / roaringValue << "x" << std::endl;
+    };
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  " << std::left << std::setw(28) << "" << std::right << std::setw(12) << "std::set"
+              << std::setw(14) << "RoaringBitmap" << std::endl;
+    row("Memory", static_cast<double>(setBytes) / 1e6, static_cast<double>(roaringBytes) / 1e6, "MB");
+    row("Bytes per ID", static_cast<double>(setBytes) / static_cast<double>(setA.size()),
+        static_cast<double>(roaringBytes) / static_cast<double>(roaringA.size()), "B");
+    row("Insert (shuffled)", setBuildMs, roaringBuildMs, "ms");
+    row("1M contains", setContainsMs, roaringContainsMs, "ms");
+    row("Iterate", setIterateMs, roaringIterateMs, "ms");
+    row("Union + intersection + diff", setOpsMs, roaringOpsMs, "ms");
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "  RoaringBitmap chunks: ";
+    printContainers(roaringA);
+    std::cout << std::endl;
+    std::cout << "  Results match: " << (match ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+void benchmarkLarge(std::size_t count) {
+    std::cout << "6. " << count << " IDs, RoaringBitmap only:" << std::endl;
+
+    // 75% dense IDs, and a second set of long stretches with gaps
+    RoaringBitmap dense, ranges;
+    std::mt19937_64 rng(27);
+    double buildMs = bench::timeMs([&] {
+        std::uint64_t universe = count * 5 / 4;
+        for (std::uint64_t base = 0; base < universe; base += 64) {
+            // Two random words ANDed: each bit is a hole with probability 1/4
+            std::uint64_t holes = rng() & rng();
+            for (std::uint64_t bits = ~holes; bits != 0; bits &= bits - 1) {
+                std::uint64_t id = base + static_cast<std::uint64_t>(std::countr_zero(bits));
+                if (id < universe) {
+                    dense.insert(static_cast<std::uint32_t>(id));
+                }
+            }
+        }
+    });
+    double rangesMs = bench::timeMs([&] {
+        for (std::uint64_t start = 0; start < count * 5 / 4; start += 100000) {
+            ranges.addRange(start, start + 90000);
+        }
+    });
+
+    std::size_t setBytesEstimate = 0;
+    {
+        std::size_t before = liveBytes;
+        std::set<int> sample;
+        for (int i = 0; i < 100000; ++i) {
+            sample.insert(i);
+        }
+        setBytesEstimate = (liveBytes - before) / 100000;
+    }
+
+    RoaringBitmap both;
+    double andMs = bench::timeMs([&] { both = dense & ranges; });
+    RoaringBitmap either;
+    double orMs = bench::timeMs([&] { either = dense | ranges; });
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Dense:  " << dense.size() << " IDs in " << static_cast<double>(dense.memoryBytes()) / 1e6
+              << " MB (std::set<int> would need ~"
+              << static_cast<double>(dense.size() * setBytesEstimate) / 1e9 << " GB), built in " << buildMs
+              << " ms" << std::endl;
+    std::cout << "  Ranges: " << ranges.size() << " IDs in " << static_cast<double>(ranges.memoryBytes()) / 1e6
+              << " MB (";
+    printContainers(ranges);
+    std::cout << "), built in " << rangesMs << " ms" << std::endl;
+    std::cout << "  Intersection: " << both.size() << " IDs in " << andMs << " ms; union: " << either.size()
+              << " IDs in " << orMs << " ms" << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "  Union size checks out: "
+              << (either.size() == dense.size() + ranges.size() - both.size() ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Compressed Bitmaps ===" << std::endl;
+    std::cout << std::endl;
+
+    std::size_t count = argc > 1 ? std::max<std::size_t>(std::strtoull(argv[1], nullptr, 10), 1000) : 2000000;
+    std::size_t largeCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000000;
+    largeCount = std::clamp<std::size_t>(largeCount, 1000, 3000000000);
+
+    demonstrateDropIn();
+    demonstrateSetAlgorithms();
+    demonstrateContainers();
+    demonstrateRandomOperations();
+    benchmark(count);
+    benchmarkLarge(largeCount);
+
+    std::cout << "=== End of Compressed Bitmaps Example ===" << std::endl;
+
+    return 0;
+}
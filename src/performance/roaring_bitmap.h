@@ -0,0 +1,792 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * RoaringBitmap
+ *
+ * A compressed set of 32-bit unsigned integers in the style of Roaring
+ * bitmaps, for large ID sets that std::set<int> stores one node per value:
+ *
+ * - Values are split by their high 16 bits into chunks of 65536. Each
+ *   chunk that has values owns one container for the low 16 bits:
+ *     array  - sorted uint16 values, for up to 4096 values (2 bytes each)
+ *     bitmap - 65536 bits (8 KB), for denser chunks
+ *     run    - sorted [start, last] ranges (4 bytes each), for values that
+ *              come in long consecutive stretches
+ *   Arrays and bitmaps convert into each other as values come and go.
+ *   Runs come from addRange() and runOptimize(), which picks runs for
+ *   every chunk where they are smaller.
+ * - insert, erase, contains, rank (values <= x), select (the i-th value),
+ *   and ordered iteration
+ * - Union, intersection and difference work chunk by chunk. Bitmap pairs
+ *   combine 256 bits per AVX2 instruction; array pairs use the std::set_*
+ *   algorithms; runs are expanded first. The results are the same as the
+ *   std::set_* calls on the sorted values.
+ */
+
+namespace roaring {
+
+constexpr std::size_t arrayLimit = 4096;   // Larger arrays become bitmaps
+constexpr std::size_t bitmapWords = 1024;  // 65536 bits
+
+struct Run {
+    std::uint16_t start;
+    std::uint16_t last;  // Inclusive
+};
+
+enum class Kind : std::uint8_t { Array, Bitmap, Run };
+
+enum class Operation { And, Or, AndNot };
+
+// out = a op b for two bitmaps; returns the number of bits set in out
+template <Operation op>
+std::uint32_t combineWords(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i < bitmapWords; i += 4) {
+        __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i result;
+        if constexpr (op == Operation::And) {
+            result = _mm256_and_si256(left, right);
+        } else if constexpr (op == Operation::Or) {
+            result = _mm256_or_si256(left, right);
+        } else {
+            result = _mm256_andnot_si256(right, left);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), result);
+    }
+#endif
+    for (; i < bitmapWords; ++i) {
+        if constexpr (op == Operation::And) {
+            out[i] = a[i] & b[i];
+        } else if constexpr (op == Operation::Or) {
+            out[i] = a[i] | b[i];
+        } else {
+            out[i] = a[i] & ~b[i];
+        }
+    }
+    std::uint32_t count = 0;
+    for (std::size_t word = 0; word < bitmapWords; ++word) {
+        count += static_cast<std::uint32_t>(std::popcount(out[word]));
+    }
+    return count;
+}
+
+// The values of one 65536-value chunk
+struct Container {
+    Kind kind = Kind::Array;
+    std::uint32_t cardinality = 0;
+    std::vector<std::uint16_t> array;
+    std::vector<std::uint64_t> bits;
+    std::vector<Run> runs;
+
+    static bool testBit(const std::vector<std::uint64_t>& words, std::uint32_t value) {
+        return (words[value >> 6] >> (value & 63)) & 1;
+    }
+
+    // First set bit at or after from, or -1
+    int nextSetBit(std::uint32_t from) const {
+        std::size_t word = from >> 6;
+        if (word >= bitmapWords) {
+            return -1;
+        }
+        std::uint64_t bitsLeft = bits[word] & (~std::uint64_t(0) << (from & 63));
+        while (bitsLeft == 0) {
+            if (++word == bitmapWords) {
+                return -1;
+            }
+            bitsLeft = bits[word];
+        }
+        return static_cast<int>(word * 64 + static_cast<std::size_t>(std::countr_zero(bitsLeft)));
+    }
+
+    // First run whose last value is >= value
+    std::size_t runIndex(std::uint16_t value) const {
+        return static_cast<std::size_t>(
+            std::lower_bound(runs.begin(), runs.end(), value, [](const Run& run, std::uint16_t v) { return run.last < v; }) -
+            runs.begin());
+    }
+
+    bool contains(std::uint16_t value) const {
+        switch (kind) {
+        case Kind::Array:
+            return std::binary_search(array.begin(), array.end(), value);
+        case Kind::Bitmap:
+            return testBit(bits, value);
+        case Kind::Run: {
+            std::size_t index = runIndex(value);
+            return index < runs.size() && runs[index].start <= value;
+        }
+        }
+        return false;
+    }
+
+    template <typename Func>
+    void forEach(std::uint32_t high, Func&& func) const {
+        switch (kind) {
+        case Kind::Array:
+            for (std::uint16_t value : array) {
+                func(high | value);
+            }
+            break;
+        case Kind::Bitmap:
+            for (std::size_t word = 0; word < bitmapWords; ++word) {
+                for (std::uint64_t w = bits[word]; w != 0; w &= w - 1) {
+                    func(high | static_cast<std::uint32_t>(word * 64 + static_cast<std::size_t>(std::countr_zero(w))));
+                }
+            }
+            break;
+        case Kind::Run:
+            for (const Run& run : runs) {
+                for (std::uint32_t value = run.start; value <= run.last; ++value) {
+                    func(high | value);
+                }
+            }
+            break;
+        }
+    }
+
+    void toBitmap() {
+        std::vector<std::uint64_t> words(bitmapWords, 0);
+        forEach(0, [&](std::uint32_t value) { words[value >> 6] |= std::uint64_t(1) << (value & 63); });
+        bits = std::move(words);
+        array = {};
+        runs = {};
+        kind = Kind::Bitmap;
+    }
+
+    void toArray() {
+        std::vector<std::uint16_t> values;
+        values.reserve(cardinality);
+        forEach(0, [&](std::uint32_t value) { values.push_back(static_cast<std::uint16_t>(value)); });
+        array = std::move(values);
+        bits = {};
+        runs = {};
+        kind = Kind::Array;
+    }
+
+    // Array or bitmap, whichever the cardinality calls for
+    void normalize() {
+        if (kind != Kind::Bitmap && cardinality > arrayLimit) {
+            toBitmap();
+        } else if (kind != Kind::Array && cardinality <= arrayLimit) {
+            toArray();
+        }
+    }
+
+    std::size_t runCount() const {
+        switch (kind) {
+        case Kind::Array: {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < array.size(); ++i) {
+                count += i == 0 || array[i] != array[i - 1] + 1;
+            }
+            return count;
+        }
+        case Kind::Bitmap: {
+            // A run starts at every set bit whose lower neighbour is clear
+            std::size_t count = 0;
+            std::uint64_t carry = 0;
+            for (std::uint64_t word : bits) {
+                count += static_cast<std::size_t>(std::popcount(word & ~((word << 1) | carry)));
+                carry = word >> 63;
+            }
+            return count;
+        }
+        case Kind::Run:
+            return runs.size();
+        }
+        return 0;
+    }
+
+    // Payload bytes in the current representation
+    std::size_t bytes() const {
+        return array.capacity() * sizeof(std::uint16_t) + bits.capacity() * sizeof(std::uint64_t) +
+               runs.capacity() * sizeof(Run);
+    }
+
+    // Switches to runs if they take less memory than the current form
+    void runOptimize() {
+        std::size_t current = kind == Kind::Array ? cardinality * sizeof(std::uint16_t)
+                              : kind == Kind::Bitmap ? bitmapWords * sizeof(std::uint64_t)
+                                                     : runs.size() * sizeof(Run);
+        if (kind == Kind::Run || runCount() * sizeof(Run) >= current) {
+            return;
+        }
+        std::vector<Run> ranges;
+        forEach(0, [&](std::uint32_t value) {
+            if (!ranges.empty() && ranges.back().last + 1u == value) {
+                ranges.back().last = static_cast<std::uint16_t>(value);
+            } else {
+                ranges.push_back({static_cast<std::uint16_t>(value), static_cast<std::uint16_t>(value)});
+            }
+        });
+        runs = std::move(ranges);
+        array = {};
+        bits = {};
+        kind = Kind::Run;
+    }
+
+    // Gives up the run form once it is no longer the small one
+    void checkRuns() {
+        if (runs.size() * sizeof(Run) > std::min<std::size_t>(bitmapWords * sizeof(std::uint64_t),
+                                                               cardinality * sizeof(std::uint16_t))) {
+            normalize();
+        }
+    }
+
+    bool insert(std::uint16_t value) {
+        switch (kind) {
+        case Kind::Array: {
+            auto it = std::lower_bound(array.begin(), array.end(), value);
+            if (it != array.end() && *it == value) {
+                return false;
+            }
+            array.insert(it, value);
+            ++cardinality;
+            normalize();
+            return true;
+        }
+        case Kind::Bitmap: {
+            std::uint64_t& word = bits[value >> 6];
+            std::uint64_t bit = std::uint64_t(1) << (value & 63);
+            if (word & bit) {
+                return false;
+            }
+            word |= bit;
+            ++cardinality;
+            return true;
+        }
+        case Kind::Run: {
+            std::size_t index = runIndex(value);
+            if (index < runs.size() && runs[index].start <= value) {
+                return false;
+            }
+            bool joinsPrevious = index > 0 && runs[index - 1].last + 1u == value;
+            bool joinsNext = index < runs.size() && runs[index].start == value + 1u;
+            if (joinsPrevious && joinsNext) {
+                runs[index - 1].last = runs[index].last;
+                runs.erase(runs.begin() + static_cast<std::ptrdiff_t>(index));
+            } else if (joinsPrevious) {
+                runs[index - 1].last = value;
+            } else if (joinsNext) {
+                runs[index].start = value;
+            } else {
+                runs.insert(runs.begin() + static_cast<std::ptrdiff_t>(index), Run{value, value});
+            }
+            ++cardinality;
+            checkRuns();
+            return true;
+        }
+        }
+        return false;
+    }
+
+    bool erase(std::uint16_t value) {
+        switch (kind) {
+        case Kind::Array: {
+            auto it = std::lower_bound(array.begin(), array.end(), value);
+            if (it == array.end() || *it != value) {
+                return false;
+            }
+            array.erase(it);
+            --cardinality;
+            return true;
+        }
+        case Kind::Bitmap: {
+            std::uint64_t& word = bits[value >> 6];
+            std::uint64_t bit = std::uint64_t(1) << (value & 63);
+            if (!(word & bit)) {
+                return false;
+            }
+            word &= ~bit;
+            --cardinality;
+            normalize();
+            return true;
+        }
+        case Kind::Run: {
+            std::size_t index = runIndex(value);
+            if (index == runs.size() || runs[index].start > value) {
+                return false;
+            }
+            Run& run = runs[index];
+            if (run.start == run.last) {
+                runs.erase(runs.begin() + static_cast<std::ptrdiff_t>(index));
+            } else if (value == run.start) {
+                ++run.start;
+            } else if (value == run.last) {
+                --run.last;
+            } else {
+                Run upper{static_cast<std::uint16_t>(value + 1), run.last};
+                run.last = static_cast<std::uint16_t>(value - 1);
+                runs.insert(runs.begin() + static_cast<std::ptrdiff_t>(index + 1), upper);
+            }
+            --cardinality;
+            checkRuns();
+            return true;
+        }
+        }
+        return false;
+    }
+
+    // Values <= value
+    std::uint32_t rank(std::uint16_t value) const {
+        switch (kind) {
+        case Kind::Array:
+            return static_cast<std::uint32_t>(std::upper_bound(array.begin(), array.end(), value) - array.begin());
+        case Kind::Bitmap: {
+            std::uint32_t count = 0;
+            std::size_t word = value >> 6;
+            for (std::size_t i = 0; i < word; ++i) {
+                count += static_cast<std::uint32_t>(std::popcount(bits[i]));
+            }
+            std::uint64_t upTo = (value & 63) == 63 ? ~std::uint64_t(0) : (std::uint64_t(1) << ((value & 63) + 1)) - 1;
+            return count + static_cast<std::uint32_t>(std::popcount(bits[word] & upTo));
+        }
+        case Kind::Run: {
+            std::uint32_t count = 0;
+            for (const Run& run : runs) {
+                if (run.start > value) {
+                    break;
+                }
+                count += static_cast<std::uint32_t>(std::min(run.last, value) - run.start + 1);
+            }
+            return count;
+        }
+        }
+        return 0;
+    }
+
+    // The index-th smallest value; index < cardinality
+    std::uint16_t select(std::uint32_t index) const {
+        switch (kind) {
+        case Kind::Array:
+            return array[index];
+        case Kind::Bitmap:
+            for (std::size_t word = 0;; ++word) {
+                std::uint32_t count = static_cast<std::uint32_t>(std::popcount(bits[word]));
+                if (index < count) {
+                    std::uint64_t w = bits[word];
+                    for (; index > 0; --index) {
+                        w &= w - 1;
+                    }
+                    return static_cast<std::uint16_t>(word * 64 + static_cast<std::size_t>(std::countr_zero(w)));
+                }
+                index -= count;
+            }
+        case Kind::Run:
+            for (const Run& run : runs) {
+                std::uint32_t length = static_cast<std::uint32_t>(run.last - run.start + 1);
+                if (index < length) {
+                    return static_cast<std::uint16_t>(run.start + index);
+                }
+                index -= length;
+            }
+            break;
+        }
+        return 0;
+    }
+
+    bool operator==(const Container& other) const {
+        if (cardinality != other.cardinality) {
+            return false;
+        }
+        bool equal = true;
+        std::vector<std::uint16_t> values;
+        values.reserve(cardinality);
+        other.forEach(0, [&](std::uint32_t value) { values.push_back(static_cast<std::uint16_t>(value)); });
+        std::size_t i = 0;
+        forEach(0, [&](std::uint32_t value) { equal = equal && values[i++] == value; });
+        return equal;
+    }
+};
+
+// A copy of c as array or bitmap, the forms the set operations combine
+inline Container expanded(const Container& c) {
+    Container copy = c;
+    if (copy.kind == Kind::Run) {
+        copy.normalize();
+    }
+    return copy;
+}
+
+template <Operation op>
+Container combine(const Container& left, const Container& right) {
+    Container leftCopy, rightCopy;
+    const Container& a = left.kind == Kind::Run ? (leftCopy = expanded(left)) : left;
+    const Container& b = right.kind == Kind::Run ? (rightCopy = expanded(right)) : right;
+    Container result;
+
+    if (a.kind == Kind::Array && b.kind == Kind::Array) {
+        auto out = std::back_inserter(result.array);
+        if constexpr (op == Operation::And) {
+            std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+        } else if constexpr (op == Operation::Or) {
+            std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+        } else {
+            std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    } else if (a.kind == Kind::Bitmap && b.kind == Kind::Bitmap) {
+        result.kind = Kind::Bitmap;
+        result.bits.resize(bitmapWords);
+        result.cardinality = combineWords<op>(a.bits.data(), b.bits.data(), result.bits.data());
+    } else if constexpr (op == Operation::Or) {
+        const Container& bitmap = a.kind == Kind::Bitmap ? a : b;
+        const Container& array = a.kind == Kind::Bitmap ? b : a;
+        result = bitmap;
+        for (std::uint16_t value : array.array) {
+            result.cardinality += !Container::testBit(result.bits, value);
+            result.bits[value >> 6] |= std::uint64_t(1) << (value & 63);
+        }
+    } else if (a.kind == Kind::Array) {
+        // array & bitmap, array - bitmap: keep the array values the bitmap has (or lacks)
+        for (std::uint16_t value : a.array) {
+            if (Container::testBit(b.bits, value) == (op == Operation::And)) {
+                result.array.push_back(value);
+            }
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    } else if constexpr (op == Operation::And) {
+        for (std::uint16_t value : b.array) {
+            if (Container::testBit(a.bits, value)) {
+                result.array.push_back(value);
+            }
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    } else {
+        // bitmap - array
+        result = a;
+        for (std::uint16_t value : b.array) {
+            result.cardinality -= Container::testBit(result.bits, value);
+            result.bits[value >> 6] &= ~(std::uint64_t(1) << (value & 63));
+        }
+    }
+    result.normalize();
+    return result;
+}
+
+}  // namespace roaring
+
+class RoaringBitmap {
+private:
+    std::vector<std::uint16_t> keys;  // High 16 bits of each chunk, sorted
+    std::vector<roaring::Container> containers;
+    std::uint64_t valueCount = 0;
+
+    static std::uint16_t highBits(std::uint32_t value) { return static_cast<std::uint16_t>(value >> 16); }
+    static std::uint16_t lowBits(std::uint32_t value) { return static_cast<std::uint16_t>(value & 0xFFFF); }
+
+    std::size_t chunkIndex(std::uint16_t key) const {
+        return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+    }
+
+    bool hasChunk(std::size_t index, std::uint16_t key) const { return index < keys.size() && keys[index] == key; }
+
+    void removeChunk(std::size_t index) {
+        keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(index));
+        containers.erase(containers.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    template <roaring::Operation op>
+    static RoaringBitmap combine(const RoaringBitmap& a, const RoaringBitmap& b) {
+        using roaring::Operation;
+        RoaringBitmap result;
+        auto add = [&](std::uint16_t key, roaring::Container container) {
+            if (container.cardinality != 0) {
+                result.valueCount += container.cardinality;
+                result.keys.push_back(key);
+                result.containers.push_back(std::move(container));
+            }
+        };
+        std::size_t i = 0, j = 0;
+        while (i < a.keys.size() || j < b.keys.size()) {
+            bool fromA = j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j]);
+            bool fromB = i == a.keys.size() || (j < b.keys.size() && b.keys[j] < a.keys[i]);
+            if (fromA) {
+                if (op != Operation::And) {
+                    add(a.keys[i], a.containers[i]);
+                }
+                ++i;
+            } else if (fromB) {
+                if (op == Operation::Or) {
+                    add(b.keys[j], b.containers[j]);
+                }
+                ++j;
+            } else {
+                add(a.keys[i], roaring::combine<op>(a.containers[i], b.containers[j]));
+                ++i;
+                ++j;
+            }
+        }
+        return result;
+    }
+
+public:
+    using value_type = std::uint32_t;
+    using size_type = std::uint64_t;
+
+    class const_iterator {
+    private:
+        friend class RoaringBitmap;
+        const RoaringBitmap* bitmap = nullptr;
+        std::size_t chunk = 0;
+        std::uint32_t index = 0;  // Array or run index within the chunk
+        std::uint32_t low = 0;    // Current low 16 bits (bitmap and run chunks)
+
+        const_iterator(const RoaringBitmap* owner, std::size_t firstChunk) : bitmap(owner), chunk(firstChunk) {
+            seek();
+        }
+
+        // Moves to the first value at or after the current position
+        void seek() {
+            for (; chunk < bitmap->containers.size(); ++chunk, index = 0, low = 0) {
+                const roaring::Container& c = bitmap->containers[chunk];
+                switch (c.kind) {
+                case roaring::Kind::Array:
+                    if (index < c.array.size()) {
+                        low = c.array[index];
+                        return;
+                    }
+                    break;
+                case roaring::Kind::Bitmap: {
+                    int next = c.nextSetBit(low);
+                    if (next >= 0) {
+                        low = static_cast<std::uint32_t>(next);
+                        return;
+                    }
+                    break;
+                }
+                case roaring::Kind::Run:
+                    for (; index < c.runs.size(); ++index) {
+                        if (low <= c.runs[index].last) {
+                            low = std::max<std::uint32_t>(low, c.runs[index].start);
+                            return;
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::uint32_t;
+        using pointer = void;
+
+        const_iterator() = default;
+
+        std::uint32_t operator*() const { return std::uint32_t(bitmap->keys[chunk]) << 16 | low; }
+
+        const_iterator& operator++() {
+            if (bitmap->containers[chunk].kind == roaring::Kind::Array) {
+                ++index;
+            } else {
+                ++low;
+            }
+            seek();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) {
+            // seek() leaves index and low at 0 when it reaches the end
+            return a.chunk == b.chunk && a.index == b.index && a.low == b.low;
+        }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+    };
+    using iterator = const_iterator;
+
+    RoaringBitmap() = default;
+
+    RoaringBitmap(std::initializer_list<std::uint32_t> values) {
+        for (std::uint32_t value : values) {
+            insert(value);
+        }
+    }
+
+    template <typename InputIt>
+    RoaringBitmap(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(static_cast<std::uint32_t>(*first));
+        }
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, containers.size()); }
+
+    size_type size() const { return valueCount; }
+    bool empty() const { return valueCount == 0; }
+
+    void clear() {
+        keys.clear();
+        containers.clear();
+        valueCount = 0;
+    }
+
+    bool contains(std::uint32_t value) const {
+        std::size_t index = chunkIndex(highBits(value));
+        return hasChunk(index, highBits(value)) && containers[index].contains(lowBits(value));
+    }
+
+    size_type count(std::uint32_t value) const { return contains(value) ? 1 : 0; }
+
+    // Returns whether value was added
+    bool insert(std::uint32_t value) {
+        std::uint16_t key = highBits(value);
+        std::size_t index = chunkIndex(key);
+        if (!hasChunk(index, key)) {
+            keys.insert(keys.begin() + static_cast<std::ptrdiff_t>(index), key);
+            containers.insert(containers.begin() + static_cast<std::ptrdiff_t>(index), roaring::Container());
+        }
+        bool added = containers[index].insert(lowBits(value));
+        valueCount += added;
+        return added;
+    }
+
+    // Returns the number of values removed (0 or 1)
+    size_type erase(std::uint32_t value) {
+        std::uint16_t key = highBits(value);
+        std::size_t index = chunkIndex(key);
+        if (!hasChunk(index, key) || !containers[index].erase(lowBits(value))) {
+            return 0;
+        }
+        --valueCount;
+        if (containers[index].cardinality == 0) {
+            removeChunk(index);
+        }
+        return 1;
+    }
+
+    // Adds every value in [first, last)
+    void addRange(std::uint64_t first, std::uint64_t last) {
+        last = std::min<std::uint64_t>(last, std::uint64_t(1) << 32);
+        while (first < last) {
+            std::uint16_t key = highBits(static_cast<std::uint32_t>(first));
+            std::uint64_t chunkEnd = std::min<std::uint64_t>(last, (std::uint64_t(key) + 1) << 16);
+            std::uint16_t from = lowBits(static_cast<std::uint32_t>(first));
+            std::uint16_t to = static_cast<std::uint16_t>(chunkEnd - 1 - (std::uint64_t(key) << 16));
+            std::size_t index = chunkIndex(key);
+            if (!hasChunk(index, key)) {
+                roaring::Container container;
+                container.kind = roaring::Kind::Run;
+                container.runs.push_back({from, to});
+                container.cardinality = std::uint32_t(to) - from + 1;
+                valueCount += container.cardinality;
+                keys.insert(keys.begin() + static_cast<std::ptrdiff_t>(index), key);
+                containers.insert(containers.begin() + static_cast<std::ptrdiff_t>(index), std::move(container));
+            } else {
+                roaring::Container& container = containers[index];
+                valueCount -= container.cardinality;
+                if (container.kind != roaring::Kind::Bitmap) {
+                    container.toBitmap();
+                }
+                for (std::uint32_t value = from; value <= to; ++value) {
+                    container.bits[value >> 6] |= std::uint64_t(1) << (value & 63);
+                }
+                container.cardinality = 0;
+                for (std::uint64_t word : container.bits) {
+                    container.cardinality += static_cast<std::uint32_t>(std::popcount(word));
+                }
+                valueCount += container.cardinality;
+                container.normalize();
+                container.runOptimize();
+            }
+            first = chunkEnd;
+        }
+    }
+
+    // Values <= value
+    size_type rank(std::uint32_t value) const {
+        std::uint16_t key = highBits(value);
+        size_type result = 0;
+        std::size_t index = 0;
+        for (; index < keys.size() && keys[index] < key; ++index) {
+            result += containers[index].cardinality;
+        }
+        if (hasChunk(index, key)) {
+            result += containers[index].rank(lowBits(value));
+        }
+        return result;
+    }
+
+    // The index-th smallest value (from 0)
+    std::uint32_t select(size_type index) const {
+        if (index >= valueCount) {
+            throw std::out_of_range("RoaringBitmap::select: index out of range");
+        }
+        for (std::size_t chunk = 0;; ++chunk) {
+            if (index < containers[chunk].cardinality) {
+                return std::uint32_t(keys[chunk]) << 16 | containers[chunk].select(static_cast<std::uint32_t>(index));
+            }
+            index -= containers[chunk].cardinality;
+        }
+    }
+
+    // Calls func(value) for every value in order; faster than iterators
+    template <typename Func>
+    void forEach(Func&& func) const {
+        for (std::size_t chunk = 0; chunk < containers.size(); ++chunk) {
+            containers[chunk].forEach(std::uint32_t(keys[chunk]) << 16, func);
+        }
+    }
+
+    // Converts every chunk to runs where runs are smaller
+    void runOptimize() {
+        for (roaring::Container& container : containers) {
+            container.runOptimize();
+        }
+    }
+
+    // Bytes owned by this set, including the chunk index
+    std::size_t memoryBytes() const {
+        std::size_t bytes = sizeof(*this) + keys.capacity() * sizeof(std::uint16_t) +
+                            containers.capacity() * sizeof(roaring::Container);
+        for (const roaring::Container& container : containers) {
+            bytes += container.bytes();
+        }
+        return bytes;
+    }
+
+    // Chunks per container kind: array, bitmap, run
+    std::vector<std::size_t> containerCounts() const {
+        std::vector<std::size_t> counts(3, 0);
+        for (const roaring::Container& container : containers) {
+            ++counts[static_cast<std::size_t>(container.kind)];
+        }
+        return counts;
+    }
+
+    friend RoaringBitmap operator|(const RoaringBitmap& a, const RoaringBitmap& b) {
+        return combine<roaring::Operation::Or>(a, b);
+    }
+    friend RoaringBitmap operator&(const RoaringBitmap& a, const RoaringBitmap& b) {
+        return combine<roaring::Operation::And>(a, b);
+    }
+    friend RoaringBitmap operator-(const RoaringBitmap& a, const RoaringBitmap& b) {
+        return combine<roaring::Operation::AndNot>(a, b);
+    }
+
+    friend bool operator==(const RoaringBitmap& a, const RoaringBitmap& b) {
+        return a.valueCount == b.valueCount && a.keys == b.keys && a.containers == b.containers;
+    }
+};
@@ -0,0 +1,251 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include "set_ops.h"
+#include "bench.h"
+
+/**
+ * Adaptive Set Operations on Sorted Vectors
+ *
+ * This example demonstrates:
+ * - set_ops::intersect/unite/subtract (set_ops.h) running
+ *   demonstrateSetAlgorithms from algorithms.cpp with the same results as
+ *   std::set_intersection/set_union/set_difference
+ * - Identical output to the std:: algorithms on random inputs, with and
+ *   without duplicates, for every strategy
+ * - Size ratios from 1:1 to 1:10000: the linear merge of the std::
+ *   algorithms against galloping (skewed sizes) and AVX2 block compares
+ *   (similar sizes)
+ * - Intersecting several inputs at once, smallest first
+ *
+ * Usage: ./perf_set_ops [largeSize]   (default: 1000000)
+ */
+
+// Microseconds per call, repeating until the measurement takes 20 ms
+template <typename Func>
+double usPerCall(Func&& func) {
+    for (std::size_t calls = 1;; calls *= 2) {
+        double ms = bench::timeMs([&] {
+            for (std::size_t i = 0; i < calls; ++i) {
+                func();
+            }
+        });
+        if (ms >= 20.0) {
+            return ms * 1000.0 / static_cast<double>(calls);
+        }
+    }
+}
+
+std::vector<int> stdIntersection(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> result;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+std::vector<int> stdUnion(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> result;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+std::vector<int> stdDifference(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> result;
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// demonstrateSetAlgorithms from algorithms.cpp
+// ---------------------------------------------------------------------------
+
+void printValues(const char* label, const std::vector<int>& values) {
+    std::cout << "  " << label;
+    for (int n : values) {
+        std::cout << n << " ";
+    }
+    std::cout << std::endl;
+}
+
+void demonstrateSetAlgorithms() {
+    std::cout << "1. demonstrateSetAlgorithms with set_ops:" << std::endl;
+
+    std::vector<int> set1 = {1, 2, 3, 4, 5};
+    std::vector<int> set2 = {3, 4, 5, 6, 7};
+    printValues("Set 1: ", set1);
+    printValues("Set 2: ", set2);
+    printValues("Union: ", set_ops::unite(set1, set2));
+    printValues("Intersection: ", set_ops::intersect(set1, set2));
+    printValues("Difference (set1 - set2): ", set_ops::subtract(set1, set2));
+
+    bool match = set_ops::unite(set1, set2) == stdUnion(set1, set2) &&
+                 set_ops::intersect(set1, set2) == stdIntersection(set1, set2) &&
+                 set_ops::subtract(set1, set2) == stdDifference(set1, set2);
+    std::cout << "  Matches std::set_union/intersection/difference: " << (match ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// Identical output
+// ---------------------------------------------------------------------------
+
+std::vector<int> sortedRandom(std::size_t count, int range, bool duplicates, std::mt19937& rng) {
+    std::uniform_int_distribution<int> value(0, range - 1);
+    std::vector<int> values(count);
+    for (int& v : values) {
+        v = value(rng);
+    }
+    std::sort(values.begin(), values.end());
+    if (!duplicates) {
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+    return values;
+}
+
+void demonstrateIdenticalOutput() {
+    std::cout << "2. Random inputs against the std:: algorithms:" << std::endl;
+    std::mt19937 rng(25);
+    const set_ops::Strategy strategies[] = {set_ops::Strategy::Auto, set_ops::Strategy::Merge,
+                                            set_ops::Strategy::Gallop, set_ops::Strategy::Simd};
+    std::size_t cases = 0, mismatches = 0;
+    for (int round = 0; round < 2000; ++round) {
+        bool duplicates = round % 2 == 1;
+        int range = 1 + static_cast<int>(rng() % 5000);
+        std::vector<int> a = sortedRandom(rng() % 3000, range, duplicates, rng);
+        std::vector<int> b;
+        if (round % 4 == 0) {
+            b = sortedRandom(rng() % 30, range, duplicates, rng);
+        } else if (round % 4 == 1) {
+            // Skewed by 32-127x with duplicates: gallops where Simd cannot run
+            b = sortedRandom(a.size() / (32 + rng() % 96), range, duplicates, rng);
+        } else {
+            b = sortedRandom(rng() % 3000, range, duplicates, rng);
+        }
+        if (round % 3 == 0) {
+            std::swap(a, b);
+        }
+        std::vector<int> intersection = stdIntersection(a, b);
+        std::vector<int> united = stdUnion(a, b);
+        std::vector<int> difference = stdDifference(a, b);
+        for (set_ops::Strategy strategy : strategies) {
+            ++cases;
+            if (set_ops::intersect(a, b, strategy) != intersection || set_ops::unite(a, b, strategy) != united ||
+                set_ops::subtract(a, b, strategy) != difference) {
+                ++mismatches;
+            }
+        }
+        std::vector<int> c = sortedRandom(rng() % 300, range, duplicates, rng);
+        ++cases;
+        if (set_ops::intersectAll({a, b, c}) != stdIntersection(intersection, c)) {
+            ++mismatches;
+        }
+    }
+    std::cout << "  " << cases << " cases (half with duplicates), " << mismatches << " mismatches" << std::endl;
+    std::cout << "  Output identical to std::set_*: " << (mismatches == 0 ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+void benchmarkRatios(std::size_t largeSize) {
+    std::mt19937 rng(7);
+    int range = static_cast<int>(std::min<std::size_t>(largeSize * 2, 1u << 30));
+    std::vector<int> large = sortedRandom(largeSize, range, false, rng);
+    std::cout << "3. " << large.size() << " values against smaller inputs (us per call):" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  " << std::left << std::setw(9) << "Ratio" << std::setw(22) << "Operation" << std::right
+              << std::setw(12) << "std::" << std::setw(12) << "set_ops" << std::setw(10) << "Speedup"
+              << "  Strategy" << std::endl;
+    bool allMatch = true;
+    std::size_t sink = 0;
+    for (std::size_t ratio : {1, 10, 100, 1000, 10000}) {
+        std::vector<int> small = sortedRandom(std::max<std::size_t>(largeSize / ratio, 1), range, false, rng);
+
+        struct Row {
+            const char* name;
+            std::vector<int> (*reference)(const std::vector<int>&, const std::vector<int>&);
+            std::vector<int> (*adaptive)(std::span<const int>, std::span<const int>, set_ops::Strategy);
+            const std::vector<int>* a;
+            const std::vector<int>* b;
+            bool simd;  // Whether the operation has a SIMD kernel
+        };
+        const Row rows[] = {
+            {"intersect", stdIntersection, set_ops::intersect, &small, &large, true},
+            {"unite", stdUnion, set_ops::unite, &small, &large, false},
+            {"subtract small-large", stdDifference, set_ops::subtract, &small, &large, true},
+            {"subtract large-small", stdDifference, set_ops::subtract, &large, &small, true},
+        };
+        for (const Row& row : rows) {
+            const std::vector<int>& a = *row.a;
+            const std::vector<int>& b = *row.b;
+            allMatch = allMatch && row.reference(a, b) == row.adaptive(a, b, set_ops::Strategy::Auto);
+            double referenceUs = usPerCall([&] { sink += row.reference(a, b).size(); });
+            double adaptiveUs = usPerCall([&] { sink += row.adaptive(a, b, set_ops::Strategy::Auto).size(); });
+            set_ops::Strategy used = set_ops::resolve(set_ops::Strategy::Auto, a, b, row.simd);
+            std::cout << "  " << std::left << std::setw(9) << ("1:" + std::to_string(ratio)) << std::setw(22)
+                      << row.name << std::right << std::setw(12) << referenceUs << std::setw(12) << adaptiveUs
+                      << std::setw(9) << referenceUs / adaptiveUs << "x  " << set_ops::strategyName(used)
+                      << std::endl;
+        }
+    }
+    std::cout << "  Results match: " << (allMatch && sink != 0 ? "Yes" : "No") << std::endl;
+    std::cout << std::endl;
+}
+
+void benchmarkMultiway(std::size_t largeSize) {
+    std::cout << "4. Intersecting four inputs:" << std::endl;
+    std::mt19937 rng(11);
+    int range = static_cast<int>(std::min<std::size_t>(largeSize * 2, 1u << 30));
+    std::vector<std::vector<int>> inputs = {
+        sortedRandom(largeSize, range, false, rng), sortedRandom(largeSize, range, false, rng),
+        sortedRandom(largeSize / 2, range, false, rng), sortedRandom(std::max<std::size_t>(largeSize / 1000, 1), range, false, rng)};
+    std::cout << "  Sizes:";
+    for (const auto& input : inputs) {
+        std::cout << " " << input.size();
+    }
+    std::cout << std::endl;
+
+    // Folding std::set_intersection in the given order
+    auto folded = [&] {
+        std::vector<int> result = inputs[0];
+        for (std::size_t k = 1; k < inputs.size(); ++k) {
+            result = stdIntersection(result, inputs[k]);
+        }
+        return result;
+    };
+    auto adaptive = [&] { return set_ops::intersectAll({inputs[0], inputs[1], inputs[2], inputs[3]}); };
+
+    std::size_t sink = 0;
+    double foldedUs = usPerCall([&] { sink += folded().size(); });
+    double adaptiveUs = usPerCall([&] { sink += adaptive().size(); });
+    std::cout << "  std::set_intersection, in order: " << foldedUs << " us" << std::endl;
+    std::cout << "  set_ops::intersectAll:           " << adaptiveUs << " us (" << foldedUs / adaptiveUs << "x)"
+              << std::endl;
+    std::cout << "  " << adaptive().size() << " common values" << std::endl;
+    std::cout << "  Results match: " << (folded() == adaptive() && sink != 0 ? "Yes" : "No") << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Adaptive Set Operations ===" << std::endl;
+    std::cout << std::endl;
+
+    std::size_t largeSize = argc > 1 ? std::max<std::size_t>(std::strtoull(argv[1], nullptr, 10), 1) : 1000000;
+
+    demonstrateSetAlgorithms();
+    demonstrateIdenticalOutput();
+    benchmarkRatios(largeSize);
+    benchmarkMultiway(largeSize);
+
+    std::cout << "=== End of Set Operations Example ===" << std::endl;
+
+    return 0;
+}
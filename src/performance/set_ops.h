@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Adaptive set operations on sorted int ranges
+ *
+ * intersect(), unite() and subtract() return exactly what
+ * std::set_intersection, std::set_union and std::set_difference produce
+ * for the same sorted inputs (duplicates included). Each call picks its
+ * algorithm from the input sizes:
+ *
+ * - Gallop: one input is much larger (gallopRatio times, or
+ *   simdGallopRatio where a SIMD kernel competes). Every value
+ *   of the small input finds its place in the large one by exponential
+ *   search from the previous position, O(small * log(large / small)).
+ *   Union and difference copy the skipped stretches of the large input
+ *   in bulk.
+ * - Simd: similar sizes and no duplicates. Blocks of eight values from
+ *   each input are compared all-against-all with eight AVX2 compares,
+ *   and the matching values are packed to the output with one shuffle.
+ *   Used for intersection and difference; union is a plain merge.
+ * - Merge: the std:: algorithm, for everything else (short inputs,
+ *   similar sizes with duplicates or without AVX2).
+ *
+ * intersectAll() intersects any number of inputs, smallest first, so each
+ * further input meets an ever smaller result and usually gallops.
+ */
+
+namespace set_ops {
+
+enum class Strategy { Auto, Merge, Gallop, Simd };
+
+// Size ratios from which galloping beats a merge and the SIMD kernels
+constexpr std::size_t gallopRatio = 32;
+constexpr std::size_t simdGallopRatio = 128;
+constexpr std::size_t simdMinimum = 64;  // Shorter inputs just merge
+
+inline const char* strategyName(Strategy strategy) {
+    switch (strategy) {
+    case Strategy::Auto:
+        return "auto";
+    case Strategy::Merge:
+        return "merge";
+    case Strategy::Gallop:
+        return "gallop";
+    case Strategy::Simd:
+        return "simd";
+    }
+    return "?";
+}
+
+inline bool strictlyIncreasing(std::span<const int> values) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 9 <= values.size(); i += 8) {
+        __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values.data() + i));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values.data() + i + 1));
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(next, current)) != -1) {
+            return false;
+        }
+    }
+#endif
+    for (; i + 1 < values.size(); ++i) {
+        if (values[i] >= values[i + 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The algorithm Auto runs for inputs of these sizes, for an operation
+// with (simd) or without a SIMD kernel. Simd also needs inputs without
+// duplicates, which the operations check themselves.
+inline Strategy choose(std::size_t sizeA, std::size_t sizeB, bool simd = true) {
+    std::size_t small = std::min(sizeA, sizeB);
+    std::size_t large = std::max(sizeA, sizeB);
+#if defined(__AVX2__)
+    if (simd && small >= simdMinimum && large / small < simdGallopRatio) {
+        return Strategy::Simd;
+    }
+#else
+    (void)simd;
+#endif
+    if (small == 0 || large / small >= gallopRatio) {
+        return Strategy::Gallop;
+    }
+    return Strategy::Merge;
+}
+
+// First position in [first, last) whose value is >= value, found by
+// steps of 1, 2, 4, ... from first and a binary search in the last step
+inline const int* gallop(const int* first, const int* last, int value) {
+    if (first == last || *first >= value) {
+        return first;
+    }
+    const int* below = first;  // *below < value
+    std::size_t step = 1;
+    while (step < static_cast<std::size_t>(last - below) && below[step] < value) {
+        below += step;
+        step *= 2;
+    }
+    const int* bound = step < static_cast<std::size_t>(last - below) ? below + step + 1 : last;
+    return std::lower_bound(below + 1, bound, value);
+}
+
+// Length of the run of `value` at first (at most limit)
+inline std::size_t runLength(const int* first, const int* last, int value, std::size_t limit) {
+    std::size_t length = 0;
+    while (length < limit && first + length != last && first[length] == value) {
+        ++length;
+    }
+    return length;
+}
+
+// ---------------------------------------------------------------------------
+// Galloping kernels (duplicates allowed)
+// ---------------------------------------------------------------------------
+
+// For each value v: min(count in small, count in large) copies
+inline int* gallopIntersect(std::span<const int> small, std::span<const int> large, int* out) {
+    const int* position = large.data();
+    const int* end = large.data() + large.size();
+    for (std::size_t i = 0; i < small.size();) {
+        int value = small[i];
+        std::size_t count = runLength(small.data() + i, small.data() + small.size(), value, small.size());
+        position = gallop(position, end, value);
+        std::size_t matches = runLength(position, end, value, count);
+        out = std::fill_n(out, matches, value);
+        position += matches;
+        i += count;
+    }
+    return out;
+}
+
+// For each value v: max(count in small, count in large) copies
+inline int* gallopUnite(std::span<const int> small, std::span<const int> large, int* out) {
+    const int* position = large.data();
+    const int* end = large.data() + large.size();
+    for (std::size_t i = 0; i < small.size();) {
+        int value = small[i];
+        std::size_t count = runLength(small.data() + i, small.data() + small.size(), value, small.size());
+        const int* next = gallop(position, end, value);
+        out = std::copy(position, next, out);
+        std::size_t matches = runLength(next, end, value, static_cast<std::size_t>(end - next));
+        out = std::fill_n(out, std::max(count, matches), value);
+        position = next + matches;
+        i += count;
+    }
+    return std::copy(position, end, out);
+}
+
+// a - b for a much smaller a: for each value, max(count in a - count in b, 0) copies
+inline int* gallopSubtractFromSmall(std::span<const int> a, std::span<const int> b, int* out) {
+    const int* position = b.data();
+    const int* end = b.data() + b.size();
+    for (std::size_t i = 0; i < a.size();) {
+        int value = a[i];
+        std::size_t count = runLength(a.data() + i, a.data() + a.size(), value, a.size());
+        position = gallop(position, end, value);
+        std::size_t matches = runLength(position, end, value, count);
+        out = std::fill_n(out, count - matches, value);
+        position += matches;
+        i += count;
+    }
+    return out;
+}
+
+// a - b for a much smaller b: copies a in bulk between the values of b
+inline int* gallopSubtractSmall(std::span<const int> a, std::span<const int> b, int* out) {
+    const int* position = a.data();
+    const int* end = a.data() + a.size();
+    for (std::size_t i = 0; i < b.size();) {
+        int value = b[i];
+        std::size_t count = runLength(b.data() + i, b.data() + b.size(), value, b.size());
+        const int* next = gallop(position, end, value);
+        out = std::copy(position, next, out);
+        position = next + runLength(next, end, value, count);
+        i += count;
+    }
+    return std::copy(position, end, out);
+}
+
+// ---------------------------------------------------------------------------
+// SIMD kernels (no duplicates; the output needs room for 8 extra values)
+// ---------------------------------------------------------------------------
+
+#if defined(__AVX2__)
+
+// Permutations that move the lanes selected by a mask to the front
+inline const std::array<std::array<std::int32_t, 8>, 256>& leftPackTable() {
+    static const std::array<std::array<std::int32_t, 8>, 256> table = [] {
+        std::array<std::array<std::int32_t, 8>, 256> result{};
+        for (std::uint32_t mask = 0; mask < 256; ++mask) {
+            std::size_t next = 0;
+            for (std::int32_t lane = 0; lane < 8; ++lane) {
+                if (mask & (1u << lane)) {
+                    result[mask][next++] = lane;
+                }
+            }
+        }
+        return result;
+    }();
+    return table;
+}
+
+// Bit k is set if lane k of a equals any lane of b
+inline std::uint32_t matchMask(__m256i a, __m256i b) {
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    __m256i equal = _mm256_cmpeq_epi32(a, b);
+    for (int r = 1; r < 8; ++r) {
+        b = _mm256_permutevar8x32_epi32(b, rotate);
+        equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(a, b));
+    }
+    return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+}
+
+// Writes the lanes of values selected by mask, in order; may write all 8
+inline int* leftPack(__m256i values, std::uint32_t mask, int* out) {
+    __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(leftPackTable()[mask].data()));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(values, order));
+    return out + std::popcount(mask);
+}
+
+inline int* simdIntersect(std::span<const int> a, std::span<const int> b, int* out) {
+    std::size_t i = 0, j = 0;
+    while (i + 8 <= a.size() && j + 8 <= b.size()) {
+        __m256i blockA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data() + i));
+        __m256i blockB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data() + j));
+        out = leftPack(blockA, matchMask(blockA, blockB), out);
+        int lastA = a[i + 7], lastB = b[j + 7];
+        i += lastA <= lastB ? 8 : 0;
+        j += lastB <= lastA ? 8 : 0;
+    }
+    // Values of a already written matched b before j, so they cannot match again
+    return std::set_intersection(a.begin() + static_cast<std::ptrdiff_t>(i), a.end(),
+                                 b.begin() + static_cast<std::ptrdiff_t>(j), b.end(), out);
+}
+
+inline int* simdSubtract(std::span<const int> a, std::span<const int> b, int* out) {
+    std::size_t i = 0, j = 0;
+    std::uint32_t matched = 0;  // Lanes of the current block of a found in b so far
+    while (i + 8 <= a.size() && j + 8 <= b.size()) {
+        __m256i blockA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data() + i));
+        __m256i blockB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data() + j));
+        matched |= matchMask(blockA, blockB);
+        int lastA = a[i + 7], lastB = b[j + 7];
+        if (lastA <= lastB) {
+            out = leftPack(blockA, ~matched & 0xFF, out);
+            matched = 0;
+            i += 8;
+        }
+        j += lastB <= lastA ? 8 : 0;
+    }
+    if (matched != 0) {
+        // A block of a that met only part of b: finish it against the rest
+        for (std::size_t k = 0; k < 8; ++k) {
+            if (!(matched & (1u << k)) &&
+                !std::binary_search(b.begin() + static_cast<std::ptrdiff_t>(j), b.end(), a[i + k])) {
+                *out++ = a[i + k];
+            }
+        }
+        i += 8;
+    }
+    return std::set_difference(a.begin() + static_cast<std::ptrdiff_t>(i), a.end(),
+                               b.begin() + static_cast<std::ptrdiff_t>(j), b.end(), out);
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+// Operations
+// ---------------------------------------------------------------------------
+
+// The strategy to run: Auto resolved, Simd only for duplicate-free input.
+// Where Simd cannot run, the choice is made again without it, so skewed
+// inputs with duplicates still gallop rather than merge.
+inline Strategy resolve(Strategy strategy, std::span<const int> a, std::span<const int> b, bool simd = true) {
+    if (strategy == Strategy::Auto) {
+        strategy = choose(a.size(), b.size(), simd);
+    }
+#if defined(__AVX2__)
+    if (strategy == Strategy::Simd && !(simd && strictlyIncreasing(a) && strictlyIncreasing(b))) {
+        strategy = choose(a.size(), b.size(), false);
+    }
+#else
+    if (strategy == Strategy::Simd) {
+        strategy = choose(a.size(), b.size(), false);
+    }
+#endif
+    return strategy;
+}
+
+inline std::vector<int> intersect(std::span<const int> a, std::span<const int> b, Strategy strategy = Strategy::Auto) {
+    std::vector<int> result(std::min(a.size(), b.size()) + 8);
+    int* out = result.data();
+    switch (resolve(strategy, a, b)) {
+    case Strategy::Gallop:
+        out = a.size() <= b.size() ? gallopIntersect(a, b, out) : gallopIntersect(b, a, out);
+        break;
+#if defined(__AVX2__)
+    case Strategy::Simd:
+        out = simdIntersect(a, b, out);
+        break;
+#endif
+    default:
+        out = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out);
+        break;
+    }
+    result.resize(static_cast<std::size_t>(out - result.data()));
+    return result;
+}
+
+inline std::vector<int> unite(std::span<const int> a, std::span<const int> b, Strategy strategy = Strategy::Auto) {
+    std::vector<int> result(a.size() + b.size());
+    int* out = result.data();
+    if (resolve(strategy, a, b, false) == Strategy::Gallop) {
+        out = a.size() <= b.size() ? gallopUnite(a, b, out) : gallopUnite(b, a, out);
+    } else {
+        out = std::set_union(a.begin(), a.end(), b.begin(), b.end(), out);
+    }
+    result.resize(static_cast<std::size_t>(out - result.data()));
+    return result;
+}
+
+inline std::vector<int> subtract(std::span<const int> a, std::span<const int> b, Strategy strategy = Strategy::Auto) {
+    std::vector<int> result(a.size() + 8);
+    int* out = result.data();
+    switch (resolve(strategy, a, b)) {
+    case Strategy::Gallop:
+        out = a.size() <= b.size() ? gallopSubtractFromSmall(a, b, out) : gallopSubtractSmall(a, b, out);
+        break;
+#if defined(__AVX2__)
+    case Strategy::Simd:
+        out = simdSubtract(a, b, out);
+        break;
+#endif
+    default:
+        out = std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out);
+        break;
+    }
+    result.resize(static_cast<std::size_t>(out - result.data()));
+    return result;
+}
+
+// The intersection of all inputs, the same as applying
+// std::set_intersection to them one after another
+inline std::vector<int> intersectAll(std::vector<std::span<const int>> inputs) {
+    if (inputs.empty()) {
+        return {};
+    }
+    std::sort(inputs.begin(), inputs.end(), [](std::span<const int> x, std::span<const int> y) { return x.size() < y.size(); });
+    std::vector<int> result(inputs[0].begin(), inputs[0].end());
+    for (std::size_t k = 1; k < inputs.size() && !result.empty(); ++k) {
+        result = intersect(result, inputs[k]);
+    }
+    return result;
+}
+
+}  // namespace set_ops
@@ -0,0 +1,366 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <thread>
+#include "bench.h"
+
+/**
+ * Parallel Aggregation over Shape Collections
+ *
+ * This example demonstrates:
+ * - Splitting a reduction (total area, total perimeter, bounding box)
+ *   across a configurable number of std::threads
+ * - Why floating-point sums depend on the order of additions
+ * - Compensated (Neumaier) summation and pairwise combining
+ * - A deterministic mode: fixed chunk boundaries + fixed combine order,
+ *   so the result is bit-identical for any thread count
+ * - A scaling benchmark at 1/2/4/8/16 threads
+ *
+ * Box convention: a Circle is centered on (x, y); Rectangle and Triangle
+ * have their lower-left corner at (x, y).
+ *
+ * Usage: ./perf_shape_aggregates [shapeCount]   (default: 10000000)
+ */
+
+struct Box {
+    double minX, minY, maxX, maxY;
+
+    static Box empty() {
+        double inf = std::numeric_limits<double>::infinity();
+        return {inf, inf, -inf, -inf};
+    }
+
+    void expand(const Box& other) {
+        minX = std::min(minX, other.minX);
+        minY = std::min(minY, other.minY);
+        maxX = std::max(maxX, other.maxX);
+        maxY = std::max(maxY, other.maxY);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Shape hierarchy (same formulas as src/oop/polymorphism.cpp)
+// ---------------------------------------------------------------------------
+
+class Shape {
+protected:
+    std::string name;
+    double x, y;  // Position coordinates
+
+public:
+    Shape(const std::string& shapeName, double posX = 0, double posY = 0)
+        : name(shapeName), x(posX), y(posY) {}
+
+    virtual ~Shape() = default;
+
+    virtual double getArea() const = 0;
+    virtual double getPerimeter() const = 0;
+    virtual Box getBounds() const = 0;
+};
+
+class Circle : public Shape {
+private:
+    double radius;
+
+public:
+    Circle(const std::string& circleName, double r, double posX = 0, double posY = 0)
+        : Shape(circleName, posX, posY), radius(r) {}
+
+    double getArea() const override { return 3.14159 * radius * radius; }
+    double getPerimeter() const override { return 2 * 3.14159 * radius; }
+    Box getBounds() const override { return {x - radius, y - radius, x + radius, y + radius}; }
+};
+
+class Rectangle : public Shape {
+private:
+    double width, height;
+
+public:
+    Rectangle(const std::string& rectName, double w, double h, double posX = 0, double posY = 0)
+        : Shape(rectName, posX, posY), width(w), height(h) {}
+
+    double getArea() const override { return width * height; }
+    double getPerimeter() const override { return 2 * (width + height); }
+    Box getBounds() const override { return {x, y, x + width, y + height}; }
+};
+
+class Triangle : public Shape {
+private:
+    double base, height;
+
+public:
+    Triangle(const std::string& triName, double b, double h, double posX = 0, double posY = 0)
+        : Shape(triName, posX, posY), base(b), height(h) {}
+
+    double getArea() const override { return 0.5 * base * height; }
+    double getPerimeter() const override {
+        // Simplified calculation (assuming right triangle)
+        return base + height + std::sqrt(base * base + height * height);
+    }
+    Box getBounds() const override { return {x, y, x + base, y + height}; }
+};
+
+// ---------------------------------------------------------------------------
+// Aggregate engine
+// ---------------------------------------------------------------------------
+
+// Neumaier's variant of Kahan summation: tracks the rounding error of
+// every addition, so the error no longer grows with the number of terms
+class CompensatedSum {
+private:
+    double sum = 0.0;
+    double compensation = 0.0;
+
+public:
+    void add(double value) {
+        double t = sum + value;
+        if (std::fabs(sum) >= std::fabs(value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    }
+
+    double result() const { return sum + compensation; }
+};
+
+struct ShapeAggregates {
+    double totalArea = 0.0;
+    double totalPerimeter = 0.0;
+    Box bounds = Box::empty();
+    std::size_t count = 0;
+};
+
+struct AggregateOptions {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool deterministic = false;
+    std::size_t chunkSize = 1 << 16;  // Deterministic mode only: fixed work unit
+};
+
+// Runs work(threadIndex) on `threads` threads (the caller's thread is one of them)
+template <typename Work>
+void runOnThreads(unsigned threads, Work&& work) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        workers.emplace_back(work, t);
+    }
+    work(0u);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Sums values[first, last) by recursive halving. The tree shape depends only
+// on the number of values, never on which thread produced them.
+double pairwiseSum(const std::vector<double>& values, std::size_t first, std::size_t last) {
+    if (last - first == 0) {
+        return 0.0;
+    }
+    if (last - first == 1) {
+        return values[first];
+    }
+    std::size_t middle = first + (last - first) / 2;
+    return pairwiseSum(values, first, middle) + pairwiseSum(values, middle, last);
+}
+
+// Fast mode: one contiguous range per thread, plain summation
+ShapeAggregates aggregateFast(const std::vector<Shape*>& shapes, unsigned threads) {
+    std::vector<ShapeAggregates> partials(threads);
+    std::size_t perThread = (shapes.size() + threads - 1) / threads;
+
+    runOnThreads(threads, [&](unsigned t) {
+        std::size_t first = std::min(shapes.size(), t * perThread);
+        std::size_t last = std::min(shapes.size(), first + perThread);
+        ShapeAggregates local;
+        for (std::size_t i = first; i < last; ++i) {
+            local.totalArea += shapes[i]->getArea();
+            local.totalPerimeter += shapes[i]->getPerimeter();
+            local.bounds.expand(shapes[i]->getBounds());
+        }
+        local.count = last - first;
+        partials[t] = local;
+    });
+
+    ShapeAggregates result;
+    for (const ShapeAggregates& partial : partials) {
+        result.totalArea += partial.totalArea;
+        result.totalPerimeter += partial.totalPerimeter;
+        result.bounds.expand(partial.bounds);
+        result.count += partial.count;
+    }
+    return result;
+}
+
+// Deterministic mode: fixed-size chunks handed out dynamically, compensated
+// sums inside each chunk, pairwise combination of the chunks in index order
+ShapeAggregates aggregateDeterministic(const std::vector<Shape*>& shapes, unsigned threads,
+                                       std::size_t chunkSize) {
+    std::size_t chunkCount = (shapes.size() + chunkSize - 1) / chunkSize;
+    std::vector<double> chunkAreas(chunkCount), chunkPerimeters(chunkCount);
+    std::vector<Box> chunkBounds(chunkCount, Box::empty());
+    std::atomic<std::size_t> nextChunk{0};
+
+    runOnThreads(threads, [&](unsigned) {
+        for (std::size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+            std::size_t first = chunk * chunkSize;
+            std::size_t last = std::min(shapes.size(), first + chunkSize);
+            CompensatedSum area, perimeter;
+            Box bounds = Box::empty();
+            for (std::size_t i = first; i < last; ++i) {
+                area.add(shapes[i]->getArea());
+                perimeter.add(shapes[i]->getPerimeter());
+                bounds.expand(shapes[i]->getBounds());
+            }
+            chunkAreas[chunk] = area.result();
+            chunkPerimeters[chunk] = perimeter.result();
+            chunkBounds[chunk] = bounds;
+        }
+    });
+
+    ShapeAggregates result;
+    result.totalArea = pairwiseSum(chunkAreas, 0, chunkCount);
+    result.totalPerimeter = pairwiseSum(chunkPerimeters, 0, chunkCount);
+    for (const Box& bounds : chunkBounds) {
+        result.bounds.expand(bounds);  // min/max are exact in any order
+    }
+    result.count = shapes.size();
+    return result;
+}
+
+ShapeAggregates aggregate(const std::vector<Shape*>& shapes, const AggregateOptions& options = {}) {
+    unsigned threads = std::max(1u, options.threads);
+    if (options.deterministic) {
+        return aggregateDeterministic(shapes, threads, std::max<std::size_t>(1, options.chunkSize));
+    }
+    return aggregateFast(shapes, threads);
+}
+
+// Same as polymorphism.cpp: serial, naive summation
+double calculateTotalArea(const std::vector<Shape*>& shapes) {
+    double totalArea = 0.0;
+    for (const Shape* shape : shapes) {
+        totalArea += shape->getArea();
+    }
+    return totalArea;
+}
+
+// High-precision reference for measuring error
+long double exactTotalArea(const std::vector<Shape*>& shapes) {
+    long double total = 0.0L;
+    for (const Shape* shape : shapes) {
+        total += shape->getArea();
+    }
+    return total;
+}
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+std::vector<std::unique_ptr<Shape>> randomShapes(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> kindDist(0, 2);
+    // Wide range of sizes makes rounding errors visible
+    std::uniform_real_distribution<double> exponentDist(-3.0, 3.0);
+    std::uniform_real_distribution<double> posDist(-1000.0, 1000.0);
+    std::vector<std::unique_ptr<Shape>> shapes;
+    shapes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        double a = std::pow(10.0, exponentDist(rng));
+        double b = std::pow(10.0, exponentDist(rng));
+        double px = posDist(rng), py = posDist(rng);
+        switch (kindDist(rng)) {
+            case 0:  shapes.push_back(std::make_unique<Circle>("c", a, px, py)); break;
+            case 1:  shapes.push_back(std::make_unique<Rectangle>("r", a, b, px, py)); break;
+            default: shapes.push_back(std::make_unique<Triangle>("t", a, b, px, py)); break;
+        }
+    }
+    return shapes;
+}
+
+void demonstrateAggregates() {
+    std::cout << "1. Aggregating a small collection:" << std::endl;
+    Circle circle("MyCircle", 5.0, 0, 0);
+    Rectangle rectangle("MyRectangle", 4.0, 6.0, 10, 10);
+    Triangle triangle("MyTriangle", 3.0, 4.0, 20, 20);
+    std::vector<Shape*> shapes = {&circle, &rectangle, &triangle};
+
+    ShapeAggregates result = aggregate(shapes, {2, true});
+    std::cout << "  Total area: " << result.totalArea << std::endl;
+    std::cout << "  Total perimeter: " << result.totalPerimeter << std::endl;
+    std::cout << "  Bounding box: (" << result.bounds.minX << ", " << result.bounds.minY << ") - ("
+              << result.bounds.maxX << ", " << result.bounds.maxY << ")" << std::endl;
+    std::cout << "  Serial calculateTotalArea: " << calculateTotalArea(shapes) << std::endl;
+    std::cout << std::endl;
+}
+
+void benchmarkAggregates(std::size_t count) {
+    auto owned = randomShapes(count, 3);
+    std::vector<Shape*> shapes;
+    shapes.reserve(owned.size());
+    for (auto& shape : owned) {
+        shapes.push_back(shape.get());
+    }
+
+    long double exact = exactTotalArea(shapes);
+    double serial = calculateTotalArea(shapes);
+
+    std::cout << "2. Accuracy of total area over " << count << " shapes:" << std::endl;
+    std::cout << std::setprecision(17);
+    std::cout << "  Reference (long double): " << static_cast<double>(exact) << std::endl;
+    std::cout << "  Serial naive sum:        " << serial << std::endl;
+
+    const unsigned threadCounts[] = {1, 2, 4, 8, 16};
+    std::vector<double> fastAreas, deterministicAreas;
+    std::vector<double> fastTimes, deterministicTimes;
+    for (unsigned threads : threadCounts) {
+        ShapeAggregates fast, deterministic;
+        fastTimes.push_back(bench::bestTimeMs(3, [&] { fast = aggregate(shapes, {threads, false}); }));
+        deterministicTimes.push_back(bench::bestTimeMs(3, [&] { deterministic = aggregate(shapes, {threads, true}); }));
+        fastAreas.push_back(fast.totalArea);
+        deterministicAreas.push_back(deterministic.totalArea);
+    }
+    for (std::size_t i = 0; i < fastAreas.size(); ++i) {
+        std::cout << "  " << std::setw(2) << threadCounts[i] << " threads: fast " << fastAreas[i]
+                  << ", deterministic " << deterministicAreas[i] << std::endl;
+    }
+    bool identical = std::all_of(deterministicAreas.begin(), deterministicAreas.end(),
+                                 [&](double area) { return area == deterministicAreas[0]; });
+    std::cout << "  Deterministic results bit-identical: " << (identical ? "Yes" : "No") << std::endl;
+    std::cout << std::setprecision(6);
+    std::cout << std::endl;
+
+    std::cout << "3. Scaling (best of 3, " << std::thread::hardware_concurrency()
+              << " hardware threads available):" << std::endl;
+    for (std::size_t i = 0; i < fastTimes.size(); ++i) {
+        std::cout << "  " << std::setw(2) << threadCounts[i] << " threads: fast " << fastTimes[i]
+                  << " ms (x" << fastTimes[0] / fastTimes[i] << "), deterministic " << deterministicTimes[i]
+                  << " ms (x" << deterministicTimes[0] / deterministicTimes[i] << ")" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Parallel Shape Aggregates ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateAggregates();
+
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    benchmarkAggregates(count);
+
+    std::cout << "=== End of Shape Aggregates Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,502 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include "bench.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Structure-of-Arrays Shape Storage in C++
+ *
+ * This example demonstrates:
+ * - Why a vector of base-class pointers is slow for bulk math
+ *   (one heap object, one pointer chase and one virtual call per shape)
+ * - Structure-of-arrays (SoA) layout: one contiguous array per field
+ * - SIMD kernels (AVX2 / SSE2) with a portable scalar fallback
+ * - Checking the fast path against the virtual Shape hierarchy
+ * - A simple benchmark comparing both layouts
+ *
+ * Usage: ./perf_shape_store [shapeCount...]   (default: 1000000 10000000)
+ */
+
+constexpr double PI = 3.14159;  // Same constant as polymorphism.cpp
+
+// ---------------------------------------------------------------------------
+// Reference hierarchy (same formulas as src/oop/polymorphism.cpp, without
+// the constructor/destructor logging so millions of objects can be built)
+// ---------------------------------------------------------------------------
+
+class Shape {
+protected:
+    std::string name;
+    double x, y;  // Position coordinates
+
+public:
+    Shape(const std::string& shapeName, double posX = 0, double posY = 0)
+        : name(shapeName), x(posX), y(posY) {}
+
+    virtual ~Shape() = default;
+
+    virtual double getArea() const = 0;
+    virtual double getPerimeter() const = 0;
+
+    std::string getName() const { return name; }
+    double getX() const { return x; }
+    double getY() const { return y; }
+};
+
+class Circle : public Shape {
+private:
+    double radius;
+
+public:
+    Circle(const std::string& circleName, double r, double posX = 0, double posY = 0)
+        : Shape(circleName, posX, posY), radius(r) {}
+
+    double getArea() const override { return PI * radius * radius; }
+    double getPerimeter() const override { return 2 * PI * radius; }
+};
+
+class Rectangle : public Shape {
+private:
+    double width, height;
+
+public:
+    Rectangle(const std::string& rectName, double w, double h, double posX = 0, double posY = 0)
+        : Shape(rectName, posX, posY), width(w), height(h) {}
+
+    double getArea() const override { return width * height; }
+    double getPerimeter() const override { return 2 * (width + height); }
+};
+
+class Triangle : public Shape {
+private:
+    double base, height;
+
+public:
+    Triangle(const std::string& triName, double b, double h, double posX = 0, double posY = 0)
+        : Shape(triName, posX, posY), base(b), height(h) {}
+
+    double getArea() const override { return 0.5 * base * height; }
+    double getPerimeter() const override {
+        // Simplified calculation (assuming right triangle)
+        return base + height + std::sqrt(base * base + height * height);
+    }
+};
+
+// Same function as in polymorphism.cpp: one virtual call per element
+double calculateTotalArea(const std::vector<Shape*>& shapes) {
+    double totalArea = 0.0;
+    for (const Shape* shape : shapes) {
+        totalArea += shape->getArea();
+    }
+    return totalArea;
+}
+
+double calculateTotalPerimeter(const std::vector<Shape*>& shapes) {
+    double totalPerimeter = 0.0;
+    for (const Shape* shape : shapes) {
+        totalPerimeter += shape->getPerimeter();
+    }
+    return totalPerimeter;
+}
+
+// ---------------------------------------------------------------------------
+// SIMD kernels
+//
+// Every kernel has three implementations selected at compile time:
+// AVX2 (4 doubles per instruction), SSE2 (2 doubles) and plain scalar code.
+// Build with -march=native (the CMake default) to get the wide versions.
+// ---------------------------------------------------------------------------
+
+namespace kernels {
+
+#if defined(__AVX2__)
+const char* instructionSet() { return "AVX2"; }
+
+inline double horizontalSum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    low = _mm_add_pd(low, high);
+    __m128d shuffled = _mm_unpackhi_pd(low, low);
+    return _mm_cvtsd_f64(_mm_add_sd(low, shuffled));
+}
+#elif defined(__SSE2__)
+const char* instructionSet() { return "SSE2"; }
+
+inline double horizontalSum(__m128d v) {
+    __m128d shuffled = _mm_unpackhi_pd(v, v);
+    return _mm_cvtsd_f64(_mm_add_sd(v, shuffled));
+}
+#else
+const char* instructionSet() { return "scalar"; }
+#endif
+
+// sum(a[i])
+double sum(const double* a, std::size_t n) {
+    std::size_t i = 0;
+    double total = 0.0;
+#if defined(__AVX2__)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(a + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(a + i + 4));
+    }
+    total = horizontalSum(_mm256_add_pd(acc0, acc1));
+#elif defined(__SSE2__)
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(a + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(a + i + 2));
+    }
+    total = horizontalSum(_mm_add_pd(acc0, acc1));
+#endif
+    for (; i < n; ++i) {
+        total += a[i];
+    }
+    return total;
+}
+
+// sum(a[i] * b[i])
+double dot(const double* a, const double* b, std::size_t n) {
+    std::size_t i = 0;
+    double total = 0.0;
+#if defined(__AVX2__)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    total = horizontalSum(_mm256_add_pd(acc0, acc1));
+#elif defined(__SSE2__)
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+    total = horizontalSum(_mm_add_pd(acc0, acc1));
+#endif
+    for (; i < n; ++i) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+// sum(sqrt(a[i]^2 + b[i]^2))
+double sumHypot(const double* a, const double* b, std::size_t n) {
+    std::size_t i = 0;
+    double total = 0.0;
+#if defined(__AVX2__)
+    __m256d acc = _mm256_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d squares = _mm256_add_pd(_mm256_mul_pd(va, va), _mm256_mul_pd(vb, vb));
+        acc = _mm256_add_pd(acc, _mm256_sqrt_pd(squares));
+    }
+    total = horizontalSum(acc);
+#elif defined(__SSE2__)
+    __m128d acc = _mm_setzero_pd();
+    for (; i + 2 <= n; i += 2) {
+        __m128d va = _mm_loadu_pd(a + i);
+        __m128d vb = _mm_loadu_pd(b + i);
+        __m128d squares = _mm_add_pd(_mm_mul_pd(va, va), _mm_mul_pd(vb, vb));
+        acc = _mm_add_pd(acc, _mm_sqrt_pd(squares));
+    }
+    total = horizontalSum(acc);
+#endif
+    for (; i < n; ++i) {
+        total += std::sqrt(a[i] * a[i] + b[i] * b[i]);
+    }
+    return total;
+}
+
+// out[i] = scale * a[i] * b[i]   (evaluated left to right, like the virtual path)
+void scaledProduct(double scale, const double* a, const double* b, double* out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    __m256d vs = _mm256_set1_pd(scale);
+    for (; i + 4 <= n; i += 4) {
+        __m256d product = _mm256_mul_pd(_mm256_mul_pd(vs, _mm256_loadu_pd(a + i)), _mm256_loadu_pd(b + i));
+        _mm256_storeu_pd(out + i, product);
+    }
+#elif defined(__SSE2__)
+    __m128d vs = _mm_set1_pd(scale);
+    for (; i + 2 <= n; i += 2) {
+        __m128d product = _mm_mul_pd(_mm_mul_pd(vs, _mm_loadu_pd(a + i)), _mm_loadu_pd(b + i));
+        _mm_storeu_pd(out + i, product);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = scale * a[i] * b[i];
+    }
+}
+
+}  // namespace kernels
+
+// ---------------------------------------------------------------------------
+// ShapeStore: one contiguous column per field, one group per shape type
+// ---------------------------------------------------------------------------
+
+enum class ShapeKind : std::uint8_t { Circle, Rectangle, Triangle };
+
+// Identifies a shape inside a ShapeStore (type + index within its group)
+struct ShapeHandle {
+    ShapeKind kind;
+    std::uint32_t index;
+};
+
+class ShapeStore {
+private:
+    struct CircleColumns {
+        std::vector<double> x, y, radius;
+    };
+    struct RectangleColumns {
+        std::vector<double> x, y, width, height;
+    };
+    struct TriangleColumns {
+        std::vector<double> x, y, base, height;
+    };
+
+    CircleColumns circles;
+    RectangleColumns rectangles;
+    TriangleColumns triangles;
+
+public:
+    void reserve(std::size_t circleCount, std::size_t rectangleCount, std::size_t triangleCount) {
+        circles.x.reserve(circleCount);
+        circles.y.reserve(circleCount);
+        circles.radius.reserve(circleCount);
+        rectangles.x.reserve(rectangleCount);
+        rectangles.y.reserve(rectangleCount);
+        rectangles.width.reserve(rectangleCount);
+        rectangles.height.reserve(rectangleCount);
+        triangles.x.reserve(triangleCount);
+        triangles.y.reserve(triangleCount);
+        triangles.base.reserve(triangleCount);
+        triangles.height.reserve(triangleCount);
+    }
+
+    ShapeHandle addCircle(double r, double posX = 0, double posY = 0) {
+        circles.x.push_back(posX);
+        circles.y.push_back(posY);
+        circles.radius.push_back(r);
+        return {ShapeKind::Circle, static_cast<std::uint32_t>(circles.radius.size() - 1)};
+    }
+
+    ShapeHandle addRectangle(double w, double h, double posX = 0, double posY = 0) {
+        rectangles.x.push_back(posX);
+        rectangles.y.push_back(posY);
+        rectangles.width.push_back(w);
+        rectangles.height.push_back(h);
+        return {ShapeKind::Rectangle, static_cast<std::uint32_t>(rectangles.width.size() - 1)};
+    }
+
+    ShapeHandle addTriangle(double b, double h, double posX = 0, double posY = 0) {
+        triangles.x.push_back(posX);
+        triangles.y.push_back(posY);
+        triangles.base.push_back(b);
+        triangles.height.push_back(h);
+        return {ShapeKind::Triangle, static_cast<std::uint32_t>(triangles.base.size() - 1)};
+    }
+
+    std::size_t circleCount() const { return circles.radius.size(); }
+    std::size_t rectangleCount() const { return rectangles.width.size(); }
+    std::size_t triangleCount() const { return triangles.base.size(); }
+    std::size_t size() const { return circleCount() + rectangleCount() + triangleCount(); }
+
+    // Sum of all areas: PI*sum(r^2) + sum(w*h) + 0.5*sum(b*h)
+    double totalArea() const {
+        const double* r = circles.radius.data();
+        return PI * kernels::dot(r, r, circleCount())
+             + kernels::dot(rectangles.width.data(), rectangles.height.data(), rectangleCount())
+             + 0.5 * kernels::dot(triangles.base.data(), triangles.height.data(), triangleCount());
+    }
+
+    // Sum of all perimeters: 2*PI*sum(r) + 2*sum(w+h) + sum(b+h+hypot(b,h))
+    double totalPerimeter() const {
+        double circlePart = 2 * PI * kernels::sum(circles.radius.data(), circleCount());
+        double rectanglePart = 2 * (kernels::sum(rectangles.width.data(), rectangleCount())
+                                  + kernels::sum(rectangles.height.data(), rectangleCount()));
+        double trianglePart = kernels::sum(triangles.base.data(), triangleCount())
+                            + kernels::sum(triangles.height.data(), triangleCount())
+                            + kernels::sumHypot(triangles.base.data(), triangles.height.data(), triangleCount());
+        return circlePart + rectanglePart + trianglePart;
+    }
+
+    // Position of a shape in the output of computeAreas()
+    std::size_t flatIndex(ShapeHandle handle) const {
+        switch (handle.kind) {
+            case ShapeKind::Circle:    return handle.index;
+            case ShapeKind::Rectangle: return circleCount() + handle.index;
+            case ShapeKind::Triangle:  return circleCount() + rectangleCount() + handle.index;
+        }
+        return 0;
+    }
+
+    // Per-shape areas, grouped as [circles..., rectangles..., triangles...].
+    // Each value is bit-identical to the matching virtual getArea() call.
+    void computeAreas(std::vector<double>& areas) const {
+        areas.resize(size());
+        double* out = areas.data();
+        const double* r = circles.radius.data();
+        kernels::scaledProduct(PI, r, r, out, circleCount());
+        out += circleCount();
+        kernels::scaledProduct(1.0, rectangles.width.data(), rectangles.height.data(), out, rectangleCount());
+        out += rectangleCount();
+        kernels::scaledProduct(0.5, triangles.base.data(), triangles.height.data(), out, triangleCount());
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+// Both representations of the same random scene
+struct Scene {
+    std::vector<std::unique_ptr<Shape>> objects;
+    std::vector<Shape*> pointers;
+    std::vector<ShapeHandle> handles;  // handles[i] describes objects[i]
+    ShapeStore store;
+};
+
+Scene buildScene(std::size_t count, unsigned seed) {
+    Scene scene;
+    scene.objects.reserve(count);
+    scene.pointers.reserve(count);
+    scene.handles.reserve(count);
+    scene.store.reserve(count / 3 + 1, count / 3 + 1, count / 3 + 1);
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> kindDist(0, 2);
+    std::uniform_real_distribution<double> sizeDist(0.5, 10.0);
+    std::uniform_real_distribution<double> posDist(-1000.0, 1000.0);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        double a = sizeDist(rng);
+        double b = sizeDist(rng);
+        double px = posDist(rng);
+        double py = posDist(rng);
+        switch (kindDist(rng)) {
+            case 0:
+                scene.objects.push_back(std::make_unique<Circle>("c", a, px, py));
+                scene.handles.push_back(scene.store.addCircle(a, px, py));
+                break;
+            case 1:
+                scene.objects.push_back(std::make_unique<Rectangle>("r", a, b, px, py));
+                scene.handles.push_back(scene.store.addRectangle(a, b, px, py));
+                break;
+            default:
+                scene.objects.push_back(std::make_unique<Triangle>("t", a, b, px, py));
+                scene.handles.push_back(scene.store.addTriangle(a, b, px, py));
+                break;
+        }
+        scene.pointers.push_back(scene.objects.back().get());
+    }
+    return scene;
+}
+
+bool closeEnough(double a, double b) {
+    // Totals are summed in a different order, so allow rounding differences
+    return std::fabs(a - b) <= 1e-9 * std::fabs(b);
+}
+
+void demonstrateShapeStore() {
+    std::cout << "1. Building the same shapes in both layouts:" << std::endl;
+    Scene scene = buildScene(9, 3);
+    std::cout << "  Virtual objects: " << scene.objects.size() << std::endl;
+    std::cout << "  ShapeStore: " << scene.store.circleCount() << " circles, "
+              << scene.store.rectangleCount() << " rectangles, "
+              << scene.store.triangleCount() << " triangles" << std::endl;
+    std::cout << "  SIMD kernels: " << kernels::instructionSet() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "2. Comparing results:" << std::endl;
+    std::cout << "  Total area (virtual):    " << calculateTotalArea(scene.pointers) << std::endl;
+    std::cout << "  Total area (SoA):        " << scene.store.totalArea() << std::endl;
+    std::cout << "  Total perimeter (virtual): " << calculateTotalPerimeter(scene.pointers) << std::endl;
+    std::cout << "  Total perimeter (SoA):     " << scene.store.totalPerimeter() << std::endl;
+
+    std::vector<double> areas;
+    scene.store.computeAreas(areas);
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::cout << "  Shape " << i << " area: " << scene.objects[i]->getArea()
+                  << " (virtual) vs " << areas[scene.store.flatIndex(scene.handles[i])]
+                  << " (SoA)" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void benchmarkShapeStore(std::size_t count) {
+    std::cout << "  --- " << count << " shapes ---" << std::endl;
+    Scene scene = buildScene(count, 7);
+    const int repetitions = 5;
+
+    double virtualArea = 0, storeArea = 0, virtualPerimeter = 0, storePerimeter = 0;
+    std::vector<double> virtualAreas(count), storeAreas;
+
+    double tVirtualArea = bench::bestTimeMs(repetitions, [&] { virtualArea = calculateTotalArea(scene.pointers); });
+    double tStoreArea = bench::bestTimeMs(repetitions, [&] { storeArea = scene.store.totalArea(); });
+    double tVirtualPerimeter = bench::bestTimeMs(repetitions, [&] { virtualPerimeter = calculateTotalPerimeter(scene.pointers); });
+    double tStorePerimeter = bench::bestTimeMs(repetitions, [&] { storePerimeter = scene.store.totalPerimeter(); });
+    double tVirtualAreas = bench::bestTimeMs(repetitions, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            virtualAreas[i] = scene.pointers[i]->getArea();
+        }
+    });
+    double tStoreAreas = bench::bestTimeMs(repetitions, [&] { scene.store.computeAreas(storeAreas); });
+
+    bool areasMatch = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (virtualAreas[i] != storeAreas[scene.store.flatIndex(scene.handles[i])]) {
+            areasMatch = false;
+            break;
+        }
+    }
+
+    std::cout << "  Total area:      virtual " << tVirtualArea << " ms, SoA " << tStoreArea
+              << " ms (x" << tVirtualArea / tStoreArea << ")" << std::endl;
+    std::cout << "  Total perimeter: virtual " << tVirtualPerimeter << " ms, SoA " << tStorePerimeter
+              << " ms (x" << tVirtualPerimeter / tStorePerimeter << ")" << std::endl;
+    std::cout << "  Per-shape areas: virtual " << tVirtualAreas << " ms, SoA " << tStoreAreas
+              << " ms (x" << tVirtualAreas / tStoreAreas << ")" << std::endl;
+    std::cout << "  Totals match: "
+              << (closeEnough(storeArea, virtualArea) && closeEnough(storePerimeter, virtualPerimeter) ? "Yes" : "No")
+              << ", per-shape areas identical: " << (areasMatch ? "Yes" : "No") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Structure-of-Arrays Shape Store ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateShapeStore();
+
+    std::cout << "3. Benchmark (best of 5 runs):" << std::endl;
+    std::vector<std::size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    }
+    if (sizes.empty()) {
+        sizes = {1000000, 10000000};
+    }
+    for (std::size_t count : sizes) {
+        benchmarkShapeStore(count);
+    }
+    std::cout << std::endl;
+
+    std::cout << "=== End of Shape Store Example ===" << std::endl;
+
+    return 0;
+}
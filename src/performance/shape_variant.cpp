@@ -0,0 +1,432 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <variant>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <new>
+#include "bench.h"
+
+/**
+ * Closed-Hierarchy Dispatch with std::variant
+ *
+ * This example demonstrates:
+ * - Replacing a virtual hierarchy with a value type (std::variant)
+ *   when the set of derived classes is fixed (closed)
+ * - std::visit with overloaded lambdas instead of virtual calls
+ * - Storing polymorphic values inline in a std::vector (no heap per object)
+ * - Keeping the same API (getArea, getPerimeter, draw, move, displayInfo)
+ * - Counting heap allocations by replacing the global operator new
+ * - A microbenchmark comparing both dispatch styles
+ *
+ * Usage: ./perf_shape_variant [shapeCount...]   (default: 1000000 10000000)
+ */
+
+constexpr double PI = 3.14159;  // Same constant as polymorphism.cpp
+
+// ---------------------------------------------------------------------------
+// Allocation counter: every operator new in this program goes through here
+// ---------------------------------------------------------------------------
+
+static std::size_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+// ---------------------------------------------------------------------------
+// Virtual reference hierarchy (same behaviour as src/oop/polymorphism.cpp,
+// without constructor/destructor logging so millions of objects can be built)
+// ---------------------------------------------------------------------------
+
+class Shape {
+protected:
+    std::string name;
+    double x, y;  // Position coordinates
+
+public:
+    Shape(const std::string& shapeName, double posX = 0, double posY = 0)
+        : name(shapeName), x(posX), y(posY) {}
+
+    virtual ~Shape() = default;
+
+    virtual double getArea() const = 0;
+    virtual double getPerimeter() const = 0;
+    virtual void draw() const = 0;
+
+    virtual void move(double newX, double newY) {
+        x = newX;
+        y = newY;
+        std::cout << "  " << name << " moved to (" << x << ", " << y << ")" << std::endl;
+    }
+
+    std::string getName() const { return name; }
+    double getX() const { return x; }
+    double getY() const { return y; }
+};
+
+class Circle : public Shape {
+private:
+    double radius;
+
+public:
+    Circle(const std::string& circleName, double r, double posX = 0, double posY = 0)
+        : Shape(circleName, posX, posY), radius(r) {}
+
+    double getArea() const override { return PI * radius * radius; }
+    double getPerimeter() const override { return 2 * PI * radius; }
+    void draw() const override {
+        std::cout << "  Drawing a circle with radius " << radius << std::endl;
+    }
+    void move(double newX, double newY) override {
+        Shape::move(newX, newY);
+        std::cout << "  Circle-specific move completed" << std::endl;
+    }
+};
+
+class Rectangle : public Shape {
+private:
+    double width, height;
+
+public:
+    Rectangle(const std::string& rectName, double w, double h, double posX = 0, double posY = 0)
+        : Shape(rectName, posX, posY), width(w), height(h) {}
+
+    double getArea() const override { return width * height; }
+    double getPerimeter() const override { return 2 * (width + height); }
+    void draw() const override {
+        std::cout << "  Drawing a rectangle " << width << "x" << height << std::endl;
+    }
+};
+
+class Triangle : public Shape {
+private:
+    double base, height;
+
+public:
+    Triangle(const std::string& triName, double b, double h, double posX = 0, double posY = 0)
+        : Shape(triName, posX, posY), base(b), height(h) {}
+
+    double getArea() const override { return 0.5 * base * height; }
+    double getPerimeter() const override {
+        // Simplified calculation (assuming right triangle)
+        return base + height + std::sqrt(base * base + height * height);
+    }
+    void draw() const override {
+        std::cout << "  Drawing a triangle with base " << base
+                  << " and height " << height << std::endl;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Value types: no virtual functions, no vtable pointer, no heap allocation
+// ---------------------------------------------------------------------------
+
+// Common state shared by all value shapes (plain base class, not polymorphic)
+class ShapeBase {
+protected:
+    std::string name;
+    double x, y;
+
+    ShapeBase(const std::string& shapeName, double posX, double posY)
+        : name(shapeName), x(posX), y(posY) {}
+
+public:
+    void move(double newX, double newY) {
+        x = newX;
+        y = newY;
+        std::cout << "  " << name << " moved to (" << x << ", " << y << ")" << std::endl;
+    }
+
+    const std::string& getName() const { return name; }
+    double getX() const { return x; }
+    double getY() const { return y; }
+};
+
+class CircleValue : public ShapeBase {
+private:
+    double radius;
+
+public:
+    CircleValue(const std::string& circleName, double r, double posX = 0, double posY = 0)
+        : ShapeBase(circleName, posX, posY), radius(r) {}
+
+    double getArea() const { return PI * radius * radius; }
+    double getPerimeter() const { return 2 * PI * radius; }
+    void draw() const {
+        std::cout << "  Drawing a circle with radius " << radius << std::endl;
+    }
+
+    // Hides ShapeBase::move; std::visit picks this one statically
+    void move(double newX, double newY) {
+        ShapeBase::move(newX, newY);
+        std::cout << "  Circle-specific move completed" << std::endl;
+    }
+
+    double getRadius() const { return radius; }
+};
+
+class RectangleValue : public ShapeBase {
+private:
+    double width, height;
+
+public:
+    RectangleValue(const std::string& rectName, double w, double h, double posX = 0, double posY = 0)
+        : ShapeBase(rectName, posX, posY), width(w), height(h) {}
+
+    double getArea() const { return width * height; }
+    double getPerimeter() const { return 2 * (width + height); }
+    void draw() const {
+        std::cout << "  Drawing a rectangle " << width << "x" << height << std::endl;
+    }
+
+    double getWidth() const { return width; }
+    double getHeight() const { return height; }
+};
+
+class TriangleValue : public ShapeBase {
+private:
+    double base, height;
+
+public:
+    TriangleValue(const std::string& triName, double b, double h, double posX = 0, double posY = 0)
+        : ShapeBase(triName, posX, posY), base(b), height(h) {}
+
+    double getArea() const { return 0.5 * base * height; }
+    double getPerimeter() const {
+        // Simplified calculation (assuming right triangle)
+        return base + height + std::sqrt(base * base + height * height);
+    }
+    void draw() const {
+        std::cout << "  Drawing a triangle with base " << base
+                  << " and height " << height << std::endl;
+    }
+
+    double getBase() const { return base; }
+    double getHeight() const { return height; }
+};
+
+// Helper to build a visitor from several lambdas
+template <typename... Lambdas>
+struct Overloaded : Lambdas... {
+    using Lambdas::operator()...;
+};
+template <typename... Lambdas>
+Overloaded(Lambdas...) -> Overloaded<Lambdas...>;
+
+// A shape stored by value. Same member functions as Shape, but every call
+// is a switch over three known types that the compiler can inline.
+class ShapeValue {
+private:
+    std::variant<CircleValue, RectangleValue, TriangleValue> shape;
+
+public:
+    ShapeValue(CircleValue circle) : shape(std::move(circle)) {}
+    ShapeValue(RectangleValue rectangle) : shape(std::move(rectangle)) {}
+    ShapeValue(TriangleValue triangle) : shape(std::move(triangle)) {}
+
+    double getArea() const {
+        return std::visit([](const auto& s) { return s.getArea(); }, shape);
+    }
+
+    double getPerimeter() const {
+        return std::visit([](const auto& s) { return s.getPerimeter(); }, shape);
+    }
+
+    void draw() const {
+        std::visit([](const auto& s) { s.draw(); }, shape);
+    }
+
+    void move(double newX, double newY) {
+        std::visit([newX, newY](auto& s) { s.move(newX, newY); }, shape);
+    }
+
+    void displayInfo() const {
+        std::cout << "  Shape: " << getName() << " at (" << getX() << ", " << getY() << ")" << std::endl;
+        std::cout << "    Area: " << getArea() << std::endl;
+        std::cout << "    Perimeter: " << getPerimeter() << std::endl;
+    }
+
+    const std::string& getName() const {
+        return std::visit([](const auto& s) -> const std::string& { return s.getName(); }, shape);
+    }
+    double getX() const {
+        return std::visit([](const auto& s) { return s.getX(); }, shape);
+    }
+    double getY() const {
+        return std::visit([](const auto& s) { return s.getY(); }, shape);
+    }
+
+    // Type-specific access, e.g. shape.visit(Overloaded{...})
+    template <typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) const {
+        return std::visit(std::forward<Visitor>(visitor), shape);
+    }
+};
+
+double calculateTotalArea(const std::vector<std::unique_ptr<Shape>>& shapes) {
+    double totalArea = 0.0;
+    for (const auto& shape : shapes) {
+        totalArea += shape->getArea();
+    }
+    return totalArea;
+}
+
+double calculateTotalArea(const std::vector<ShapeValue>& shapes) {
+    double totalArea = 0.0;
+    for (const ShapeValue& shape : shapes) {
+        totalArea += shape.getArea();
+    }
+    return totalArea;
+}
+
+double calculateTotalPerimeter(const std::vector<std::unique_ptr<Shape>>& shapes) {
+    double totalPerimeter = 0.0;
+    for (const auto& shape : shapes) {
+        totalPerimeter += shape->getPerimeter();
+    }
+    return totalPerimeter;
+}
+
+double calculateTotalPerimeter(const std::vector<ShapeValue>& shapes) {
+    double totalPerimeter = 0.0;
+    for (const ShapeValue& shape : shapes) {
+        totalPerimeter += shape.getPerimeter();
+    }
+    return totalPerimeter;
+}
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void demonstrateShapeValue() {
+    std::cout << "1. Value shapes stored inline in a vector:" << std::endl;
+    std::vector<ShapeValue> shapes;
+    shapes.reserve(3);
+    std::size_t before = allocationCount;
+    shapes.emplace_back(CircleValue("ValueCircle", 3.0));
+    shapes.emplace_back(RectangleValue("ValueRect", 5.0, 3.0));
+    shapes.emplace_back(TriangleValue("ValueTri", 4.0, 3.0));
+    std::cout << "  Heap allocations for 3 shapes: " << allocationCount - before << std::endl;
+    std::cout << "  sizeof(ShapeValue): " << sizeof(ShapeValue) << " bytes" << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "2. Same API as the virtual hierarchy:" << std::endl;
+    for (ShapeValue& shape : shapes) {
+        shape.displayInfo();
+        shape.draw();
+        shape.move(shape.getX() + 10, shape.getY() + 10);
+    }
+    std::cout << std::endl;
+
+    std::cout << "3. Type-specific access with a visitor:" << std::endl;
+    for (const ShapeValue& shape : shapes) {
+        shape.visit(Overloaded{
+            [](const CircleValue& c) { std::cout << "  Circle radius: " << c.getRadius() << std::endl; },
+            [](const RectangleValue& r) { std::cout << "  Rectangle width: " << r.getWidth() << std::endl; },
+            [](const TriangleValue& t) { std::cout << "  Triangle base: " << t.getBase() << std::endl; }
+        });
+    }
+    std::cout << std::endl;
+}
+
+void benchmarkDispatch(std::size_t count) {
+    std::cout << "  --- " << count << " shapes ---" << std::endl;
+
+    // Same random parameters for both versions
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> kindDist(0, 2);
+    std::uniform_real_distribution<double> sizeDist(0.5, 10.0);
+    std::vector<int> kinds(count);
+    std::vector<double> a(count), b(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        kinds[i] = kindDist(rng);
+        a[i] = sizeDist(rng);
+        b[i] = sizeDist(rng);
+    }
+
+    std::vector<std::unique_ptr<Shape>> virtualShapes;
+    std::vector<ShapeValue> valueShapes;
+
+    std::size_t before = allocationCount;
+    double tBuildVirtual = bench::timeMs([&] {
+        virtualShapes.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            switch (kinds[i]) {
+                case 0:  virtualShapes.push_back(std::make_unique<Circle>("c", a[i])); break;
+                case 1:  virtualShapes.push_back(std::make_unique<Rectangle>("r", a[i], b[i])); break;
+                default: virtualShapes.push_back(std::make_unique<Triangle>("t", a[i], b[i])); break;
+            }
+        }
+    });
+    std::size_t virtualAllocations = allocationCount - before;
+
+    before = allocationCount;
+    double tBuildValue = bench::timeMs([&] {
+        valueShapes.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            switch (kinds[i]) {
+                case 0:  valueShapes.emplace_back(CircleValue("c", a[i])); break;
+                case 1:  valueShapes.emplace_back(RectangleValue("r", a[i], b[i])); break;
+                default: valueShapes.emplace_back(TriangleValue("t", a[i], b[i])); break;
+            }
+        }
+    });
+    std::size_t valueAllocations = allocationCount - before;
+
+    double virtualArea = 0, valueArea = 0, virtualPerimeter = 0, valuePerimeter = 0;
+    double tAreaVirtual = bench::timeMs([&] { virtualArea = calculateTotalArea(virtualShapes); });
+    double tAreaValue = bench::timeMs([&] { valueArea = calculateTotalArea(valueShapes); });
+    double tPerimeterVirtual = bench::timeMs([&] { virtualPerimeter = calculateTotalPerimeter(virtualShapes); });
+    double tPerimeterValue = bench::timeMs([&] { valuePerimeter = calculateTotalPerimeter(valueShapes); });
+
+    double tDestroyVirtual = bench::timeMs([&] { virtualShapes.clear(); virtualShapes.shrink_to_fit(); });
+    double tDestroyValue = bench::timeMs([&] { valueShapes.clear(); valueShapes.shrink_to_fit(); });
+
+    std::cout << "  Build:     virtual " << tBuildVirtual << " ms (" << virtualAllocations
+              << " allocations), variant " << tBuildValue << " ms (" << valueAllocations
+              << " allocations)" << std::endl;
+    std::cout << "  Area:      virtual " << tAreaVirtual << " ms, variant " << tAreaValue
+              << " ms (x" << tAreaVirtual / tAreaValue << ")" << std::endl;
+    std::cout << "  Perimeter: virtual " << tPerimeterVirtual << " ms, variant " << tPerimeterValue
+              << " ms (x" << tPerimeterVirtual / tPerimeterValue << ")" << std::endl;
+    std::cout << "  Destroy:   virtual " << tDestroyVirtual << " ms, variant " << tDestroyValue
+              << " ms" << std::endl;
+    std::cout << "  Results identical: "
+              << (virtualArea == valueArea && virtualPerimeter == valuePerimeter ? "Yes" : "No") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== std::variant Shape Dispatch ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateShapeValue();
+
+    std::cout << "4. Benchmark (virtual + unique_ptr vs variant by value):" << std::endl;
+    std::vector<std::size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    }
+    if (sizes.empty()) {
+        sizes = {1000000, 10000000};
+    }
+    for (std::size_t count : sizes) {
+        benchmarkDispatch(count);
+    }
+    std::cout << std::endl;
+
+    std::cout << "=== End of Shape Variant Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include "sharded_counter.h"
+#include "bench.h"
+
+/**
+ * Sharded Counters for Object Populations
+ *
+ * This example demonstrates:
+ * - Why `static int totalStudents` is a data race once objects are
+ *   created on several threads
+ * - Why one std::atomic<int> shared by every thread becomes a bottleneck
+ *   (every update moves the same cache line between cores)
+ * - ShardedCounter / InstanceCounter from sharded_counter.h, which
+ *   Student and Course in src/oop/classes.cpp use
+ * - A multithreaded stress test and a contention benchmark
+ *
+ * Usage: ./perf_sharded_counter [operationsPerThread]   (default: 10000000)
+ */
+
+// Student-like class counted through the CRTP mixin (no logging)
+class CountedStudent : public InstanceCounter<CountedStudent> {
+private:
+    std::string name;
+    int age;
+    std::vector<double> grades;
+
+public:
+    CountedStudent(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+
+    void addGrade(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            grades.push_back(grade);
+        }
+    }
+};
+
+// Runs work(threadIndex) on `threads` threads and waits for all of them
+template <typename Work>
+void runOnThreads(unsigned threads, Work&& work) {
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(work, t);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void stressTest() {
+    std::cout << "1. Stress test: students created, copied, moved and destroyed on 8 threads:" << std::endl;
+    const unsigned threads = 8;
+    const int perThread = 20000;
+    std::vector<std::vector<CountedStudent>> kept(threads);
+
+    runOnThreads(threads, [&](unsigned t) {
+        std::vector<CountedStudent>& mine = kept[t];
+        for (int i = 0; i < perThread; ++i) {
+            CountedStudent student("Student", 20);
+            student.addGrade(90.0);
+            CountedStudent copy = student;           // Copy constructor
+            mine.push_back(std::move(copy));         // Move constructor (and vector regrowth)
+        }
+    });
+    long long expected = static_cast<long long>(threads) * perThread;
+    long long afterBuild = CountedStudent::liveInstances();
+    std::cout << "  Live students after building: " << afterBuild << " (expected " << expected << ")"
+              << std::endl;
+
+    runOnThreads(threads, [&](unsigned t) { kept[t].clear(); });
+    long long afterClear = CountedStudent::liveInstances();
+    std::cout << "  Live students after destroying: " << afterClear << " (expected 0)" << std::endl;
+    std::cout << "  Stress test " << (afterBuild == expected && afterClear == 0 ? "passed" : "FAILED")
+              << std::endl;
+    std::cout << std::endl;
+}
+
+void contentionBenchmark(long long operationsPerThread) {
+    std::cout << "2. Contention benchmark (" << operationsPerThread
+              << " increment/decrement pairs per thread, " << std::thread::hardware_concurrency()
+              << " hardware threads):" << std::endl;
+
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        std::atomic<int> single{0};
+        double atomicMs = bench::timeMs([&] {
+            runOnThreads(threads, [&](unsigned) {
+                for (long long i = 0; i < operationsPerThread; ++i) {
+                    single.fetch_add(1, std::memory_order_relaxed);
+                    single.fetch_sub(1, std::memory_order_relaxed);
+                }
+            });
+        });
+
+        ShardedCounter sharded;
+        double shardedMs = bench::timeMs([&] {
+            runOnThreads(threads, [&](unsigned) {
+                for (long long i = 0; i < operationsPerThread; ++i) {
+                    sharded.increment();
+                    sharded.decrement();
+                }
+            });
+        });
+
+        std::cout << "  " << threads << " threads: std::atomic<int> " << atomicMs << " ms, ShardedCounter "
+                  << shardedMs << " ms (x" << atomicMs / shardedMs << "), final values "
+                  << single.load() << " / " << sharded.load() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Sharded Population Counter ===" << std::endl;
+    std::cout << std::endl;
+
+    stressTest();
+
+    long long operationsPerThread = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    contentionBenchmark(operationsPerThread);
+
+    std::cout << "=== End of Sharded Counter Example ===" << std::endl;
+
+    return 0;
+}
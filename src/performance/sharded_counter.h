@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Sharded Counter
+ *
+ * A thread-safe counter for values that are updated far more often than
+ * they are read (e.g. "how many objects are alive").
+ *
+ * - Every thread is assigned one shard on first use and only touches that
+ *   shard, so updates from different threads do not fight over one cache line
+ * - Each shard sits on its own cache line (no false sharing)
+ * - load() adds all shards together; it is exact once writers are quiet
+ *   and a consistent-enough snapshot while they are running
+ *
+ * InstanceCounter<T> builds on it: derive from it and the number of live
+ * T objects is tracked automatically. Every constructor (including copy
+ * and move) adds one and the destructor subtracts one; assignments do not
+ * change the count. It does not count how many of each operation ran.
+ */
+
+class ShardedCounter {
+private:
+    static constexpr std::size_t shardCount = 64;
+    static constexpr std::size_t cacheLineSize = 64;
+
+    struct alignas(cacheLineSize) Shard {
+        std::atomic<long long> value{0};
+    };
+
+    std::array<Shard, shardCount> shards;
+
+    // Threads get shards round-robin; the index is shared by all counters
+    static std::size_t threadShard() {
+        static std::atomic<std::size_t> nextShard{0};
+        thread_local std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % shardCount;
+        return shard;
+    }
+
+public:
+    ShardedCounter() = default;
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    void add(long long delta) {
+        shards[threadShard()].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void increment() { add(1); }
+    void decrement() { add(-1); }
+
+    long long load() const {
+        long long total = 0;
+        for (const Shard& shard : shards) {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+// Counts live instances of T (CRTP: class Course : public InstanceCounter<Course>)
+template <typename T>
+class InstanceCounter {
+private:
+    static inline ShardedCounter live;
+
+protected:
+    InstanceCounter() { live.increment(); }
+    InstanceCounter(const InstanceCounter&) { live.increment(); }
+    InstanceCounter(InstanceCounter&&) noexcept { live.increment(); }
+    InstanceCounter& operator=(const InstanceCounter&) = default;
+    InstanceCounter& operator=(InstanceCounter&&) noexcept = default;
+    ~InstanceCounter() { live.decrement(); }
+
+public:
+    static long long liveInstances() { return live.load(); }
+};
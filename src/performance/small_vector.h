@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * SmallVector<T, N>
+ *
+ * A std::vector-like container that keeps up to N elements inside the
+ * object itself and only allocates on the heap once it grows past N.
+ * Ideal for "usually small" lists such as the grades of one Student.
+ *
+ * - push_back/emplace_back/pop_back, size/empty/capacity, reserve, resize,
+ *   clear, operator[]/at, front/back, data, begin/end (pointer iterators)
+ * - Copy and move construction and assignment. Moving a heap-backed
+ *   vector steals its buffer; moving an inline one moves the elements.
+ * - Iterators and references are invalidated by growth, as with std::vector
+ */
+
+template <typename T, std::size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+private:
+    T* elements;
+    std::size_t count = 0;
+    std::size_t reserved = N;
+    alignas(T) unsigned char inlineBuffer[N * sizeof(T)];
+
+    T* inlineData() { return std::launder(reinterpret_cast<T*>(inlineBuffer)); }
+    bool isInline() const { return elements == reinterpret_cast<const T*>(inlineBuffer); }
+
+    // Moves the elements into a heap buffer with room for newCapacity
+    void reallocate(std::size_t newCapacity) {
+        T* buffer = std::allocator<T>().allocate(newCapacity);
+        std::uninitialized_move(elements, elements + count, buffer);
+        std::destroy(elements, elements + count);
+        releaseHeap();
+        elements = buffer;
+        reserved = newCapacity;
+    }
+
+    void releaseHeap() {
+        if (!isInline()) {
+            std::allocator<T>().deallocate(elements, reserved);
+        }
+    }
+
+    void growFor(std::size_t required) {
+        if (required > reserved) {
+            reallocate(std::max(required, reserved * 2));
+        }
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() : elements(inlineData()) {}
+
+    SmallVector(std::initializer_list<T> values) : SmallVector() {
+        reserve(values.size());
+        for (const T& value : values) {
+            push_back(value);
+        }
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        reserve(other.count);
+        std::uninitialized_copy(other.begin(), other.end(), elements);
+        count = other.count;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), elements);
+            count = other.count;
+            other.clear();
+        } else {
+            // Take over the heap buffer; other falls back to its inline storage
+            elements = std::exchange(other.elements, other.inlineData());
+            count = std::exchange(other.count, 0);
+            reserved = std::exchange(other.reserved, N);
+        }
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.count);
+            std::uninitialized_copy(other.begin(), other.end(), elements);
+            count = other.count;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            if (other.isInline()) {
+                std::uninitialized_move(other.begin(), other.end(), elements);
+                count = other.count;
+                other.clear();
+            } else {
+                releaseHeap();
+                elements = std::exchange(other.elements, other.inlineData());
+                count = std::exchange(other.count, 0);
+                reserved = std::exchange(other.reserved, N);
+            }
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (count == reserved) {
+            // Construct first: args may refer to an element of this vector
+            T value(std::forward<Args>(args)...);
+            growFor(count + 1);
+            ::new (static_cast<void*>(elements + count)) T(std::move(value));
+        } else {
+            ::new (static_cast<void*>(elements + count)) T(std::forward<Args>(args)...);
+        }
+        return elements[count++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        std::destroy_at(elements + --count);
+    }
+
+    void clear() {
+        std::destroy(elements, elements + count);
+        count = 0;
+    }
+
+    void reserve(std::size_t newCapacity) {
+        if (newCapacity > reserved) {
+            reallocate(newCapacity);
+        }
+    }
+
+    void resize(std::size_t newSize, const T& value = T()) {
+        if (newSize < count) {
+            std::destroy(elements + newSize, elements + count);
+        } else if (newSize > reserved) {
+            // Copy first: value may refer to an element of this vector
+            T fill(value);
+            growFor(newSize);
+            std::uninitialized_fill(elements + count, elements + newSize, fill);
+        } else {
+            std::uninitialized_fill(elements + count, elements + newSize, value);
+        }
+        count = newSize;
+    }
+
+    T& operator[](std::size_t index) { return elements[index]; }
+    const T& operator[](std::size_t index) const { return elements[index]; }
+
+    T& at(std::size_t index) {
+        if (index >= count) {
+            throw std::out_of_range("SmallVector::at");
+        }
+        return elements[index];
+    }
+    const T& at(std::size_t index) const {
+        if (index >= count) {
+            throw std::out_of_range("SmallVector::at");
+        }
+        return elements[index];
+    }
+
+    T& front() { return elements[0]; }
+    const T& front() const { return elements[0]; }
+    T& back() { return elements[count - 1]; }
+    const T& back() const { return elements[count - 1]; }
+
+    T* data() { return elements; }
+    const T* data() const { return elements; }
+
+    iterator begin() { return elements; }
+    iterator end() { return elements + count; }
+    const_iterator begin() const { return elements; }
+    const_iterator end() const { return elements + count; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t capacity() const { return reserved; }
+
+    // True while the elements still live inside the object (no heap buffer)
+    bool isSmall() const { return isInline(); }
+
+    friend bool operator==(const SmallVector& a, const SmallVector& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
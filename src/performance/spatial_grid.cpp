@@ -0,0 +1,569 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <limits>
+#include <random>
+#include "bench.h"
+
+/**
+ * Spatial Grid Index for Shapes
+ *
+ * This example demonstrates:
+ * - Axis-aligned bounding boxes (getBounds) for the Shape hierarchy
+ * - A loose uniform grid: each shape lives in the cell of its box center,
+ *   queries are widened by the largest shape so nothing is missed
+ * - An overflow list for shapes whose center leaves the world box
+ * - Range queries and nearest-neighbour search (ring by ring)
+ * - Incremental updates: Shape::move notifies the index (observer pattern),
+ *   so moving a shape costs O(1) instead of rebuilding the index
+ * - Checking the index against a linear scan, and a benchmark
+ *
+ * Box convention: a Circle is centered on (x, y); Rectangle and Triangle
+ * have their lower-left corner at (x, y).
+ *
+ * Usage: ./perf_spatial_grid [shapeCount] [movesPerFrame] [frames]
+ *        (default: 1000000 5000 10)
+ */
+
+struct Box {
+    double minX, minY, maxX, maxY;
+
+    bool intersects(const Box& other) const {
+        return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+
+    bool contains(double px, double py) const {
+        return px >= minX && px <= maxX && py >= minY && py <= maxY;
+    }
+
+    // Euclidean distance from a point to the box (0 if the point is inside)
+    double distanceTo(double px, double py) const {
+        double dx = std::max({minX - px, 0.0, px - maxX});
+        double dy = std::max({minY - py, 0.0, py - maxY});
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    double centerX() const { return 0.5 * (minX + maxX); }
+    double centerY() const { return 0.5 * (minY + maxY); }
+    double halfDiagonal() const { return 0.5 * std::hypot(maxX - minX, maxY - minY); }
+};
+
+// ---------------------------------------------------------------------------
+// Shape hierarchy with move notifications
+// ---------------------------------------------------------------------------
+
+class Shape;
+
+// Implemented by anything that must follow shape positions (e.g. an index)
+class ShapeObserver {
+public:
+    virtual ~ShapeObserver() = default;
+    virtual void shapeMoved(Shape& shape) = 0;
+    virtual void shapeDestroyed(Shape& shape) = 0;
+};
+
+class Shape {
+protected:
+    std::string name;
+    double x, y;  // Position coordinates
+
+private:
+    ShapeObserver* observer = nullptr;
+    std::uint32_t indexId = 0;  // Slot inside the observing index
+
+    friend class SpatialGrid;
+
+public:
+    Shape(const std::string& shapeName, double posX = 0, double posY = 0)
+        : name(shapeName), x(posX), y(posY) {}
+
+    // Copies would share the observer registration, so forbid them
+    Shape(const Shape&) = delete;
+    Shape& operator=(const Shape&) = delete;
+
+    virtual ~Shape() {
+        if (observer) {
+            observer->shapeDestroyed(*this);
+        }
+    }
+
+    virtual double getArea() const = 0;
+    virtual Box getBounds() const = 0;
+
+    // Derived classes that override move() must call Shape::move()
+    virtual void move(double newX, double newY) {
+        x = newX;
+        y = newY;
+        if (observer) {
+            observer->shapeMoved(*this);
+        }
+    }
+
+    std::string getName() const { return name; }
+    double getX() const { return x; }
+    double getY() const { return y; }
+};
+
+class Circle : public Shape {
+private:
+    double radius;
+
+public:
+    Circle(const std::string& circleName, double r, double posX = 0, double posY = 0)
+        : Shape(circleName, posX, posY), radius(r) {}
+
+    double getArea() const override { return 3.14159 * radius * radius; }
+    Box getBounds() const override { return {x - radius, y - radius, x + radius, y + radius}; }
+};
+
+class Rectangle : public Shape {
+private:
+    double width, height;
+
+public:
+    Rectangle(const std::string& rectName, double w, double h, double posX = 0, double posY = 0)
+        : Shape(rectName, posX, posY), width(w), height(h) {}
+
+    double getArea() const override { return width * height; }
+    Box getBounds() const override { return {x, y, x + width, y + height}; }
+};
+
+class Triangle : public Shape {
+private:
+    double base, height;
+
+public:
+    Triangle(const std::string& triName, double b, double h, double posX = 0, double posY = 0)
+        : Shape(triName, posX, posY), base(b), height(h) {}
+
+    double getArea() const override { return 0.5 * base * height; }
+    Box getBounds() const override { return {x, y, x + base, y + height}; }
+};
+
+// ---------------------------------------------------------------------------
+// SpatialGrid
+// ---------------------------------------------------------------------------
+
+class SpatialGrid : public ShapeObserver {
+private:
+    struct Entry {
+        Box bounds;          // Copy of the shape's box, so queries never touch the Shape
+        std::uint32_t id;
+    };
+    struct Location {
+        std::uint32_t cell;
+        std::uint32_t slot;  // Position inside cells[cell]
+    };
+
+    Box world;
+    double cellSize;
+    int columns, rows;
+    std::vector<std::vector<Entry>> cells;  // Grid cells, plus one overflow list at the end
+    std::uint32_t overflowCell;             // Shapes whose center is outside the world box
+    std::vector<Shape*> shapes;             // Indexed by id
+    std::vector<Location> locations;        // Indexed by id
+    double maxExtent = 0.0;                 // Largest half-diagonal seen so far (never shrinks)
+
+    // Clamp in floating point first so far-away coordinates cannot overflow int
+    int columnOf(double px) const {
+        double column = std::floor((px - world.minX) / cellSize);
+        return static_cast<int>(std::clamp(column, 0.0, columns - 1.0));
+    }
+    int rowOf(double py) const {
+        double row = std::floor((py - world.minY) / cellSize);
+        return static_cast<int>(std::clamp(row, 0.0, rows - 1.0));
+    }
+
+    std::uint32_t cellOf(const Box& bounds) const {
+        double cx = bounds.centerX();
+        double cy = bounds.centerY();
+        if (!world.contains(cx, cy)) {
+            return overflowCell;
+        }
+        return static_cast<std::uint32_t>(rowOf(cy) * columns + columnOf(cx));
+    }
+
+    void place(std::uint32_t id, const Box& bounds) {
+        std::uint32_t cell = cellOf(bounds);
+        locations[id] = {cell, static_cast<std::uint32_t>(cells[cell].size())};
+        cells[cell].push_back({bounds, id});
+        maxExtent = std::max(maxExtent, bounds.halfDiagonal());
+    }
+
+    // Swap-and-pop removal from the shape's current cell
+    void unplace(std::uint32_t id) {
+        Location location = locations[id];
+        std::vector<Entry>& cell = cells[location.cell];
+        cell[location.slot] = cell.back();
+        locations[cell[location.slot].id].slot = location.slot;
+        cell.pop_back();
+    }
+
+public:
+    // The world box only sizes the grid; shapes outside it are still indexed
+    SpatialGrid(const Box& worldBounds, double cellEdge)
+        : world(worldBounds), cellSize(cellEdge) {
+        columns = std::max(1, static_cast<int>(std::ceil((world.maxX - world.minX) / cellSize)));
+        rows = std::max(1, static_cast<int>(std::ceil((world.maxY - world.minY) / cellSize)));
+        overflowCell = static_cast<std::uint32_t>(columns * rows);
+        cells.resize(overflowCell + 1);
+    }
+
+    SpatialGrid(const SpatialGrid&) = delete;
+    SpatialGrid& operator=(const SpatialGrid&) = delete;
+
+    ~SpatialGrid() {
+        clear();
+    }
+
+    void insert(Shape& shape) {
+        if (shape.observer == this) {
+            return;
+        }
+        std::uint32_t id = static_cast<std::uint32_t>(shapes.size());
+        shapes.push_back(&shape);
+        locations.push_back({});
+        shape.observer = this;
+        shape.indexId = id;
+        place(id, shape.getBounds());
+    }
+
+    void remove(Shape& shape) {
+        if (shape.observer != this) {
+            return;
+        }
+        std::uint32_t id = shape.indexId;
+        unplace(id);
+
+        // Keep ids dense: the last shape takes over the freed id
+        std::uint32_t lastId = static_cast<std::uint32_t>(shapes.size() - 1);
+        if (id != lastId) {
+            Shape* last = shapes[lastId];
+            shapes[id] = last;
+            locations[id] = locations[lastId];
+            cells[locations[id].cell][locations[id].slot].id = id;
+            last->indexId = id;
+        }
+        shapes.pop_back();
+        locations.pop_back();
+        shape.observer = nullptr;
+    }
+
+    void clear() {
+        for (Shape* shape : shapes) {
+            shape->observer = nullptr;
+        }
+        shapes.clear();
+        locations.clear();
+        for (auto& cell : cells) {
+            cell.clear();
+        }
+        maxExtent = 0.0;
+    }
+
+    // O(1): update the box in place, or move the entry to its new cell
+    void shapeMoved(Shape& shape) override {
+        std::uint32_t id = shape.indexId;
+        Box bounds = shape.getBounds();
+        Location location = locations[id];
+        std::uint32_t cell = cellOf(bounds);
+        if (cell == location.cell) {
+            cells[cell][location.slot].bounds = bounds;
+            maxExtent = std::max(maxExtent, bounds.halfDiagonal());
+        } else {
+            unplace(id);
+            place(id, bounds);
+        }
+    }
+
+    void shapeDestroyed(Shape& shape) override {
+        remove(shape);
+    }
+
+    // Calls visit(Shape&) for every shape whose box intersects the query box
+    template <typename Visitor>
+    void queryRange(const Box& query, Visitor&& visit) const {
+        for (const Entry& entry : cells[overflowCell]) {
+            if (entry.bounds.intersects(query)) {
+                visit(*shapes[entry.id]);
+            }
+        }
+        int firstColumn = columnOf(query.minX - maxExtent);
+        int lastColumn = columnOf(query.maxX + maxExtent);
+        int firstRow = rowOf(query.minY - maxExtent);
+        int lastRow = rowOf(query.maxY + maxExtent);
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                for (const Entry& entry : cells[static_cast<std::size_t>(row) * columns + column]) {
+                    if (entry.bounds.intersects(query)) {
+                        visit(*shapes[entry.id]);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<Shape*> queryRange(const Box& query) const {
+        std::vector<Shape*> result;
+        queryRange(query, [&result](Shape& shape) { result.push_back(&shape); });
+        return result;
+    }
+
+    // Shape whose box is closest to (px, py); searches rings of cells outward
+    Shape* nearest(double px, double py, double* distance = nullptr) const {
+        if (shapes.empty()) {
+            return nullptr;
+        }
+        int centerColumn = columnOf(px);
+        int centerRow = rowOf(py);
+        int maxRing = std::max({centerColumn, columns - 1 - centerColumn, centerRow, rows - 1 - centerRow});
+
+        double bestDistance = std::numeric_limits<double>::infinity();
+        std::uint32_t bestId = 0;
+        auto scanEntries = [&](const std::vector<Entry>& entries) {
+            for (const Entry& entry : entries) {
+                double d = entry.bounds.distanceTo(px, py);
+                if (d < bestDistance) {
+                    bestDistance = d;
+                    bestId = entry.id;
+                }
+            }
+        };
+        auto scanCell = [&](int column, int row) {
+            if (column >= 0 && column < columns && row >= 0 && row < rows) {
+                scanEntries(cells[static_cast<std::size_t>(row) * columns + column]);
+            }
+        };
+
+        scanEntries(cells[overflowCell]);
+        for (int ring = 0; ring <= maxRing; ++ring) {
+            if (ring == 0) {
+                scanCell(centerColumn, centerRow);
+            } else {
+                for (int column = centerColumn - ring; column <= centerColumn + ring; ++column) {
+                    scanCell(column, centerRow - ring);
+                    scanCell(column, centerRow + ring);
+                }
+                for (int row = centerRow - ring + 1; row <= centerRow + ring - 1; ++row) {
+                    scanCell(centerColumn - ring, row);
+                    scanCell(centerColumn + ring, row);
+                }
+            }
+            // Centers in later rings are at least ring * cellSize away. This also
+            // holds for points outside the world box (projection onto a box
+            // never increases distances).
+            if (bestDistance <= ring * cellSize - maxExtent) {
+                break;
+            }
+        }
+        if (distance) {
+            *distance = bestDistance;
+        }
+        return shapes[bestId];
+    }
+
+    std::size_t size() const { return shapes.size(); }
+    std::size_t cellCount() const { return cells.size() - 1; }
+    std::size_t overflowCount() const { return cells[overflowCell].size(); }
+};
+
+// ---------------------------------------------------------------------------
+// Linear-scan reference
+// ---------------------------------------------------------------------------
+
+std::vector<Shape*> scanRange(const std::vector<Shape*>& shapes, const Box& query) {
+    std::vector<Shape*> result;
+    for (Shape* shape : shapes) {
+        if (shape->getBounds().intersects(query)) {
+            result.push_back(shape);
+        }
+    }
+    return result;
+}
+
+double scanNearestDistance(const std::vector<Shape*>& shapes, double px, double py) {
+    double best = std::numeric_limits<double>::infinity();
+    for (const Shape* shape : shapes) {
+        best = std::min(best, shape->getBounds().distanceTo(px, py));
+    }
+    return best;
+}
+
+bool sameShapes(std::vector<Shape*> a, std::vector<Shape*> b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+std::vector<std::unique_ptr<Shape>> randomShapes(std::size_t count, double worldSize, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> kindDist(0, 2);
+    std::uniform_real_distribution<double> sizeDist(0.5, 10.0);
+    std::uniform_real_distribution<double> posDist(0.0, worldSize);
+    std::vector<std::unique_ptr<Shape>> shapes;
+    shapes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        double a = sizeDist(rng), b = sizeDist(rng), px = posDist(rng), py = posDist(rng);
+        switch (kindDist(rng)) {
+            case 0:  shapes.push_back(std::make_unique<Circle>("c", a, px, py)); break;
+            case 1:  shapes.push_back(std::make_unique<Rectangle>("r", a, b, px, py)); break;
+            default: shapes.push_back(std::make_unique<Triangle>("t", a, b, px, py)); break;
+        }
+    }
+    return shapes;
+}
+
+void demonstrateSpatialGrid() {
+    std::cout << "1. Indexing a few shapes:" << std::endl;
+    SpatialGrid grid({0, 0, 100, 100}, 10);
+    Circle circle("MyCircle", 5.0, 0, 0);
+    Rectangle rectangle("MyRectangle", 4.0, 6.0, 10, 10);
+    Triangle triangle("MyTriangle", 3.0, 4.0, 20, 20);
+    grid.insert(circle);
+    grid.insert(rectangle);
+    grid.insert(triangle);
+    std::cout << "  Shapes: " << grid.size() << " in " << grid.cellCount() << " cells" << std::endl;
+
+    Box query{8, 8, 15, 15};
+    std::cout << "  Shapes in [8,15] x [8,15]:";
+    for (Shape* shape : grid.queryRange(query)) {
+        std::cout << " " << shape->getName();
+    }
+    std::cout << std::endl;
+
+    double distance = 0;
+    Shape* closest = grid.nearest(30, 30, &distance);
+    std::cout << "  Nearest to (30, 30): " << closest->getName() << " at distance " << distance << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "2. Moving a shape updates the index automatically:" << std::endl;
+    circle.move(29, 29);
+    closest = grid.nearest(30, 30, &distance);
+    std::cout << "  After circle.move(29, 29), nearest to (30, 30): " << closest->getName()
+              << " at distance " << distance << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "3. Checking against a linear scan:" << std::endl;
+    const double worldSize = 1000;
+    auto owned = randomShapes(20000, worldSize, 5);
+    std::vector<Shape*> shapes;
+    SpatialGrid bigGrid({0, 0, worldSize, worldSize}, 20);
+    for (auto& shape : owned) {
+        shapes.push_back(shape.get());
+        bigGrid.insert(*shape);
+    }
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> posDist(-50.0, worldSize + 50.0);
+    std::uniform_int_distribution<std::size_t> pick(0, owned.size() - 1);
+    bool rangeOk = true, nearestOk = true;
+    for (int round = 0; round < 200; ++round) {
+        // Some moves leave the world box on purpose
+        for (int m = 0; m < 50; ++m) {
+            owned[pick(rng)]->move(posDist(rng), posDist(rng));
+        }
+        double qx = posDist(rng), qy = posDist(rng);
+        Box box{qx, qy, qx + 40, qy + 25};
+        rangeOk = rangeOk && sameShapes(bigGrid.queryRange(box), scanRange(shapes, box));
+        double d = 0;
+        bigGrid.nearest(qx, qy, &d);
+        nearestOk = nearestOk && d == scanNearestDistance(shapes, qx, qy);
+    }
+    owned.resize(owned.size() / 2);  // Destroyed shapes leave the index
+    shapes.resize(owned.size());
+    Box everything{-100, -100, worldSize + 100, worldSize + 100};
+    rangeOk = rangeOk && sameShapes(bigGrid.queryRange(everything), shapes);
+    std::cout << "  Range queries match: " << (rangeOk ? "Yes" : "No") << std::endl;
+    std::cout << "  Nearest queries match: " << (nearestOk ? "Yes" : "No") << std::endl;
+    std::cout << "  Index size after destroying half the shapes: " << bigGrid.size()
+              << " (" << bigGrid.overflowCount() << " outside the world box)" << std::endl;
+    std::cout << std::endl;
+}
+
+void benchmarkSpatialGrid(std::size_t shapeCount, int movesPerFrame, int frames) {
+    const double worldSize = 10000;
+    const int queriesPerFrame = 20;
+    auto owned = randomShapes(shapeCount, worldSize, 17);
+    std::vector<Shape*> shapes;
+    shapes.reserve(owned.size());
+    for (auto& shape : owned) {
+        shapes.push_back(shape.get());
+    }
+
+    SpatialGrid grid({0, 0, worldSize, worldSize}, 20);
+    double buildMs = bench::timeMs([&] {
+        for (Shape* shape : shapes) {
+            grid.insert(*shape);
+        }
+    });
+
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<std::size_t> pick(0, shapes.size() - 1);
+    std::uniform_real_distribution<double> step(-5.0, 5.0);
+    std::uniform_real_distribution<double> posDist(0.0, worldSize);
+
+    double moveMs = 0, gridQueryMs = 0, scanQueryMs = 0;
+    std::size_t gridHits = 0, scanHits = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        moveMs += bench::timeMs([&] {
+            for (int m = 0; m < movesPerFrame; ++m) {
+                Shape* shape = shapes[pick(rng)];
+                shape->move(shape->getX() + step(rng), shape->getY() + step(rng));
+            }
+        });
+        std::vector<Box> queries;
+        for (int q = 0; q < queriesPerFrame; ++q) {
+            double qx = posDist(rng), qy = posDist(rng);
+            queries.push_back({qx, qy, qx + 100, qy + 100});
+        }
+        gridQueryMs += bench::timeMs([&] {
+            for (const Box& query : queries) {
+                grid.queryRange(query, [&gridHits](Shape&) { ++gridHits; });
+                gridHits += grid.nearest(query.minX, query.minY) != nullptr;
+            }
+        });
+        scanQueryMs += bench::timeMs([&] {
+            for (const Box& query : queries) {
+                scanHits += scanRange(shapes, query).size();
+                scanHits += std::isfinite(scanNearestDistance(shapes, query.minX, query.minY));
+            }
+        });
+    }
+
+    std::cout << "  " << shapeCount << " shapes, " << frames << " frames of " << movesPerFrame
+              << " moves + " << queriesPerFrame << " range and nearest queries" << std::endl;
+    std::cout << "  Initial build:            " << buildMs << " ms (a rebuild per frame would cost this)" << std::endl;
+    std::cout << "  Incremental moves/frame:  " << moveMs / frames << " ms" << std::endl;
+    std::cout << "  Grid queries/frame:       " << gridQueryMs / frames << " ms" << std::endl;
+    std::cout << "  Linear scan queries/frame: " << scanQueryMs / frames << " ms (x"
+              << scanQueryMs / gridQueryMs << ")" << std::endl;
+    std::cout << "  Hit counts match: " << (gridHits == scanHits ? "Yes" : "No") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Spatial Grid Index ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateSpatialGrid();
+
+    std::size_t shapeCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int movesPerFrame = argc > 2 ? std::atoi(argv[2]) : 5000;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 10;
+
+    std::cout << "4. Benchmark:" << std::endl;
+    benchmarkSpatialGrid(shapeCount, movesPerFrame, frames);
+    std::cout << std::endl;
+
+    std::cout << "=== End of Spatial Grid Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <chrono>
+#include <new>
+#include "bench.h"
+
+/**
+ * Move Semantics and std::vector Growth
+ *
+ * This example demonstrates:
+ * - How a user-written copy constructor and destructor suppress the
+ *   implicit move operations (the "rule of five")
+ * - Why std::vector copies elements on regrowth unless the move
+ *   constructor is noexcept (std::move_if_noexcept)
+ * - Instrumenting a class to count copies, moves and heap allocations
+ * - A benchmark: bulk loading students before and after adding moves
+ *
+ * Usage: ./perf_student_moves [studentCount]   (default: 1000000)
+ */
+
+// ---------------------------------------------------------------------------
+// Instrumentation
+// ---------------------------------------------------------------------------
+
+static std::size_t heapAllocations = 0;
+
+void* operator new(std::size_t size) {
+    ++heapAllocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+struct LifecycleStats {
+    std::size_t copies = 0;
+    std::size_t moves = 0;
+    std::size_t allocations = 0;
+};
+
+static LifecycleStats currentStats;
+
+// Measures what a block of code costs in copies, moves and allocations
+template <typename Func>
+LifecycleStats measure(Func&& func) {
+    currentStats = {};
+    std::size_t allocationsBefore = heapAllocations;
+    func();
+    currentStats.allocations = heapAllocations - allocationsBefore;
+    return currentStats;
+}
+
+// ---------------------------------------------------------------------------
+// Student before: copy constructor + destructor, no move operations
+// (the shape of Student in src/oop/classes.cpp before moves were added)
+// ---------------------------------------------------------------------------
+
+class CopyOnlyStudent {
+private:
+    std::string name;
+    int age;
+    std::vector<double> grades;
+
+public:
+    CopyOnlyStudent(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+
+    CopyOnlyStudent(const CopyOnlyStudent& other) : name(other.name), age(other.age), grades(other.grades) {
+        ++currentStats.copies;
+    }
+
+    // Declaring a destructor (like classes.cpp does) means no implicit moves
+    ~CopyOnlyStudent() {}
+
+    void addGrade(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            grades.push_back(grade);
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Student after: full rule of five with noexcept moves
+// ---------------------------------------------------------------------------
+
+class MovableStudent {
+private:
+    std::string name;
+    int age;
+    std::vector<double> grades;
+
+public:
+    MovableStudent(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+
+    MovableStudent(const MovableStudent& other) : name(other.name), age(other.age), grades(other.grades) {
+        ++currentStats.copies;
+    }
+
+    MovableStudent(MovableStudent&& other) noexcept
+        : name(std::move(other.name)), age(other.age), grades(std::move(other.grades)) {
+        ++currentStats.moves;
+    }
+
+    MovableStudent& operator=(const MovableStudent& other) {
+        ++currentStats.copies;
+        name = other.name;
+        age = other.age;
+        grades = other.grades;
+        return *this;
+    }
+
+    MovableStudent& operator=(MovableStudent&& other) noexcept {
+        ++currentStats.moves;
+        name = std::move(other.name);
+        age = other.age;
+        grades = std::move(other.grades);
+        return *this;
+    }
+
+    ~MovableStudent() {}
+
+    void addGrade(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            grades.push_back(grade);
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Demonstration and benchmark
+// ---------------------------------------------------------------------------
+
+void printStats(const std::string& label, const LifecycleStats& stats, std::size_t operations = 1) {
+    double ops = static_cast<double>(operations);
+    std::cout << "  " << std::left << std::setw(34) << label << std::right
+              << " copies " << std::setw(8) << stats.copies / ops
+              << "  moves " << std::setw(8) << stats.moves / ops
+              << "  allocations " << std::setw(8) << stats.allocations / ops << std::endl;
+}
+
+// A name that does not fit in the small-string buffer, so copying it allocates
+const std::string longName = "Student with a fairly long name";
+
+template <typename StudentType>
+StudentType makeStudent() {
+    StudentType student(longName, 20);
+    student.addGrade(85.5);
+    student.addGrade(92.0);
+    return student;
+}
+
+void demonstrateMoves() {
+    std::cout << "1. Cost of single operations (per call):" << std::endl;
+    {
+        std::vector<CopyOnlyStudent> students;
+        students.reserve(4);
+        printStats("copy-only push_back(temporary)",
+                   measure([&] { students.push_back(makeStudent<CopyOnlyStudent>()); }));
+    }
+    {
+        std::vector<MovableStudent> students;
+        students.reserve(4);
+        printStats("movable push_back(temporary)",
+                   measure([&] { students.push_back(makeStudent<MovableStudent>()); }));
+        printStats("movable emplace_back(args)",
+                   measure([&] { students.emplace_back(longName, 20); }));
+        MovableStudent a = makeStudent<MovableStudent>();
+        MovableStudent b = makeStudent<MovableStudent>();
+        printStats("movable copy assignment", measure([&] { b = a; }));
+        printStats("movable move assignment", measure([&] { b = std::move(a); }));
+    }
+    std::cout << std::endl;
+}
+
+template <typename StudentType>
+void bulkLoad(const std::string& label, std::size_t count) {
+    std::vector<StudentType> students;
+    double ms = 0;
+    LifecycleStats stats = measure([&] {
+        ms = bench::timeMs([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                StudentType student(longName, 20);
+                student.addGrade(90.0);
+                students.push_back(std::move(student));  // Falls back to a copy without a move constructor
+            }
+        });
+    });
+    std::cout << "  " << std::left << std::setw(12) << label << std::right << std::setw(10) << ms
+              << " ms" << std::endl;
+    printStats("  per inserted student:", stats, count);
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Move Semantics for Student ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateMoves();
+
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::cout << "2. Bulk loading " << count << " students into a std::vector (no reserve):" << std::endl;
+    bulkLoad<CopyOnlyStudent>("Copy-only:", count);
+    bulkLoad<MovableStudent>("Movable:", count);
+    std::cout << std::endl;
+
+    std::cout << "=== End of Student Moves Example ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <new>
+#include "small_vector.h"
+#include "perf_counters.h"
+#include "bench.h"
+
+/**
+ * Small-Buffer Optimization for Student Grades
+ *
+ * This example demonstrates:
+ * - SmallVector<T, N> from small_vector.h (used by Student in classes.cpp)
+ * - Inline storage: the first N elements live inside the object
+ * - Spilling to the heap only when a list grows past N
+ * - Correct copy and move behaviour for both inline and heap storage
+ * - A benchmark for 1M students: heap allocations, time and cache misses
+ *
+ * Usage: ./perf_student_small_vector [studentCount]   (default: 1000000)
+ */
+
+static std::size_t heapAllocations = 0;
+
+void* operator new(std::size_t size) {
+    ++heapAllocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+// Student from classes.cpp (without logging), generic over the grade container
+template <typename GradeList>
+class BasicStudent {
+private:
+    std::string name;
+    int age;
+    GradeList grades;
+
+public:
+    BasicStudent(const std::string& studentName, int studentAge) : name(studentName), age(studentAge) {}
+
+    void addGrade(double grade) {
+        if (grade >= 0.0 && grade <= 100.0) {
+            grades.push_back(grade);
+        }
+    }
+
+    double getAverageGrade() const {
+        if (grades.empty()) {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (double grade : grades) {
+            sum += grade;
+        }
+        return sum / grades.size();
+    }
+};
+
+using VectorStudent = BasicStudent<std::vector<double>>;
+using SmallStudent = BasicStudent<SmallVector<double, 8>>;
+
+void demonstrateSmallVector() {
+    std::cout << "1. Inline storage until the ninth element:" << std::endl;
+    SmallVector<double, 8> grades;
+    std::size_t before = heapAllocations;
+    for (int i = 1; i <= 8; ++i) {
+        grades.push_back(80.0 + i);
+    }
+    std::cout << "  8 grades: inline " << (grades.isSmall() ? "Yes" : "No") << ", heap allocations "
+              << heapAllocations - before << std::endl;
+    grades.push_back(99.0);
+    std::cout << "  9 grades: inline " << (grades.isSmall() ? "Yes" : "No") << ", heap allocations "
+              << heapAllocations - before << ", capacity " << grades.capacity() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "2. Copy and move:" << std::endl;
+    SmallVector<double, 8> copy = grades;
+    SmallVector<double, 8> moved = std::move(grades);
+    std::cout << "  Copy equals original: " << (copy == moved ? "Yes" : "No") << std::endl;
+    std::cout << "  Moved-from vector is empty and inline again: "
+              << (grades.empty() && grades.isSmall() ? "Yes" : "No") << std::endl;
+
+    SmallVector<std::string, 2> names = {"Alice", "Bob"};
+    SmallVector<std::string, 2> otherNames;
+    otherNames = std::move(names);
+    otherNames.emplace_back("Charlie");
+    std::cout << "  Strings:";
+    for (const std::string& name : otherNames) {
+        std::cout << " " << name;
+    }
+    std::cout << std::endl;
+    std::cout << std::endl;
+}
+
+template <typename StudentType>
+void benchmarkStudents(const std::string& label, std::size_t count, const std::vector<int>& gradeCounts) {
+    std::vector<StudentType> students;
+    students.reserve(count);
+
+    std::size_t before = heapAllocations;
+    double buildMs = bench::timeMs([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            students.emplace_back("s", 20);
+            for (int g = 0; g < gradeCounts[i]; ++g) {
+                students.back().addGrade(50.0 + g);
+            }
+        }
+    });
+    std::size_t allocations = heapAllocations - before;
+
+    HardwareCounters counters;
+    double checksum = 0;
+    counters.start();
+    double averageMs = bench::timeMs([&] {
+        for (const StudentType& student : students) {
+            checksum += student.getAverageGrade();
+        }
+    });
+    CounterValues values = counters.stop();
+
+    std::cout << "  " << std::left << std::setw(24) << label << std::right
+              << " sizeof " << std::setw(3) << sizeof(StudentType)
+              << "  build " << std::setw(8) << buildMs << " ms"
+              << "  allocations " << std::setw(8) << allocations
+              << "  averages " << std::setw(8) << averageMs << " ms";
+    if (values.has(CounterKind::CacheMisses)) {
+        std::cout << "  cache misses " << values[CounterKind::CacheMisses];
+    } else {
+        std::cout << "  cache misses n/a";
+    }
+    std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Small-Buffer Optimized Grades ===" << std::endl;
+    std::cout << std::endl;
+
+    demonstrateSmallVector();
+
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    // Most students have fewer than eight grades, a few have many more
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> smallCount(1, 7);
+    std::uniform_int_distribution<int> largeCount(9, 30);
+    std::bernoulli_distribution isLarge(0.05);
+    std::vector<int> gradeCounts(count);
+    for (int& gradeCount : gradeCounts) {
+        gradeCount = isLarge(rng) ? largeCount(rng) : smallCount(rng);
+    }
+
+    std::cout << "3. Benchmark with " << count << " students (95% have 1-7 grades):" << std::endl;
+    benchmarkStudents<VectorStudent>("std::vector<double>", count, gradeCounts);
+    benchmarkStudents<SmallStudent>("SmallVector<double, 8>", count, gradeCounts);
+    if (!HardwareCounters().available()) {
+        std::cout << "  (Hardware counters unavailable here; see /proc/sys/kernel/perf_event_paranoid)"
+                  << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "=== End of Small Vector Example ===" << std::endl;
+
+    return 0;
+}
@@ -1,4 +1,3 @@
-#include <iostream>
 #include <vector>
 #include <algorithm>
 #include <numeric>
@@ -6,6 +5,7 @@
 #include <string>
 #include <random>
 #include <iterator>
+#include "../performance/output_sink.h"
 
 /**
  * STL Algorithms in C++
@@ -21,30 +21,30 @@
  */
 
 void demonstrateNonModifyingAlgorithms() {
-    std::cout << "=== NON-MODIFYING ALGORITHMS ===" << std::endl;
+    console() << "=== NON-MODIFYING ALGORITHMS ===" << '\n';
     
     std::vector<int> numbers = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     
     // Find
     auto it = std::find(numbers.begin(), numbers.end(), 5);
     if (it != numbers.end()) {
-        std::cout << "  Found 5 at position: " << std::distance(numbers.begin(), it) << std::endl;
+        console() << "  Found 5 at position: " << std::distance(numbers.begin(), it) << '\n';
     }
     
     // Count
     int count = std::count(numbers.begin(), numbers.end(), 3);
-    std::cout << "  Count of 3: " << count << std::endl;
+    console() << "  Count of 3: " << count << '\n';
     
     // Count if
     int evenCount = std::count_if(numbers.begin(), numbers.end(), 
                                  [](int n) { return n % 2 == 0; });
-    std::cout << "  Count of even numbers: " << evenCount << std::endl;
+    console() << "  Count of even numbers: " << evenCount << '\n';
     
     // For each
-    std::cout << "  Doubled numbers: ";
+    console() << "  Doubled numbers: ";
     std::for_each(numbers.begin(), numbers.end(), 
-                  [](int n) { std::cout << n * 2 << " "; });
-    std::cout << std::endl;
+                  [](int n) { console() << n * 2 << " "; });
+    console() << '\n';
     
     // All of, any of, none of
     bool allPositive = std::all_of(numbers.begin(), numbers.end(), 
@@ -54,14 +54,14 @@ void demonstrateNonModifyingAlgorithms() {
     bool noneNegative = std::none_of(numbers.begin(), numbers.end(), 
                                     [](int n) { return n < 0; });
     
-    std::cout << "  All positive: " << (allPositive ? "Yes" : "No") << std::endl;
-    std::cout << "  Any > 5: " << (anyGreaterThan5 ? "Yes" : "No") << std::endl;
-    std::cout << "  None negative: " << (noneNegative ? "Yes" : "No") << std::endl;
-    std::cout << std::endl;
+    console() << "  All positive: " << (allPositive ? "Yes" : "No") << '\n';
+    console() << "  Any > 5: " << (anyGreaterThan5 ? "Yes" : "No") << '\n';
+    console() << "  None negative: " << (noneNegative ? "Yes" : "No") << '\n';
+    console() << '\n';
 }
 
 void demonstrateModifyingAlgorithms() {
-    std::cout << "=== MODIFYING ALGORITHMS ===" << std::endl;
+    console() << "=== MODIFYING ALGORITHMS ===" << '\n';
     
     std::vector<int> numbers = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     
@@ -70,50 +70,50 @@ void demonstrateModifyingAlgorithms() {
     std::transform(numbers.begin(), numbers.end(), std::back_inserter(doubled),
                   [](int n) { return n * 2; });
     
-    std::cout << "  Original: ";
-    for (int n : numbers) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Original: ";
+    for (int n : numbers) console() << n << " ";
+    console() << '\n';
     
-    std::cout << "  Doubled: ";
-    for (int n : doubled) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Doubled: ";
+    for (int n : doubled) console() << n << " ";
+    console() << '\n';
     
     // Replace
     std::vector<int> replaceTest = {1, 2, 3, 2, 4, 2, 5};
     std::replace(replaceTest.begin(), replaceTest.end(), 2, 99);
     
-    std::cout << "  After replacing 2 with 99: ";
-    for (int n : replaceTest) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  After replacing 2 with 99: ";
+    for (int n : replaceTest) console() << n << " ";
+    console() << '\n';
     
     // Replace if
     std::vector<int> replaceIfTest = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     std::replace_if(replaceIfTest.begin(), replaceIfTest.end(),
                    [](int n) { return n % 2 == 0; }, 0);
     
-    std::cout << "  After replacing even numbers with 0: ";
-    for (int n : replaceIfTest) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  After replacing even numbers with 0: ";
+    for (int n : replaceIfTest) console() << n << " ";
+    console() << '\n';
     
     // Reverse
     std::vector<int> reverseTest = {1, 2, 3, 4, 5};
     std::reverse(reverseTest.begin(), reverseTest.end());
     
-    std::cout << "  Reversed: ";
-    for (int n : reverseTest) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Reversed: ";
+    for (int n : reverseTest) console() << n << " ";
+    console() << '\n';
     
     // Rotate
     std::vector<int> rotateTest = {1, 2, 3, 4, 5};
     std::rotate(rotateTest.begin(), rotateTest.begin() + 2, rotateTest.end());
     
-    std::cout << "  Rotated left by 2: ";
-    for (int n : rotateTest) std::cout << n << " ";
-    std::cout << std::endl << std::endl;
+    console() << "  Rotated left by 2: ";
+    for (int n : rotateTest) console() << n << " ";
+    console() << '\n' << '\n';
 }
 
 void demonstrateSortingAlgorithms() {
-    std::cout << "=== SORTING ALGORITHMS ===" << std::endl;
+    console() << "=== SORTING ALGORITHMS ===" << '\n';
     
     std::vector<int> numbers = {64, 34, 25, 12, 22, 11, 90};
     
@@ -121,64 +121,64 @@ void demonstrateSortingAlgorithms() {
     std::vector<int> sortedNumbers = numbers;
     std::sort(sortedNumbers.begin(), sortedNumbers.end());
     
-    std::cout << "  Original: ";
-    for (int n : numbers) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Original: ";
+    for (int n : numbers) console() << n << " ";
+    console() << '\n';
     
-    std::cout << "  Sorted: ";
-    for (int n : sortedNumbers) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Sorted: ";
+    for (int n : sortedNumbers) console() << n << " ";
+    console() << '\n';
     
     // Sort with custom comparator
     std::vector<int> customSort = numbers;
     std::sort(customSort.begin(), customSort.end(), std::greater<int>());
     
-    std::cout << "  Sorted (descending): ";
-    for (int n : customSort) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Sorted (descending): ";
+    for (int n : customSort) console() << n << " ";
+    console() << '\n';
     
     // Partial sort
     std::vector<int> partialSort = numbers;
     std::partial_sort(partialSort.begin(), partialSort.begin() + 3, partialSort.end());
     
-    std::cout << "  Partial sort (first 3): ";
-    for (int n : partialSort) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Partial sort (first 3): ";
+    for (int n : partialSort) console() << n << " ";
+    console() << '\n';
     
     // Nth element
     std::vector<int> nthElement = numbers;
     std::nth_element(nthElement.begin(), nthElement.begin() + 2, nthElement.end());
     
-    std::cout << "  Nth element (3rd smallest): " << nthElement[2] << std::endl;
-    std::cout << std::endl;
+    console() << "  Nth element (3rd smallest): " << nthElement[2] << '\n';
+    console() << '\n';
 }
 
 void demonstrateBinarySearchAlgorithms() {
-    std::cout << "=== BINARY SEARCH ALGORITHMS ===" << std::endl;
+    console() << "=== BINARY SEARCH ALGORITHMS ===" << '\n';
     
     std::vector<int> numbers = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     
     // Binary search
     bool found = std::binary_search(numbers.begin(), numbers.end(), 5);
-    std::cout << "  Binary search for 5: " << (found ? "Found" : "Not found") << std::endl;
+    console() << "  Binary search for 5: " << (found ? "Found" : "Not found") << '\n';
     
     // Lower bound
     auto lower = std::lower_bound(numbers.begin(), numbers.end(), 5);
-    std::cout << "  Lower bound for 5: position " << std::distance(numbers.begin(), lower) << std::endl;
+    console() << "  Lower bound for 5: position " << std::distance(numbers.begin(), lower) << '\n';
     
     // Upper bound
     auto upper = std::upper_bound(numbers.begin(), numbers.end(), 5);
-    std::cout << "  Upper bound for 5: position " << std::distance(numbers.begin(), upper) << std::endl;
+    console() << "  Upper bound for 5: position " << std::distance(numbers.begin(), upper) << '\n';
     
     // Equal range
     auto range = std::equal_range(numbers.begin(), numbers.end(), 5);
-    std::cout << "  Equal range for 5: [" << std::distance(numbers.begin(), range.first) 
-              << ", " << std::distance(numbers.begin(), range.second) << ")" << std::endl;
-    std::cout << std::endl;
+    console() << "  Equal range for 5: [" << std::distance(numbers.begin(), range.first) 
+              << ", " << std::distance(numbers.begin(), range.second) << ")" << '\n';
+    console() << '\n';
 }
 
 void demonstrateSetAlgorithms() {
-    std::cout << "=== SET ALGORITHMS ===" << std::endl;
+    console() << "=== SET ALGORITHMS ===" << '\n';
     
     std::vector<int> set1 = {1, 2, 3, 4, 5};
     std::vector<int> set2 = {3, 4, 5, 6, 7};
@@ -188,125 +188,125 @@ void demonstrateSetAlgorithms() {
     std::set_union(set1.begin(), set1.end(), set2.begin(), set2.end(),
                    std::back_inserter(result));
     
-    std::cout << "  Set 1: ";
-    for (int n : set1) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Set 1: ";
+    for (int n : set1) console() << n << " ";
+    console() << '\n';
     
-    std::cout << "  Set 2: ";
-    for (int n : set2) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Set 2: ";
+    for (int n : set2) console() << n << " ";
+    console() << '\n';
     
-    std::cout << "  Union: ";
-    for (int n : result) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Union: ";
+    for (int n : result) console() << n << " ";
+    console() << '\n';
     
     // Set intersection
     result.clear();
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(),
                          std::back_inserter(result));
     
-    std::cout << "  Intersection: ";
-    for (int n : result) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Intersection: ";
+    for (int n : result) console() << n << " ";
+    console() << '\n';
     
     // Set difference
     result.clear();
     std::set_difference(set1.begin(), set1.end(), set2.begin(), set2.end(),
                        std::back_inserter(result));
     
-    std::cout << "  Difference (set1 - set2): ";
-    for (int n : result) std::cout << n << " ";
-    std::cout << std::endl;
-    std::cout << std::endl;
+    console() << "  Difference (set1 - set2): ";
+    for (int n : result) console() << n << " ";
+    console() << '\n';
+    console() << '\n';
 }
 
 void demonstrateHeapAlgorithms() {
-    std::cout << "=== HEAP ALGORITHMS ===" << std::endl;
+    console() << "=== HEAP ALGORITHMS ===" << '\n';
     
     std::vector<int> numbers = {3, 1, 4, 1, 5, 9, 2, 6};
     
     // Make heap
     std::make_heap(numbers.begin(), numbers.end());
     
-    std::cout << "  After make_heap: ";
-    for (int n : numbers) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  After make_heap: ";
+    for (int n : numbers) console() << n << " ";
+    console() << '\n';
     
     // Push heap
     numbers.push_back(8);
     std::push_heap(numbers.begin(), numbers.end());
     
-    std::cout << "  After push_heap(8): ";
-    for (int n : numbers) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  After push_heap(8): ";
+    for (int n : numbers) console() << n << " ";
+    console() << '\n';
     
     // Pop heap
     std::pop_heap(numbers.begin(), numbers.end());
     int maxElement = numbers.back();
     numbers.pop_back();
     
-    std::cout << "  Popped element: " << maxElement << std::endl;
-    std::cout << "  After pop_heap: ";
-    for (int n : numbers) std::cout << n << " ";
-    std::cout << std::endl;
-    std::cout << std::endl;
+    console() << "  Popped element: " << maxElement << '\n';
+    console() << "  After pop_heap: ";
+    for (int n : numbers) console() << n << " ";
+    console() << '\n';
+    console() << '\n';
 }
 
 void demonstrateNumericAlgorithms() {
-    std::cout << "=== NUMERIC ALGORITHMS ===" << std::endl;
+    console() << "=== NUMERIC ALGORITHMS ===" << '\n';
     
     std::vector<int> numbers = {1, 2, 3, 4, 5};
     
     // Accumulate
     int sum = std::accumulate(numbers.begin(), numbers.end(), 0);
-    std::cout << "  Sum: " << sum << std::endl;
+    console() << "  Sum: " << sum << '\n';
     
     int product = std::accumulate(numbers.begin(), numbers.end(), 1, std::multiplies<int>());
-    std::cout << "  Product: " << product << std::endl;
+    console() << "  Product: " << product << '\n';
     
     // Partial sum
     std::vector<int> partialSums;
     std::partial_sum(numbers.begin(), numbers.end(), std::back_inserter(partialSums));
     
-    std::cout << "  Partial sums: ";
-    for (int n : partialSums) std::cout << n << " ";
-    std::cout << std::endl;
+    console() << "  Partial sums: ";
+    for (int n : partialSums) console() << n << " ";
+    console() << '\n';
     
     // Inner product
     std::vector<int> vec1 = {1, 2, 3};
     std::vector<int> vec2 = {4, 5, 6};
     int dotProduct = std::inner_product(vec1.begin(), vec1.end(), vec2.begin(), 0);
     
-    std::cout << "  Dot product: " << dotProduct << std::endl;
+    console() << "  Dot product: " << dotProduct << '\n';
     
     // Adjacent difference
     std::vector<int> differences;
     std::adjacent_difference(numbers.begin(), numbers.end(), std::back_inserter(differences));
     
-    std::cout << "  Adjacent differences: ";
-    for (int n : differences) std::cout << n << " ";
-    std::cout << std::endl;
-    std::cout << std::endl;
+    console() << "  Adjacent differences: ";
+    for (int n : differences) console() << n << " ";
+    console() << '\n';
+    console() << '\n';
 }
 
 void demonstratePermutationAlgorithms() {
-    std::cout << "=== PERMUTATION ALGORITHMS ===" << std::endl;
+    console() << "=== PERMUTATION ALGORITHMS ===" << '\n';
     
     std::vector<int> numbers = {1, 2, 3};
     
-    std::cout << "  All permutations of {1, 2, 3}:" << std::endl;
+    console() << "  All permutations of {1, 2, 3}:" << '\n';
     do {
-        std::cout << "    ";
-        for (int n : numbers) std::cout << n << " ";
-        std::cout << std::endl;
+        console() << "    ";
+        for (int n : numbers) console() << n << " ";
+        console() << '\n';
     } while (std::next_permutation(numbers.begin(), numbers.end()));
     
-    std::cout << std::endl;
+    console() << '\n';
 }
 
 int main() {
-    std::cout << "=== STL Algorithms ===" << std::endl;
-    std::cout << std::endl;
+    console() << "=== STL Algorithms ===" << '\n';
+    console() << '\n';
     
     demonstrateNonModifyingAlgorithms();
     demonstrateModifyingAlgorithms();
@@ -317,7 +317,8 @@ int main() {
     demonstrateNumericAlgorithms();
     demonstratePermutationAlgorithms();
     
-    std::cout << "=== End of STL Algorithms Example ===" << std::endl;
+    console() << "=== End of STL Algorithms Example ===" << '\n';
     
+    console().flush();
     return 0;
 }
@@ -1,4 +1,3 @@
-#include <iostream>
 #include <vector>
 #include <list>
 #include <deque>
@@ -10,6 +9,7 @@
 #include <queue>
 #include <array>
 #include <string>
+#include "../performance/output_sink.h"
 
 /**
  * STL Containers in C++
@@ -22,7 +22,7 @@
  */
 
 void demonstrateVector() {
-    std::cout << "=== VECTOR ===" << std::endl;
+    console() << "=== VECTOR ===" << '\n';
     
     // Creating and initializing vector
     std::vector<int> numbers = {1, 2, 3, 4, 5};
@@ -33,27 +33,27 @@ void demonstrateVector() {
     numbers.insert(numbers.begin() + 2, 10);  // Insert at position 2
     
     // Accessing elements
-    std::cout << "  First element: " << numbers[0] << std::endl;
-    std::cout << "  Last element: " << numbers.back() << std::endl;
-    std::cout << "  Size: " << numbers.size() << std::endl;
+    console() << "  First element: " << numbers[0] << '\n';
+    console() << "  Last element: " << numbers.back() << '\n';
+    console() << "  Size: " << numbers.size() << '\n';
     
     // Iterating through vector
-    std::cout << "  All elements: ";
+    console() << "  All elements: ";
     for (int num : numbers) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Using iterators
-    std::cout << "  Using iterators: ";
+    console() << "  Using iterators: ";
     for (auto it = numbers.begin(); it != numbers.end(); ++it) {
-        std::cout << *it << " ";
+        console() << *it << " ";
     }
-    std::cout << std::endl << std::endl;
+    console() << '\n' << '\n';
 }
 
 void demonstrateList() {
-    std::cout << "=== LIST ===" << std::endl;
+    console() << "=== LIST ===" << '\n';
     
     std::list<int> myList = {1, 2, 3, 4, 5};
     
@@ -62,25 +62,25 @@ void demonstrateList() {
     myList.push_back(6);       // Add to back
     myList.insert(++myList.begin(), 10);  // Insert after first element
     
-    std::cout << "  List elements: ";
+    console() << "  List elements: ";
     for (int num : myList) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Remove elements
     myList.remove(3);          // Remove all occurrences of 3
     myList.pop_front();        // Remove first element
     
-    std::cout << "  After removal: ";
+    console() << "  After removal: ";
     for (int num : myList) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl << std::endl;
+    console() << '\n' << '\n';
 }
 
 void demonstrateDeque() {
-    std::cout << "=== DEQUE ===" << std::endl;
+    console() << "=== DEQUE ===" << '\n';
     
     std::deque<int> myDeque = {1, 2, 3};
     
@@ -88,18 +88,18 @@ void demonstrateDeque() {
     myDeque.push_front(0);
     myDeque.push_back(4);
     
-    std::cout << "  Deque elements: ";
+    console() << "  Deque elements: ";
     for (int num : myDeque) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl;
+    console() << '\n';
     
-    std::cout << "  Front: " << myDeque.front() << std::endl;
-    std::cout << "  Back: " << myDeque.back() << std::endl << std::endl;
+    console() << "  Front: " << myDeque.front() << '\n';
+    console() << "  Back: " << myDeque.back() << '\n' << '\n';
 }
 
 void demonstrateSet() {
-    std::cout << "=== SET ===" << std::endl;
+    console() << "=== SET ===" << '\n';
     
     std::set<int> mySet = {5, 2, 8, 1, 9};
     
@@ -107,26 +107,26 @@ void demonstrateSet() {
     mySet.insert(3);
     mySet.insert(5);  // Duplicate, won't be added
     
-    std::cout << "  Set elements (sorted): ";
+    console() << "  Set elements (sorted): ";
     for (int num : mySet) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Set operations
-    std::cout << "  Contains 5: " << (mySet.count(5) ? "Yes" : "No") << std::endl;
-    std::cout << "  Contains 10: " << (mySet.count(10) ? "Yes" : "No") << std::endl;
+    console() << "  Contains 5: " << (mySet.count(5) ? "Yes" : "No") << '\n';
+    console() << "  Contains 10: " << (mySet.count(10) ? "Yes" : "No") << '\n';
     
     mySet.erase(5);
-    std::cout << "  After removing 5: ";
+    console() << "  After removing 5: ";
     for (int num : mySet) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl << std::endl;
+    console() << '\n' << '\n';
 }
 
 void demonstrateMap() {
-    std::cout << "=== MAP ===" << std::endl;
+    console() << "=== MAP ===" << '\n';
     
     std::map<std::string, int> ages;
     
@@ -137,36 +137,36 @@ void demonstrateMap() {
     ages.insert({"David", 28});
     
     // Accessing values
-    std::cout << "  Alice's age: " << ages["Alice"] << std::endl;
-    std::cout << "  Bob's age: " << ages.at("Bob") << std::endl;
+    console() << "  Alice's age: " << ages["Alice"] << '\n';
+    console() << "  Bob's age: " << ages.at("Bob") << '\n';
     
     // Iterating through map
-    std::cout << "  All ages:" << std::endl;
+    console() << "  All ages:" << '\n';
     for (const auto& pair : ages) {
-        std::cout << "    " << pair.first << ": " << pair.second << std::endl;
+        console() << "    " << pair.first << ": " << pair.second << '\n';
     }
     
     // Check if key exists
     if (ages.find("Eve") != ages.end()) {
-        std::cout << "  Eve's age: " << ages["Eve"] << std::endl;
+        console() << "  Eve's age: " << ages["Eve"] << '\n';
     } else {
-        std::cout << "  Eve not found in map" << std::endl;
+        console() << "  Eve not found in map" << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
 }
 
 void demonstrateUnorderedContainers() {
-    std::cout << "=== UNORDERED CONTAINERS ===" << std::endl;
+    console() << "=== UNORDERED CONTAINERS ===" << '\n';
     
     // Unordered set (hash set)
     std::unordered_set<std::string> fruits = {"apple", "banana", "orange"};
     fruits.insert("grape");
     
-    std::cout << "  Unordered set fruits: ";
+    console() << "  Unordered set fruits: ";
     for (const auto& fruit : fruits) {
-        std::cout << fruit << " ";
+        console() << fruit << " ";
     }
-    std::cout << std::endl;
+    console() << '\n';
     
     // Unordered map (hash map)
     std::unordered_map<std::string, double> prices;
@@ -174,15 +174,15 @@ void demonstrateUnorderedContainers() {
     prices["banana"] = 0.80;
     prices["orange"] = 2.00;
     
-    std::cout << "  Unordered map prices:" << std::endl;
+    console() << "  Unordered map prices:" << '\n';
     for (const auto& pair : prices) {
-        std::cout << "    " << pair.first << ": $" << pair.second << std::endl;
+        console() << "    " << pair.first << ": $" << pair.second << '\n';
     }
-    std::cout << std::endl;
+    console() << '\n';
 }
 
 void demonstrateStack() {
-    std::cout << "=== STACK ===" << std::endl;
+    console() << "=== STACK ===" << '\n';
     
     std::stack<int> myStack;
     
@@ -191,20 +191,20 @@ void demonstrateStack() {
     myStack.push(20);
     myStack.push(30);
     
-    std::cout << "  Stack operations:" << std::endl;
-    std::cout << "    Top element: " << myStack.top() << std::endl;
-    std::cout << "    Stack size: " << myStack.size() << std::endl;
+    console() << "  Stack operations:" << '\n';
+    console() << "    Top element: " << myStack.top() << '\n';
+    console() << "    Stack size: " << myStack.size() << '\n';
     
     // Pop elements
     while (!myStack.empty()) {
-        std::cout << "    Popping: " << myStack.top() << std::endl;
+        console() << "    Popping: " << myStack.top() << '\n';
         myStack.pop();
     }
-    std::cout << std::endl;
+    console() << '\n';
 }
 
 void demonstrateQueue() {
-    std::cout << "=== QUEUE ===" << std::endl;
+    console() << "=== QUEUE ===" << '\n';
     
     std::queue<std::string> myQueue;
     
@@ -213,20 +213,20 @@ void demonstrateQueue() {
     myQueue.push("Second");
     myQueue.push("Third");
     
-    std::cout << "  Queue operations:" << std::endl;
-    std::cout << "    Front element: " << myQueue.front() << std::endl;
-    std::cout << "    Back element: " << myQueue.back() << std::endl;
+    console() << "  Queue operations:" << '\n';
+    console() << "    Front element: " << myQueue.front() << '\n';
+    console() << "    Back element: " << myQueue.back() << '\n';
     
     // Dequeue elements
     while (!myQueue.empty()) {
-        std::cout << "    Processing: " << myQueue.front() << std::endl;
+        console() << "    Processing: " << myQueue.front() << '\n';
         myQueue.pop();
     }
-    std::cout << std::endl;
+    console() << '\n';
 }
 
 void demonstratePriorityQueue() {
-    std::cout << "=== PRIORITY QUEUE ===" << std::endl;
+    console() << "=== PRIORITY QUEUE ===" << '\n';
     
     std::priority_queue<int> maxHeap;  // Default is max heap
     
@@ -236,9 +236,9 @@ void demonstratePriorityQueue() {
     maxHeap.push(50);
     maxHeap.push(20);
     
-    std::cout << "  Max heap (priority queue):" << std::endl;
+    console() << "  Max heap (priority queue):" << '\n';
     while (!maxHeap.empty()) {
-        std::cout << "    Highest priority: " << maxHeap.top() << std::endl;
+        console() << "    Highest priority: " << maxHeap.top() << '\n';
         maxHeap.pop();
     }
     
@@ -249,35 +249,35 @@ void demonstratePriorityQueue() {
     minHeap.push(50);
     minHeap.push(20);
     
-    std::cout << "  Min heap:" << std::endl;
+    console() << "  Min heap:" << '\n';
     while (!minHeap.empty()) {
-        std::cout << "    Lowest priority: " << minHeap.top() << std::endl;
+        console() << "    Lowest priority: " << minHeap.top() << '\n';
         minHeap.pop();
     }
-    std::cout << std::endl;
+    console() << '\n';
 }
 
 void demonstrateArray() {
-    std::cout << "=== ARRAY ===" << std::endl;
+    console() << "=== ARRAY ===" << '\n';
     
     std::array<int, 5> myArray = {1, 2, 3, 4, 5};
     
-    std::cout << "  Array elements: ";
+    console() << "  Array elements: ";
     for (int num : myArray) {
-        std::cout << num << " ";
+        console() << num << " ";
     }
-    std::cout << std::endl;
+    console() << '\n';
     
-    std::cout << "  Array size: " << myArray.size() << std::endl;
-    std::cout << "  First element: " << myArray.front() << std::endl;
-    std::cout << "  Last element: " << myArray.back() << std::endl;
-    std::cout << "  Element at index 2: " << myArray[2] << std::endl;
-    std::cout << std::endl;
+    console() << "  Array size: " << myArray.size() << '\n';
+    console() << "  First element: " << myArray.front() << '\n';
+    console() << "  Last element: " << myArray.back() << '\n';
+    console() << "  Element at index 2: " << myArray[2] << '\n';
+    console() << '\n';
 }
 
 int main() {
-    std::cout << "=== STL Containers ===" << std::endl;
-    std::cout << std::endl;
+    console() << "=== STL Containers ===" << '\n';
+    console() << '\n';
     
     demonstrateVector();
     demonstrateList();
@@ -290,7 +290,8 @@ int main() {
     demonstratePriorityQueue();
     demonstrateArray();
     
-    std::cout << "=== End of STL Containers Example ===" << std::endl;
+    console() << "=== End of STL Containers Example ===" << '\n';
     
+    console().flush();
     return 0;
 }